@@ -3,6 +3,8 @@
 
 #include "Player.h"
 #include "ShootStrategy.h"
+#include "Random.h"
+#include "PlacementDistribution.h"
 
 #include <utility>
 #include <memory>
@@ -14,15 +16,22 @@ namespace battleship
     {
     public:
         AIPlayer(std::unique_ptr<ShootStrategy> strategy_ptr);
+        // rng is used for placing ships, the strategy has its own generator
+        AIPlayer(std::unique_ptr<ShootStrategy> strategy_ptr, Random rng);
+        // ships are placed in layouts sampled from the trained distribution instead of uniformly
+        AIPlayer(std::unique_ptr<ShootStrategy> strategy_ptr, Random rng,
+                 std::shared_ptr<const PlacementDistribution> placement);
         ~AIPlayer() override = default;
 
         void setUpShips() override;
         std::pair<int, int> shoot() override;
 
+        const ShootStrategy& getStrategy() const;
+
     private:
         std::unique_ptr<ShootStrategy> strategy_ptr_;
-
-        static const int MAX_ATTEMPTS = 50;
+        Random rng_;
+        std::shared_ptr<const PlacementDistribution> placement_;
     };
 
 }
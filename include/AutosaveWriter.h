@@ -0,0 +1,83 @@
+#ifndef AUTOSAVE_WRITER_H_
+#define AUTOSAVE_WRITER_H_
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <cstddef>
+
+namespace battleship
+{
+
+    // Writer of saved games on its own thread, so the game never waits for the disk. A single writer is shared
+    // by all games of the process. Saves waiting for the same file are coalesced and only the latest one is
+    // written. The queue is bounded, when it is full the caller waits until a save is taken out of it, so
+    // a save of another game is never lost.
+    // Every save goes to a temporary file next to the target, which is synced and renamed over the target,
+    // so a crash leaves either the previous save or the new one and never a truncated file.
+    class AutosaveWriter
+    {
+    public:
+        struct Stats
+        {
+            long submitted = 0;
+            long written = 0;
+            // replaced by a later save of the same file before they were written
+            long coalesced = 0;
+            // waited for space in the full queue
+            long waited = 0;
+            long failed = 0;
+        };
+
+        explicit AutosaveWriter(std::size_t capacity = 64);
+        // waiting saves are written before the thread ends
+        ~AutosaveWriter();
+
+        AutosaveWriter(const AutosaveWriter&) = delete;
+        AutosaveWriter& operator=(const AutosaveWriter&) = delete;
+
+        // writer of the whole process, it is created with the first call
+        static std::shared_ptr<AutosaveWriter> shared();
+
+        // content is written to the file later, it blocks only while the queue is full
+        void submit(const std::string& path, std::string content);
+        // wait until every submitted save is written or failed
+        void flush();
+        // the same for saves of a single file
+        void flush(const std::string& path);
+        Stats getStats() const;
+
+        // the same crash-safe write on the calling thread
+        // throws BattleshipRuntimeError when the file cannot be written
+        static void writeFile(const std::string& path, const std::string& content);
+
+    private:
+        struct Save
+        {
+            std::string path;
+            std::string content;
+        };
+
+        const std::size_t capacity_;
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable idle_;
+        std::condition_variable space_;
+        std::deque<Save> queue_;
+        bool writing_ = false;
+        // file of the save which is being written
+        std::string writing_path_;
+        bool stop_ = false;
+        Stats stats_;
+        // started after everything above is initialized
+        std::thread thread_;
+
+        void writerLoop();
+    };
+
+}
+
+#endif // !AUTOSAVE_WRITER_H_
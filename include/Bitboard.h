@@ -0,0 +1,316 @@
+#ifndef BITBOARD_H_
+#define BITBOARD_H_
+
+#include <utility>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace battleship
+{
+
+    namespace detail
+    {
+        // word (0 - low, 1 - high) of the mask with all squares of the specified column
+        constexpr std::uint64_t columnMaskWord(int column, int word)
+        {
+            std::uint64_t r = 0;
+            for (int i = column; i < 100; i += 10)
+                if (i / 64 == word)
+                    r |= std::uint64_t(1) << (i % 64);
+            return r;
+        }
+    }
+
+    // Set of grid squares kept as 100 bits packed into two 64-bit words.
+    // Square (first, second) is stored at bit first * 10 + second, so moving by one row
+    // is a shift by 10 and moving by one column is a shift by 1 masked with the border column.
+    // Hot operations are defined inline below the class.
+    class Bitboard
+    {
+    public:
+        static const int SIZE = 10;
+        static const int SQUARES = SIZE * SIZE;
+
+        Bitboard() = default;
+        Bitboard(std::uint64_t low, std::uint64_t high);
+
+        static int toIndex(std::pair<int, int> square);
+        static std::pair<int, int> toSquare(int index);
+
+        // bitboard with the single square set
+        static Bitboard fromIndex(int index);
+        static Bitboard fromSquare(std::pair<int, int> square);
+
+        // all 100 squares of the grid
+        static Bitboard full();
+
+        // all squares with first in [first_min, first_max] and second in [second_min, second_max]
+        // bounds are clamped to the grid, so the rectangle may stick out of it
+        static Bitboard rectangle(int first_min, int second_min, int first_max, int second_max);
+
+        std::uint64_t low() const;
+        std::uint64_t high() const;
+
+        bool test(int index) const;
+        bool test(std::pair<int, int> square) const;
+        void set(int index);
+        void set(std::pair<int, int> square);
+        void reset(int index);
+        void reset(std::pair<int, int> square);
+
+        bool empty() const;
+        int count() const;
+
+        // index of the lowest set square, bitboard must not be empty
+        int lowest() const;
+        // remove the lowest set square and return its index, bitboard must not be empty
+        int popLowest();
+        // index of the n-th set square counting from the lowest one, n must be lower than count()
+        int nth(int n) const;
+
+        // squares moved by one towards lower/higher first or second coordinate
+        // squares moved out of the grid are dropped
+        Bitboard shiftFirstDown() const;
+        Bitboard shiftFirstUp() const;
+        Bitboard shiftSecondDown() const;
+        Bitboard shiftSecondUp() const;
+
+        // squares together with all their horizontal, vertical and diagonal neighbours
+        Bitboard dilate() const;
+
+        Bitboard operator~() const;
+        Bitboard& operator&=(const Bitboard& other);
+        Bitboard& operator|=(const Bitboard& other);
+        Bitboard& operator^=(const Bitboard& other);
+
+        friend Bitboard operator&(Bitboard l, const Bitboard& r) { return l &= r; }
+        friend Bitboard operator|(Bitboard l, const Bitboard& r) { return l |= r; }
+        friend Bitboard operator^(Bitboard l, const Bitboard& r) { return l ^= r; }
+        friend bool operator==(const Bitboard& l, const Bitboard& r) { return l.low_ == r.low_ && l.high_ == r.high_; }
+        friend bool operator!=(const Bitboard& l, const Bitboard& r) { return !(l == r); }
+
+        static int popcount(std::uint64_t x);
+        static int countTrailingZeros(std::uint64_t x);
+        // position of the n-th set bit of x, constant number of steps
+        static int selectBit(std::uint64_t x, int n);
+
+    private:
+        // bits 100..127 are never set
+        static constexpr std::uint64_t HIGH_MASK = (std::uint64_t(1) << (SQUARES - 64)) - 1;
+        static constexpr std::uint64_t FIRST_COLUMN_LOW = detail::columnMaskWord(0, 0);
+        static constexpr std::uint64_t FIRST_COLUMN_HIGH = detail::columnMaskWord(0, 1);
+        static constexpr std::uint64_t LAST_COLUMN_LOW = detail::columnMaskWord(SIZE - 1, 0);
+        static constexpr std::uint64_t LAST_COLUMN_HIGH = detail::columnMaskWord(SIZE - 1, 1);
+
+        std::uint64_t low_ = 0;
+        std::uint64_t high_ = 0;
+    };
+
+    inline Bitboard::Bitboard(std::uint64_t low, std::uint64_t high)
+        : low_(low)
+        , high_(high & HIGH_MASK)
+    { }
+
+    inline int Bitboard::toIndex(std::pair<int, int> square)
+    {
+        return square.first * SIZE + square.second;
+    }
+
+    inline std::pair<int, int> Bitboard::toSquare(int index)
+    {
+        return { index / SIZE, index % SIZE };
+    }
+
+    inline Bitboard Bitboard::fromIndex(int index)
+    {
+        Bitboard b;
+        b.set(index);
+        return b;
+    }
+
+    inline Bitboard Bitboard::fromSquare(std::pair<int, int> square)
+    {
+        return fromIndex(toIndex(square));
+    }
+
+    inline Bitboard Bitboard::full()
+    {
+        return Bitboard(~std::uint64_t(0), HIGH_MASK);
+    }
+
+    inline std::uint64_t Bitboard::low() const
+    {
+        return low_;
+    }
+
+    inline std::uint64_t Bitboard::high() const
+    {
+        return high_;
+    }
+
+    inline bool Bitboard::test(int index) const
+    {
+        return index < 64 ? (low_ >> index) & 1 : (high_ >> (index - 64)) & 1;
+    }
+
+    inline bool Bitboard::test(std::pair<int, int> square) const
+    {
+        return test(toIndex(square));
+    }
+
+    inline void Bitboard::set(int index)
+    {
+        if (index < 64) low_ |= std::uint64_t(1) << index;
+        else high_ |= std::uint64_t(1) << (index - 64);
+    }
+
+    inline void Bitboard::set(std::pair<int, int> square)
+    {
+        set(toIndex(square));
+    }
+
+    inline void Bitboard::reset(int index)
+    {
+        if (index < 64) low_ &= ~(std::uint64_t(1) << index);
+        else high_ &= ~(std::uint64_t(1) << (index - 64));
+    }
+
+    inline void Bitboard::reset(std::pair<int, int> square)
+    {
+        reset(toIndex(square));
+    }
+
+    inline bool Bitboard::empty() const
+    {
+        return (low_ | high_) == 0;
+    }
+
+    inline int Bitboard::popcount(std::uint64_t x)
+    {
+#if defined(_MSC_VER)
+        return (int)__popcnt64(x);
+#elif defined(__POPCNT__)
+        return __builtin_popcountll(x);
+#else
+        // without the popcnt instruction the builtin is a library call, sum bits in parallel instead
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return (int)((x * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    inline int Bitboard::countTrailingZeros(std::uint64_t x)
+    {
+#ifdef _MSC_VER
+        unsigned long r;
+        _BitScanForward64(&r, x);
+        return (int)r;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    inline int Bitboard::count() const
+    {
+        return popcount(low_) + popcount(high_);
+    }
+
+    inline int Bitboard::lowest() const
+    {
+        return low_ ? countTrailingZeros(low_) : 64 + countTrailingZeros(high_);
+    }
+
+    inline int Bitboard::popLowest()
+    {
+        const int i = lowest();
+        if (low_) low_ &= low_ - 1;
+        else high_ &= high_ - 1;
+        return i;
+    }
+
+    inline int Bitboard::selectBit(std::uint64_t x, int n)
+    {
+        // find the byte containing the bit, then the bit inside the byte
+        int shift = 0;
+        for (int c = popcount(x & 0xff); n >= c; c = popcount((x >> shift) & 0xff))
+        {
+            n -= c;
+            shift += 8;
+        }
+        std::uint64_t byte = (x >> shift) & 0xff;
+        while (n--)
+            byte &= byte - 1;
+        return shift + countTrailingZeros(byte);
+    }
+
+    inline int Bitboard::nth(int n) const
+    {
+        const int c = popcount(low_);
+        return n < c ? selectBit(low_, n) : 64 + selectBit(high_, n - c);
+    }
+
+    inline Bitboard Bitboard::shiftFirstDown() const
+    {
+        return Bitboard((low_ >> SIZE) | (high_ << (64 - SIZE)), high_ >> SIZE);
+    }
+
+    inline Bitboard Bitboard::shiftFirstUp() const
+    {
+        return Bitboard(low_ << SIZE, (high_ << SIZE) | (low_ >> (64 - SIZE)));
+    }
+
+    inline Bitboard Bitboard::shiftSecondDown() const
+    {
+        // squares from the first column would land in the last column of the previous row
+        const std::uint64_t l = low_ & ~FIRST_COLUMN_LOW;
+        const std::uint64_t h = high_ & ~FIRST_COLUMN_HIGH;
+        return Bitboard((l >> 1) | (h << 63), h >> 1);
+    }
+
+    inline Bitboard Bitboard::shiftSecondUp() const
+    {
+        // squares from the last column would land in the first column of the next row
+        const std::uint64_t l = low_ & ~LAST_COLUMN_LOW;
+        const std::uint64_t h = high_ & ~LAST_COLUMN_HIGH;
+        return Bitboard(l << 1, (h << 1) | (l >> 63));
+    }
+
+    inline Bitboard Bitboard::dilate() const
+    {
+        const Bitboard row = *this | shiftSecondDown() | shiftSecondUp();
+        return row | row.shiftFirstDown() | row.shiftFirstUp();
+    }
+
+    inline Bitboard Bitboard::operator~() const
+    {
+        return Bitboard(~low_, ~high_);
+    }
+
+    inline Bitboard& Bitboard::operator&=(const Bitboard& other)
+    {
+        low_ &= other.low_;
+        high_ &= other.high_;
+        return *this;
+    }
+
+    inline Bitboard& Bitboard::operator|=(const Bitboard& other)
+    {
+        low_ |= other.low_;
+        high_ |= other.high_;
+        return *this;
+    }
+
+    inline Bitboard& Bitboard::operator^=(const Bitboard& other)
+    {
+        low_ ^= other.low_;
+        high_ ^= other.high_;
+        return *this;
+    }
+
+}
+
+#endif // !BITBOARD_H_
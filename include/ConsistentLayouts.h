@@ -0,0 +1,131 @@
+#ifndef CONSISTENT_LAYOUTS_H_
+#define CONSISTENT_LAYOUTS_H_
+
+#include "FleetLayouts.h"
+#include "Grid.h"
+#include "Bitboard.h"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Set of placements of double ship as bits of three words, index is the same as in FleetLayouts.
+    // Operations on sets work on all placements at once.
+    struct DoublesSet
+    {
+        static const int WORDS = 3;
+        std::uint64_t words[WORDS] = { 0, 0, 0 };
+
+        void set(int i)
+        {
+            words[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+
+        DoublesSet& operator&=(const DoublesSet& other)
+        {
+            for (int k = 0; k < WORDS; k++)
+                words[k] &= other.words[k];
+            return *this;
+        }
+
+        friend DoublesSet operator&(DoublesSet l, const DoublesSet& r) { return l &= r; }
+
+        int count() const
+        {
+            int c = 0;
+            for (int k = 0; k < WORDS; k++)
+                c += Bitboard::popcount(words[k]);
+            return c;
+        }
+
+        // calls f with index of every placement in the set
+        template<typename F>
+        void forEach(F f) const
+        {
+            for (int k = 0; k < WORDS; k++)
+                for (auto w = words[k]; w; w &= w - 1)
+                    f(k * 64 + Bitboard::countTrailingZeros(w));
+        }
+    };
+
+    // Fleet layouts of opponent's ships which agree with hits, misses and sunk ships of the grid.
+    // Layouts are not listed one by one, they are grouped by the triple ship: every fitting triple
+    // comes with the set of doubles which can be placed with it and squares left for the single ship.
+    class ConsistentLayouts
+    {
+    public:
+        explicit ConsistentLayouts(const Grid& shots);
+
+        // false when sunk ships of the grid cannot belong to any fleet, there are no layouts then
+        bool isPossible() const;
+        bool isSunk(int length) const;
+
+        // calls f(triple, doubles, singles) for every fitting triple with at least one valid double,
+        // triple is its index in FleetLayouts. Single ship can be on squares of singles which are
+        // not in the neighbourhood of the chosen double.
+        template<typename F>
+        void forEachTriple(F f) const;
+
+        // doubles which cannot be placed next to single ship on the square
+        static const DoublesSet& touching(int square);
+
+    private:
+        // sets of double ship placements which do not depend on the grid
+        struct Tables
+        {
+            // doubles which can be placed together with the triple, index is triple's placement
+            std::vector<DoublesSet> legal_with_triple;
+            // doubles occupying the square and doubles which cannot be placed next to single ship on the square
+            std::array<DoublesSet, Bitboard::SQUARES> covering;
+            std::array<DoublesSet, Bitboard::SQUARES> touching;
+
+            Tables();
+            static const Tables& instance();
+        };
+
+        Bitboard hit_;
+        Bitboard miss_;
+        Bitboard sunk_;
+        std::array<Bitboard, Ship::MAX_LENGTH> sunk_ships_ {};
+        std::array<bool, Ship::MAX_LENGTH> is_sunk_ {};
+        bool possible_ = true;
+        DoublesSet fitting_doubles_;
+        // squares where single ship can be regardless of other ships
+        Bitboard singles_;
+
+        // ship not sunk yet cannot be on missed or sunk squares, cannot touch squares of other ships
+        // and cannot be hit on all squares
+        bool fits(const FleetLayouts::Placement& p) const;
+    };
+
+    template<typename F>
+    void ConsistentLayouts::forEachTriple(F f) const
+    {
+        if (!possible_)
+            return;
+
+        const auto& tables = Tables::instance();
+        const auto& triples = FleetLayouts::instance().getPlacements(3);
+        for (int i = 0; i < (int)triples.size(); i++)
+        {
+            const auto& t = triples[i];
+            if (!fits(t))
+                continue;
+
+            // hits not covered by the triple have to belong to the double, single ship would be sunk
+            auto valid = tables.legal_with_triple[i] & fitting_doubles_;
+            for (auto b = hit_ & ~t.mask; !b.empty(); )
+                valid &= tables.covering[b.popLowest()];
+
+            if (valid.count() == 0)
+                continue;
+            f(i, valid, singles_ & ~t.neighbourhood);
+        }
+    }
+
+}
+
+#endif // !CONSISTENT_LAYOUTS_H_
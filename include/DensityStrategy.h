@@ -0,0 +1,69 @@
+#ifndef DENSITY_STRATEGY_H_
+#define DENSITY_STRATEGY_H_
+
+#include "ShootStrategy.h"
+#include "Grid.h"
+#include "Bitboard.h"
+#include "Random.h"
+
+#include <utility>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+#include <array>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Shoots at the square which holds a ship in the largest number of fleet layouts consistent with
+    // the player's hits, misses and sunk ships. Every legal layout is assumed to be equally likely,
+    // which is how AIPlayer places its ships. Without the player's state it shoots like RandomStrategy.
+    class DensityStrategy final : public ShootStrategy
+    {
+    public:
+        struct Density
+        {
+            // number of consistent layouts with a ship on the square, it is zero for targeted squares
+            std::array<std::uint32_t, Bitboard::SQUARES> counts;
+            // number of all consistent layouts
+            std::uint64_t layouts;
+        };
+
+        DensityStrategy() = default;
+        explicit DensityStrategy(Random rng);
+        ~DensityStrategy() override = default;
+
+        // count layouts consistent with the grid of opponent's ships
+        static Density countLayouts(const Grid& shots);
+
+        int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) override;
+        std::pair<int,int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>, SquareHash>> squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths, const Player& player) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares, const Player& player) override;
+
+    private:
+        Random rng_;
+
+        // density is counted once for every state of the grid, choosing ship and square share it
+        Density density_;
+        Bitboard counted_hit_;
+        Bitboard counted_miss_;
+        Bitboard counted_sunk_;
+        bool counted_ = false;
+
+        // countLayouts without the cached density of the empty grid
+        static Density countUncached(const Grid& shots);
+
+        const Density& getDensity(const Grid& shots);
+
+        // square from squares with the highest count, ties are broken randomly
+        // count of the square is returned in best_count
+        std::pair<int,int> bestSquare(const SquareSet& squares, std::uint32_t& best_count);
+    };
+
+}
+
+#endif // !DENSITY_STRATEGY_H_
@@ -0,0 +1,50 @@
+#ifndef ENDGAME_SOLVER_H_
+#define ENDGAME_SOLVER_H_
+
+#include "GameState.h"
+#include "TranspositionTable.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Exact value of a game state with both fleets known. The side the solver plays for chooses
+    // the best shot, the other side shoots like in MonteCarloStrategy::rollout: at a random ship and
+    // then at a random square in its range, so its shots are averaged. Values are the same as the ones
+    // of rollouts: 1 for win, 0.5 for draw, 0 for loss and 0.01 for every hit more than the other side.
+    // Solved states are kept in the table, which can be shared by solvers running on different threads.
+    // The search grows exponentially, so it stops at the deadline and the value of that solve is not valid.
+    class EndgameSolver
+    {
+    public:
+        EndgameSolver(TranspositionTable& table, int side);
+
+        // untargeted squares in ranges of all ships which are not sunk yet, the size of the search
+        // grows quickly with it
+        static int remainingSquares(const GameState& state);
+
+        // value is not valid when the solve was aborted
+        double solve(const GameState& state);
+        // following solves stop when the time is over, there is no deadline by default
+        void setDeadline(std::chrono::steady_clock::time_point deadline);
+        // the last solve reached the deadline
+        bool isAborted() const;
+
+        // states visited by all solve calls, including the ones found in the table
+        long getNodes() const;
+
+    private:
+        TranspositionTable& table_;
+        int side_;
+        long nodes_ = 0;
+        std::chrono::steady_clock::time_point deadline_ = std::chrono::steady_clock::time_point::max();
+        bool aborted_ = false;
+
+        double search(GameState s, std::uint64_t hash);
+    };
+
+}
+
+#endif // !ENDGAME_SOLVER_H_
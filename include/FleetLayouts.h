@@ -0,0 +1,87 @@
+#ifndef FLEET_LAYOUTS_H_
+#define FLEET_LAYOUTS_H_
+
+#include "Ship.h"
+#include "ShipsGrid.h"
+#include "Bitboard.h"
+#include "Random.h"
+#include "exceptions.h"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace battleship
+{
+
+    // Table of all legal fleet layouts: one ship of every length, ships do not overlap or touch.
+    // It is generated once at the first use and shared by all players.
+    class FleetLayouts
+    {
+    public:
+        struct Placement
+        {
+            ShipSquares squares;
+            int length;
+            Bitboard mask;
+            // ship's squares with all their neighbours, other ships cannot be placed there
+            Bitboard neighbourhood;
+            // squares the ship can fire at, the same as Ship::getRangeMask
+            Bitboard range;
+        };
+
+        // indices of placements in getPlacements(length), index of the array is the ship's length - 1
+        using Layout = std::array<int, Ship::MAX_LENGTH>;
+
+        static const FleetLayouts& instance();
+
+        // all straight placements of a ship with given length inside the grid
+        const std::vector<Placement>& getPlacements(int length) const;
+
+        std::size_t size() const;
+        Layout at(std::size_t index) const;
+
+        // index of the layout in the table or -1 if it is not a legal layout
+        long indexOf(const Layout& layout) const;
+
+        // index of the placement with given squares in getPlacements(length) or -1 if there is none
+        int placementIndex(int length, Bitboard mask) const;
+
+        // uniformly chosen legal layout, it takes a single draw from rng
+        Layout sample(Random& rng) const;
+
+        // squares occupied by all ships of the layout
+        Bitboard getMask(const Layout& layout) const;
+
+        // layout packed as single + double * 2^8 + triple * 2^16, codes are ordered like the table
+        static std::uint32_t pack(const Layout& layout);
+        static Layout unpack(std::uint32_t code);
+
+    private:
+        FleetLayouts();
+
+        std::array<std::vector<Placement>, Ship::MAX_LENGTH> placements_;
+
+        // packed layouts, so the table is sorted
+        std::vector<std::uint32_t> layouts_;
+    };
+
+    // both are called for every shot of simulated games
+
+    inline const FleetLayouts& FleetLayouts::instance()
+    {
+        static const FleetLayouts layouts;
+        return layouts;
+    }
+
+    inline const std::vector<FleetLayouts::Placement>& FleetLayouts::getPlacements(int length) const
+    {
+        if (length <= 0 || length > Ship::MAX_LENGTH)
+            throw BattleshipRuntimeError("FleetLayouts::getPlacements: wrong length of the ship.");
+        return placements_[length - 1];
+    }
+
+}
+
+#endif // !FLEET_LAYOUTS_H_
@@ -0,0 +1,153 @@
+#ifndef GAME_JOURNAL_H_
+#define GAME_JOURNAL_H_
+
+#include "GameState.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+namespace battleship
+{
+
+    // Append-only binary log of a game: the state it starts from, then every shot with the ship which fired it
+    // and its result, and the end of every round. Records have fixed size, so a saved round costs a few bytes
+    // per shot and a finished game can be replayed shot by shot.
+    // The file is a header followed by records. The state the journal starts from is written as placements,
+    // targets and pausing ships before the first shot, a new game has only placements there.
+    // Numbers are stored in byte order of the machine which wrote the journal.
+    struct GameJournal
+    {
+        // "BSJL" when read as bytes on little endian machine
+        static const std::uint32_t MAGIC = 0x4C4A5342;
+        // increase after every change of the layout
+        static const std::uint32_t VERSION = 1;
+        static const int TYPE_LENGTH = 16;
+
+        enum RecordType : std::uint8_t
+        {
+            // ship of the player, index is its placement in FleetLayouts::getPlacements(ship)
+            JR_PLACEMENT = 1,
+            // square the player shot at before the journal started, its order is not known
+            JR_TARGET,
+            // ship of the player which cannot shoot in the first round of the journal
+            JR_PAUSE,
+            // the player's ship shot at the square with index
+            JR_SHOT,
+            // end of the round, round is the number of finished rounds
+            JR_ROUND
+        };
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::int32_t max_rounds;
+            // finished rounds of the state the journal starts from
+            std::int32_t first_round;
+            std::uint64_t seed;
+            // seconds since epoch
+            std::int64_t created_at;
+            // type names of the main player and the opponent, zero terminated
+            char types[2][TYPE_LENGTH];
+        };
+
+        struct Record
+        {
+            std::uint8_t type;
+            // 0 is the main player and 1 the opponent
+            std::uint8_t player;
+            // length of the ship
+            std::uint8_t ship;
+            // square of shots and targets, placement index of placements
+            std::uint8_t index;
+            // ShotResult of shots and targets
+            std::uint8_t result;
+            std::uint8_t reserved;
+            // round the shot was fired in counting from 1, finished rounds for JR_ROUND
+            std::uint16_t round;
+        };
+
+        // header with magic and version filled and everything else zeroed
+        // throws BattleshipLogicError when a type name is too long
+        static Header makeHeader(int max_rounds, std::uint64_t seed, const std::string& main_type,
+                                 const std::string& opponent_type);
+
+        // true when file starts with journal's magic number, it does not check the rest of the file
+        static bool isJournalFile(const std::string& path);
+
+        // records which describe the state, it has to be between rounds
+        static std::vector<Record> stateRecords(const GameState& state);
+    };
+
+    static_assert(std::is_trivially_copyable<GameJournal::Header>::value, "header is copied as raw bytes");
+    static_assert(std::is_trivially_copyable<GameJournal::Record>::value, "records are copied as raw bytes");
+    static_assert(sizeof(GameJournal::Record) == 8, "records are packed");
+
+    // Writer appending records to the journal file. Records are buffered and the file is flushed at the end
+    // of every round, a crash loses at most the round in progress.
+    // BattleshipRuntimeError is thrown when the file cannot be written.
+    class GameJournalWriter
+    {
+    public:
+        // new journal starting from the state, it has to be between rounds
+        GameJournalWriter(const std::string& path, const GameJournal::Header& header, const GameState& state);
+        // continue existing journal after its last finished round, records of the unfinished round are removed
+        explicit GameJournalWriter(const std::string& path);
+
+        void shot(int player, Shot shot, ShotResult result, int round);
+        void endRound(int finished_rounds);
+
+    private:
+        std::string path_;
+        std::ofstream file_;
+
+        void write(const GameJournal::Record& record);
+    };
+
+    // Journal file mapped read-only into memory. Header is checked and the index of rounds is built when
+    // the file is opened, BattleshipRuntimeError is thrown for files which are not journals of the current
+    // version. A record cut off by a crash at the end of the file is ignored.
+    class MappedGameJournal
+    {
+    public:
+        explicit MappedGameJournal(const std::string& path);
+
+        const GameJournal::Header& header() const;
+        std::string getType(int player) const;
+
+        std::size_t size() const;
+        const GameJournal::Record& at(std::size_t record) const;
+
+        // rounds the journal can be rewound to, the last one is the last finished round
+        int firstRound() const;
+        int lastRound() const;
+        // number of records up to the end of the round
+        std::size_t roundEnd(int round) const;
+        // size of the file up to the end of the last finished round
+        std::size_t finishedSize() const;
+
+        // state at the end of the round, only records up to its end are read
+        // throws BattleshipRuntimeError when the round is out of range or the records break the rules
+        GameState stateAt(int round) const;
+        // state after the first count records, in the middle of the round when the game ended before its end
+        GameState replay(std::size_t count) const;
+
+    private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+        std::size_t size_ = 0;
+        // roundEnd of rounds from firstRound, the first one ends records of the starting state
+        std::vector<std::size_t> rounds_;
+
+        const GameJournal::Record* records() const;
+    };
+
+}
+
+#endif // !GAME_JOURNAL_H_
@@ -2,40 +2,108 @@
 #define GAME_LOGIC_
 
 #include "Player.h"
+#include "OpeningBook.h"
+#include "PlacementDistribution.h"
+#include "GameJournal.h"
+#include "AutosaveWriter.h"
 #include "UI.h"
 
 #include <boost/program_options.hpp>
 #include <string>
 #include <memory>
+#include <cstdint>
+#include <array>
+#include <utility>
 
 namespace battleship
 {
 
+    // what the next GameLogic::step does
+    enum GameStatus
+    {
+        // the game goes on without the user
+        GS_RUNNING,
+        // the next step asks the human player through UI, a driver which cannot wait for the answer
+        // calls it once the UI has the input ready
+        GS_AWAITING_INPUT,
+        GS_OVER
+    };
+
+    struct GameStep
+    {
+        // status after the step
+        GameStatus status;
+        // the next step should come after this delay, moves of ai players are shown with it
+        int delay_ms;
+    };
+
     class GameLogic
     {
     public:
-        GameLogic(int argc, char** argv, std::shared_ptr<UI> ui_ptr);
+        // autosaves are written by the given writer, which can be shared by many games,
+        // the writer of the whole process is used when it is null
+        GameLogic(int argc, char** argv, std::shared_ptr<UI> ui_ptr, std::shared_ptr<AutosaveWriter> autosave = nullptr);
         ~GameLogic();
 
+        // steps the game until it is over and waits the delays of ai moves
         void run();
+        // advance the game by a single shot or phase, the game can be driven by any scheduler
+        GameStep step();
+        GameStatus getStatus() const;
+        void simulate();
+        // format of the file is recognized by its content
         void loadGameFromFile();
+        // autosave in chosen format, the game goes on when the file cannot be written
+        // text and binary saves are written on a background thread, the journal is appended to
         void saveGameToFile() const;
 
     private:
         const int AI_REACTION_TIME = 2000;
 
+        // where the game continues with the next step
+        enum GamePhase
+        {
+            GP_SETUP,
+            // start of the round and the turn of the main player
+            GP_ROUND,
+            GP_MAIN_SHOT,
+            // another shot of the main player in the same round
+            GP_MAIN_EXTRA_SHOT,
+            GP_OPPONENT_TURN,
+            // shots of the opponent, the round ends when it cannot shoot anymore
+            GP_OPPONENT_SHOT,
+            GP_OVER
+        };
+
         std::shared_ptr<UI> ui_;
         int max_rounds_;
+        // time budget of a single decision of strategies which search
+        int think_ms_;
+        // size of the game which is solved exactly instead of sampled
+        int endgame_squares_;
+        // first turns of ai players, it is mapped once and shared by all of them
+        std::shared_ptr<const MappedOpeningBook> opening_book_;
+        // trained placement of ai players' ships, uniform when it is not set
+        std::shared_ptr<const PlacementDistribution> placement_;
         int round_counter_ = 0;
+        GamePhase phase_ = GP_SETUP;
         bool is_human_ = false;
+        // ai players of a game with this seed always make the same decisions
+        std::uint64_t seed_ = 0;
 
         std::string input_name_;
         std::string output_name_;
+        std::string save_format_;
 
         // the main player human player or ai player
         Player* main_player_ = nullptr;
         Player* opponent_player_ = nullptr;
 
+        // autosave of journal format, records are appended to it during the game
+        std::unique_ptr<GameJournalWriter> journal_;
+        // writer of other formats, the shared one is taken by the first autosave
+        mutable std::shared_ptr<AutosaveWriter> autosave_;
+
         // description of all posible options that can be used
         boost::program_options::options_description& description_;
 
@@ -55,6 +123,33 @@ namespace battleship
         void validateUsedOptions();
         void validateGameState();
         void initializePlayers();
+        // player places ships with rng stream number stream and the strategy uses stream + 1
+        Player* createAIPlayer(const std::string& type, std::uint64_t seed, unsigned stream) const;
+
+        void loadTextGameFromFile();
+        // state of the text save filled directly from its options and checked in a single pass,
+        // throws ArgumentsError when it is not a legal game
+        GameState textGameState() const;
+        void loadBinaryGameFromFile();
+        void loadJournalGameFromFile();
+        // save in chosen format on the calling thread, throws when the file cannot be written
+        void writeGameToFile() const;
+        // content of the text or binary save file
+        std::string serializeGame() const;
+        std::string textGame() const;
+        std::string binaryGame() const;
+        void writeJournalGameToFile() const;
+        GameJournal::Header journalHeader() const;
+        // journal of the game loaded from the same file is continued, otherwise it starts from the current state
+        void openJournal();
+        // shots are the player's ship shots before the shot, the ship which fired is the one whose count changed
+        void recordShot(int player, const Player& shooter, const std::array<int, Ship::MAX_LENGTH>& shots,
+                        std::pair<int, int> square, ShotResult result);
+
+        // shot of the main player (0) or the opponent (1) at the other player
+        void playShot(int player);
+        // the winner after all rounds, the default save file is deleted
+        void finishGame();
 
         void updateUI();
     };
@@ -66,11 +161,26 @@ namespace battleship
     #define OPPONENT "opponent"
     #define SAVE "save"
     #define LOAD "load"
+    #define SIMULATE "simulate"
+    #define SEED "seed"
+    #define SAVE_FORMAT "save-format"
+    #define CONVERT "convert"
+    #define THINK_MS "think-ms"
+    #define ENDGAME_SQUARES "endgame-squares"
+    #define OPENING_BOOK "opening-book"
+    #define PLACEMENT "placement"
+    #define EXPORT "export"
+    #define EXPORT_CSV "export-csv"
 
     #define DEFAULT_FILE ".battleship.autosave"
     #define HUMAN "human"
     #define RANDOM "random"
     #define GREEDY "greedy"
+    #define DENSITY "density"
+    #define MONTE_CARLO "montecarlo"
+    #define TEXT_FORMAT "text"
+    #define BINARY_FORMAT "binary"
+    #define JOURNAL_FORMAT "journal"
 
     // define long and short names of options
     #define ROUND_NUMBER "number-round"
@@ -0,0 +1,88 @@
+#ifndef GAME_SNAPSHOT_H_
+#define GAME_SNAPSHOT_H_
+
+#include "Player.h"
+#include "Bitboard.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace battleship
+{
+
+    // Fixed size binary image of the game between rounds.
+    // It is written to file as it is and read by mapping the file, so it contains only plain values.
+    // Numbers are stored in byte order of the machine which saved the game.
+    struct GameSnapshot
+    {
+        // "BSSV" when read as bytes on little endian machine
+        static const std::uint32_t MAGIC = 0x56535342;
+        // increase after every change of the layout
+        static const std::uint32_t VERSION = 1;
+        static const int TYPE_LENGTH = 16;
+
+        struct PlayerState
+        {
+            // words of ships bitboards, index is the ship's length - 1
+            std::uint64_t fleet[Ship::MAX_LENGTH][2];
+            // words of planes of the player's secondary grid
+            std::uint64_t hit[2];
+            std::uint64_t miss[2];
+            std::uint64_t sunk[2];
+            // bit length - 1 is set when the ship is pausing
+            std::uint32_t pausing;
+            // player type name, zero terminated
+            char type[TYPE_LENGTH];
+        };
+
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::int32_t round_number;
+        std::int32_t max_rounds;
+        std::uint64_t seed;
+        // seconds since epoch
+        std::int64_t saved_at;
+        // main player and opponent
+        PlayerState players[2];
+
+        // snapshot with header filled and everything else zeroed
+        static GameSnapshot make();
+
+        // true when file starts with snapshot's magic number, it does not check the rest of the file
+        static bool isSnapshotFile(const std::string& path);
+
+        // remember state of player with index 0 (main) or 1 (opponent)
+        void setPlayer(int index, const Player& player, const std::string& type);
+        std::string getType(int index) const;
+
+        // set state of the player with given index, ships of the player must not be placed yet
+        // squares the opponent shot at are read from opponent's secondary grid
+        void restorePlayer(int index, Player& player) const;
+
+        // throws BattleshipRuntimeError when the file cannot be written
+        void write(const std::string& path) const;
+    };
+
+    static_assert(std::is_trivially_copyable<GameSnapshot>::value, "snapshot is copied as raw bytes");
+    static_assert(std::is_standard_layout<GameSnapshot>::value, "snapshot is copied as raw bytes");
+
+    // Snapshot file mapped read-only into memory. Header and size are checked when the file is opened,
+    // BattleshipRuntimeError is thrown for files which are not snapshots of the current version.
+    class MappedSnapshot
+    {
+    public:
+        explicit MappedSnapshot(const std::string& path);
+
+        const GameSnapshot& get() const;
+
+    private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+    };
+
+}
+
+#endif // !GAME_SNAPSHOT_H_
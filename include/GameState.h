@@ -0,0 +1,87 @@
+#ifndef GAME_STATE_H_
+#define GAME_STATE_H_
+
+#include "Ship.h"
+#include "Grid.h"
+#include "Bitboard.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace battleship
+{
+
+    class Player;
+
+    // shot of the ship with given length at the square with given index
+    struct Shot
+    {
+        int ship_length;
+        int square;
+    };
+
+    // Whole state of a game between two players in a few dozen bytes, so simulated games can copy it freely.
+    // Ships are kept as indices of placements in FleetLayouts and the rest of players' grids is derived
+    // from the squares each side shot at. Side 0 is the main player, it shoots first in every round.
+    // The rules are the same as in Simulation::playGame and the state converts to players and back without losses.
+    struct GameState
+    {
+        // state of the game between the players, the round is taken from the players
+        // throws BattleshipLogicError when ships are not placed and BattleshipRuntimeError when
+        // a player's shots do not match the other player's grid
+        static GameState fromPlayers(const Player& main, const Player& opponent, int max_rounds, int turn = 0);
+
+        struct Side
+        {
+            // index of the ship's placement in FleetLayouts::getPlacements(length), index of the array is length - 1
+            std::uint8_t fleet[Ship::MAX_LENGTH];
+            // shots fired by every ship in the current round
+            std::uint8_t shots[Ship::MAX_LENGTH];
+            // bit length - 1 is set for ships which cannot shoot in the current round
+            std::uint8_t pausing;
+            // low and high word of the bitboard of squares this side shot at
+            std::uint64_t targeted[2];
+        };
+
+        Side sides[2];
+        // rounds already finished
+        std::uint8_t round;
+        std::uint8_t max_rounds;
+        // side which shoots now
+        std::uint8_t turn;
+
+        Bitboard getTargeted(int side) const;
+        Bitboard getShip(int side, int length) const;
+        bool isSunk(int side, int length) const;
+        // hits taken by ships of the side
+        int getHits(int side) const;
+        // squares in ship's range the side did not shoot at yet
+        Bitboard getUntargeted(int side, int length) const;
+        // results of the side's shots, the same as its player's secondary grid
+        Grid getSecondaryGrid(int side) const;
+
+        // the same as Player::canShoot and Player::mayShootNextRounds
+        bool canShoot(int side, int length) const;
+        bool canShoot(int side) const;
+        bool mayShootNextRounds(int side) const;
+
+        // the side on turn takes the shot, other ships of the side pause until the end of the round
+        ShotResult apply(Shot shot);
+        // the opponent shoots after the main player
+        void endTurn();
+        // ships which fired two shots pause in the next round, the main player starts it
+        void nextRound();
+
+        // set up players from the state, their ships must not be placed yet
+        void toPlayers(Player& main, Player& opponent) const;
+    };
+
+    bool operator==(const GameState& l, const GameState& r);
+    bool operator!=(const GameState& l, const GameState& r);
+
+    static_assert(std::is_pod<GameState>::value, "game state is copied as plain bytes");
+    static_assert(sizeof(GameState) <= 128, "game state fits in two cache lines");
+
+}
+
+#endif // !GAME_STATE_H_
@@ -3,7 +3,11 @@
 
 #include "ShootStrategy.h"
 #include "ShipsGrid.h"
+#include "Random.h"
+#include "ShotBatch.h"
+#include "exceptions.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <unordered_set>
@@ -12,16 +16,58 @@
 namespace battleship
 {
 
-    class GreedyStrategy : public ShootStrategy
+    class GreedyStrategy final : public ShootStrategy
     {
     public:
         GreedyStrategy() = default;
+        explicit GreedyStrategy(Random rng);
         ~GreedyStrategy() override = default;
 
+        // decisions of many games at once, every game uses its own generator from the batch
+        static void chooseShots(ShotBatch& batch, BatchIsa isa = BI_AUTO);
+
         int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) override;
         std::pair<int,int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>, SquareHash>> squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths, const Player& player) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares, const Player& player) override;
+
+    private:
+        Random rng_;
     };
 
+    inline void GreedyStrategy::chooseShots(ShotBatch& batch, BatchIsa isa)
+    {
+        batch.chooseRandomShots(BSC_LONGEST, isa);
+    }
+
+    // called for every shot of simulated games, StaticAIPlayer inlines them
+
+    inline int GreedyStrategy::chooseShip(const ShipsLengths& ships_lengths)
+    {
+        if (ships_lengths.empty())
+            throw BattleshipRuntimeError("GreedyStrategy::chooseShip: no ship to choose.");
+        return *std::max_element(ships_lengths.begin(), ships_lengths.end());
+    }
+
+    inline std::pair<int,int> GreedyStrategy::chooseSquare(const SquareSet& squares)
+    {
+        if (squares.empty())
+            throw BattleshipRuntimeError("GreedyStrategy::chooseSquare: no square to choose.");
+        return squares.nth(rng_.below(squares.size()));
+    }
+
+    inline int GreedyStrategy::chooseShip(const ShipsLengths& ships_lengths, const Player&)
+    {
+        return chooseShip(ships_lengths);
+    }
+
+    inline std::pair<int,int> GreedyStrategy::chooseSquare(const SquareSet& squares, const Player&)
+    {
+        return chooseSquare(squares);
+    }
+
 }
 
 #endif // !GREEDY_STRATEGY_H_
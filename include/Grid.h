@@ -2,13 +2,14 @@
 #define GRID_H_
 
 #include "Ship.h"
+#include "Bitboard.h"
+#include "SquareSet.h"
 
 #include <utility>
 #include <vector>
 #include <memory>
 #include <array>
 #include <unordered_set>
-#include <set>
 
 namespace battleship
 {
@@ -41,25 +42,42 @@ namespace battleship
     public:
         static const int SIZE = 10;
 
-        Grid();
+        Grid() = default;
         virtual ~Grid() = default;
 
         // get all squares that ship passed as argument
         // ship's location is stored in it
-        // available range should be read from table_
+        // available range should be read from planes
         std::unique_ptr<std::unordered_set<std::pair<int, int>, SquareHash>> getAvailableRange(
                 const Ship& ship) const;
 
-        // get square value from table_
+        // the same squares as getAvailableRange, ship's range mask intersected with empty squares
+        Bitboard getAvailableMask(const Ship& ship) const;
+        SquareSet getAvailableSquares(const Ship& ship) const;
+
+        // all squares of given type, for ST_EMPTY these are squares that were not targeted yet
+        Bitboard getPlane(SquareType type) const;
+
+        // get square value from planes
         SquareType at(std::pair<int, int> square) const;
 
-        // change value in table_ at specified position to result
+        // change value in planes at specified position to result
         // each square can be updated once
         void update(std::pair<int, int> square, ShotResult result);
 
+        // replace state of the grid with given planes of opponent's ships, planes must not overlap
+        // lengths of sunk ships are read from sunk plane, so they have to be different
+        void restore(Bitboard hit, Bitboard miss, Bitboard sunk);
+
     protected:
-        std::array<std::array<SquareType, 10>, 10> table_;
-        std::set<int> sunk_ships_;
+        // Every square belongs to at most one plane, squares not in any plane are empty.
+        // Ships planes are used only by ShipsGrid, index is the ship's length - 1
+        std::array<Bitboard, Ship::MAX_LENGTH> ships_planes_;
+        Bitboard hit_plane_;
+        Bitboard miss_plane_;
+        Bitboard sunk_plane_;
+        // bit n is set when ship of length n was sunk
+        unsigned sunk_lengths_ = 0;
     };
 
 }
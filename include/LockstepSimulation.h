@@ -0,0 +1,57 @@
+#ifndef LOCKSTEP_SIMULATION_H_
+#define LOCKSTEP_SIMULATION_H_
+
+#include "Simulation.h"
+#include "GameState.h"
+#include "ShotBatch.h"
+#include "FleetLayouts.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Plays many independent games at once. Every step collects the games whose side on turn has to shoot,
+    // asks the batched strategy of that side for all their shots in one call and applies them to GameStates.
+    // Games are set up from seeds like in Tournament::playGame, so they end exactly like games of AIPlayers
+    // with the same strategies.
+    class LockstepSimulation
+    {
+    public:
+        LockstepSimulation(int max_rounds, BatchPolicy main, BatchPolicy opponent, BatchIsa isa = BI_AUTO);
+
+        // games with indices [begin, end) of the tournament with given base seed
+        std::vector<GameResult> playGames(std::uint64_t seed, long begin, long end) const;
+        // the main player's fleet of the game begin + i is main_fleets[i] instead of a sampled one,
+        // states of the games at their ends are stored in final_states
+        std::vector<GameResult> playGames(std::uint64_t seed, long begin, long end,
+                                          const std::vector<FleetLayouts::Layout>& main_fleets,
+                                          std::vector<GameState>& final_states) const;
+
+    private:
+        int max_rounds_;
+        BatchPolicy main_;
+        BatchPolicy opponent_;
+        BatchIsa isa_;
+
+        struct Game
+        {
+            GameState state;
+            // false at the beginning of every turn, before the checks of its start are made
+            bool started;
+            bool finished;
+            GameResult result;
+        };
+
+        std::vector<GameResult> play(std::uint64_t seed, long begin, long end,
+                                     const std::vector<FleetLayouts::Layout>* main_fleets,
+                                     std::vector<GameState>* final_states) const;
+
+        // pass turns and rounds until the side on turn has to shoot, true when the game ended
+        bool advance(Game& game) const;
+    };
+
+}
+
+#endif // !LOCKSTEP_SIMULATION_H_
@@ -0,0 +1,88 @@
+#ifndef MONTE_CARLO_STRATEGY_H_
+#define MONTE_CARLO_STRATEGY_H_
+
+#include "ShootStrategy.h"
+#include "GameState.h"
+#include "EndgameSolver.h"
+#include "TranspositionTable.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+#include "Random.h"
+
+#include <utility>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Tries every pair of ship and square and plays the rest of the game many times after it:
+    // the opponent's fleet is sampled uniformly from layouts consistent with the player's secondary grid
+    // and both players shoot randomly until the end of the game, with the same rounds limit and pausing rules.
+    // The pair with the best average result is chosen. Rollouts run in parallel until the time budget runs out.
+    // Near the end of the game rollouts are replaced by EndgameSolver, so every sampled fleet gives the exact value
+    // of every pair. Sampled fleets too large for the solver and solves which reach the deadline are played
+    // by rollouts instead. Without the player's state it shoots like RandomStrategy.
+    class MonteCarloStrategy final : public ShootStrategy
+    {
+    public:
+        // rollouts played by all decisions so far
+        struct Stats
+        {
+            long decisions = 0;
+            long rollouts = 0;
+            // states visited by endgame solvers
+            long nodes = 0;
+            // solves which reached the deadline, a single rollout was played instead
+            long aborted_solves = 0;
+            double seconds = 0;
+        };
+
+        explicit MonteCarloStrategy(Random rng, const StrategyOptions& options = StrategyOptions());
+        ~MonteCarloStrategy() override = default;
+
+        // play the state to the end with random shots of both sides
+        // returns the outcome of the main player with small bonus for every hit more than the opponent
+        static double rollout(GameState state, Random& rng);
+
+        const Stats& getStats() const;
+
+        int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) override;
+        std::pair<int,int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>, SquareHash>> squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths, const Player& player) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares, const Player& player) override;
+
+    private:
+        // rollouts played for every action before the clock is checked again
+        static const int ROLLOUTS_PER_BATCH = 4;
+        // sampled fleets which have to be small enough for solving before the endgame starts
+        static const int ENDGAME_PROBES = 8;
+        static const int ENDGAME_TABLE_ENTRIES = 1 << 20;
+
+        Random rng_;
+        StrategyOptions options_;
+        Stats stats_;
+        // one generator per worker, so rollouts do not share state
+        std::vector<Random> worker_rngs_;
+        // null when decisions run on the calling thread
+        std::unique_ptr<WorkStealingPool> pool_;
+        // created when the endgame is on, solved states are kept for the following decisions
+        std::unique_ptr<TranspositionTable> table_;
+        std::vector<EndgameSolver> solvers_;
+
+        // shot chosen by chooseShip, -1 when there is none
+        int chosen_square_ = -1;
+
+        // state of the game seen by the player, the opponent's ships are filled in by every rollout
+        GameState observe(const Player& player) const;
+        Shot decide(const ShipsLengths& ships_lengths, const Player& player);
+        void runBatch(long count, const WorkStealingPool::Body& body);
+    };
+
+}
+
+#endif // !MONTE_CARLO_STRATEGY_H_
@@ -0,0 +1,82 @@
+#ifndef OPENING_BOOK_H_
+#define OPENING_BOOK_H_
+
+#include "FleetLayouts.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+namespace battleship
+{
+
+    // Best first turn for every legal layout of the player's own fleet.
+    // Nothing is known about the opponent before the first shot and ranges of ships depend only on their
+    // placements, so the turn is computed offline. The chosen ship and squares give the largest expected
+    // number of hits when every layout of the opponent is equally likely.
+    // The file is a header followed by entries sorted by the packed layout. Numbers are stored in byte
+    // order of the machine which generated it.
+    struct OpeningBook
+    {
+        // "BSOB" when read as bytes on little endian machine
+        static const std::uint32_t MAGIC = 0x424F5342;
+        // increase after every change of the layout
+        static const std::uint32_t VERSION = 1;
+        // the longest turn at the start of the game
+        static const int TURN_SHOTS = 2;
+        static const std::uint8_t NO_SQUARE = 0xFF;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t entries;
+        };
+
+        struct Entry
+        {
+            // FleetLayouts::pack of own fleet
+            std::uint32_t layout;
+            std::uint8_t ship;
+            // squares in order of shooting, unused ones are NO_SQUARE
+            std::uint8_t squares[TURN_SHOTS];
+            std::uint8_t reserved;
+        };
+
+        // entries of all legal layouts sorted by layout
+        static std::vector<Entry> generate();
+
+        // throws BattleshipRuntimeError when the file cannot be written
+        static void write(const std::string& path, const std::vector<Entry>& entries);
+    };
+
+    static_assert(std::is_trivially_copyable<OpeningBook::Entry>::value, "entries are copied as raw bytes");
+    static_assert(sizeof(OpeningBook::Entry) == 8, "entries are packed");
+
+    // Opening book file mapped read-only into memory. Header and size are checked when the file is opened,
+    // BattleshipRuntimeError is thrown for files which are not opening books of the current version.
+    class MappedOpeningBook
+    {
+    public:
+        explicit MappedOpeningBook(const std::string& path);
+
+        std::size_t size() const;
+
+        // entry of the layout or nullptr when the book does not have it
+        const OpeningBook::Entry* find(const FleetLayouts::Layout& layout) const;
+
+    private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+
+        const OpeningBook::Header& header() const;
+        const OpeningBook::Entry* entries() const;
+    };
+
+}
+
+#endif // !OPENING_BOOK_H_
@@ -0,0 +1,46 @@
+#ifndef OPENING_BOOK_STRATEGY_H_
+#define OPENING_BOOK_STRATEGY_H_
+
+#include "ShootStrategy.h"
+#include "OpeningBook.h"
+
+#include <utility>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+
+namespace battleship
+{
+
+    // Plays the first turn of the game from the opening book with a single lookup of the player's own fleet.
+    // The planned squares are shot while they miss, after a hit or outside of the first turn all decisions
+    // are left to the fallback strategy.
+    class OpeningBookStrategy final : public ShootStrategy
+    {
+    public:
+        OpeningBookStrategy(std::shared_ptr<const MappedOpeningBook> book, std::unique_ptr<ShootStrategy> fallback);
+        ~OpeningBookStrategy() override = default;
+
+        const ShootStrategy& getFallback() const;
+
+        int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) override;
+        std::pair<int,int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>, SquareHash>> squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths, const Player& player) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares, const Player& player) override;
+
+    private:
+        std::shared_ptr<const MappedOpeningBook> book_;
+        std::unique_ptr<ShootStrategy> fallback_;
+
+        // square from the book for the following chooseSquare, -1 when the fallback decides
+        int book_square_ = -1;
+
+        // next square of the book for the player or -1 when the book does not know the state
+        int lookup(const ShipsLengths& ships_lengths, const Player& player, int& ship) const;
+    };
+
+}
+
+#endif // !OPENING_BOOK_STRATEGY_H_
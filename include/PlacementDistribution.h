@@ -0,0 +1,58 @@
+#ifndef PLACEMENT_DISTRIBUTION_H_
+#define PLACEMENT_DISTRIBUTION_H_
+
+#include "FleetLayouts.h"
+#include "Random.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace battleship
+{
+
+    // Weighted distribution over all legal layouts of the own fleet, made by battleship_placement_trainer.
+    // Layouts are sampled from an alias table in constant time with two draws from the generator.
+    // The file is a header followed by a float weight of every layout in the order of FleetLayouts. Numbers are
+    // stored in byte order of the machine which generated it.
+    class PlacementDistribution
+    {
+    public:
+        // "BSPD" when read as bytes on little endian machine
+        static const std::uint32_t MAGIC = 0x44505342;
+        // increase after every change of the layout
+        static const std::uint32_t VERSION = 1;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t layouts;
+        };
+
+        // weight of every layout in FleetLayouts, they do not have to sum to one
+        // throws BattleshipLogicError when the number of weights is wrong or weights are negative or all zero
+        explicit PlacementDistribution(const std::vector<double>& weights);
+
+        // throws BattleshipRuntimeError when the file cannot be read or is not a distribution of the current version
+        static PlacementDistribution load(const std::string& path);
+        // throws BattleshipRuntimeError when the file cannot be written
+        static void write(const std::string& path, const std::vector<double>& weights);
+
+        std::size_t size() const;
+        double probability(std::size_t layout) const;
+
+        FleetLayouts::Layout sample(Random& rng) const;
+
+    private:
+        std::vector<float> probabilities_;
+        // column of the alias table: the layout itself is taken with probability threshold_ / 2^32,
+        // otherwise its alias
+        std::vector<std::uint32_t> threshold_;
+        std::vector<std::uint32_t> alias_;
+    };
+
+}
+
+#endif // !PLACEMENT_DISTRIBUTION_H_
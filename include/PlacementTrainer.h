@@ -0,0 +1,64 @@
+#ifndef PLACEMENT_TRAINER_H_
+#define PLACEMENT_TRAINER_H_
+
+#include "LockstepSimulation.h"
+
+#include <boost/program_options.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Trains ship placement against a single strategy offline. Every legal layout of the own fleet plays
+    // a number of games against the strategy, which places its fleet at random, and layouts conceding fewer
+    // hits get larger weights in the written PlacementDistribution. Games run in lockstep on all cores,
+    // so both strategies need batched decisions.
+    class PlacementTrainer
+    {
+    public:
+        struct LayoutStats
+        {
+            // share of games which were not lost
+            double survival = 0;
+            // average hits taken by the fleet
+            double conceded = 0;
+        };
+
+        PlacementTrainer(int argc, char** argv);
+
+        void run();
+
+        // statistics of layouts with indices [begin, end) in FleetLayouts, the k-th game of layout l is
+        // the game l * games + k of the simulation with given seed
+        static std::vector<LayoutStats> evaluate(const LockstepSimulation& simulation, std::uint64_t seed, int games,
+                                                 long begin, long end);
+
+        // weights proportional to exp(-conceded / temperature), lower temperature prefers the best layouts more
+        static std::vector<double> weights(const std::vector<LayoutStats>& stats, double temperature);
+
+    private:
+        int games_;
+        int max_rounds_;
+        int threads_;
+        double temperature_;
+        std::string player_;
+        std::string opponent_;
+        std::string output_;
+        std::uint64_t seed_;
+
+        boost::program_options::options_description description_;
+        boost::program_options::variables_map used_options_;
+
+        void validateOptions();
+    };
+
+    #define TRAINER_GAMES "games"
+    #define TRAINER_THREADS "threads"
+    #define TRAINER_TEMPERATURE "temperature"
+    #define TRAINER_OUTPUT "output"
+
+}
+
+#endif // !PLACEMENT_TRAINER_H_
@@ -4,9 +4,14 @@
 #include "Ship.h"
 #include "Grid.h"
 #include "ShipsGrid.h"
+#include "FleetLayouts.h"
+
+#include "Bitboard.h"
+#include "Random.h"
 
 #include <utility>
 #include <vector>
+#include <array>
 
 namespace battleship
 {
@@ -20,9 +25,16 @@ namespace battleship
         bool canShoot() const;
         bool mayShootNextRounds() const;
         int getHits() const;
+        // number of rounds ended by nextRound, or set by setFinishedRounds when the game is loaded
+        int getFinishedRounds() const;
+        void setFinishedRounds(int rounds);
         const ShipsGrid& getPrimaryGird() const;
         const Grid& getSecondaryGrid() const;
 
+        // squares in ship's range that were not targeted yet, the same as
+        // secondary grid's getAvailableMask but kept up to date by update() instead of rebuilt
+        Bitboard getUntargetedMask(const Ship& ship) const;
+
         // inform player that next round has started
         void nextRound();
 
@@ -39,14 +51,40 @@ namespace battleship
 
         void pauseShips(const std::vector<int>& ships_lengths);
 
+        // set state saved between rounds at once, ships must not be placed yet
+        // opponent_shots are all squares the opponent shot at, secondary_grid keeps player's shots
+        void restore(const Fleet& fleet, Bitboard opponent_shots, const Grid& secondary_grid,
+                     const std::vector<int>& pausing_ships);
+
+        // shots fired by ships in the current round, index is the ship's length - 1
+        void restoreShots(const std::array<int, Ship::MAX_LENGTH>& shots);
+
         virtual void setUpShips() = 0;
         virtual std::pair<int,int> shoot() = 0;
 
     protected:
+        // place ships of a uniformly chosen legal layout on the empty grid, it takes a single draw from rng
+        void placeRandomFleet(Random& rng);
+        // place ships of the layout on the empty grid
+        void placeFleet(const FleetLayouts::Layout& layout);
+
         // Primary grid stres ships and its locations and remembers opponents shots
         ShipsGrid primary_grid_;
         // Secondary grid stores player's shots and remember opponent's ships locations
         Grid secondary_grid_;
+
+    private:
+        struct RangeCache
+        {
+            // ship's location the range was computed for, it changes only when ship is placed
+            Bitboard location;
+            Bitboard untargeted;
+        };
+
+        // index is the ship's length - 1
+        mutable std::array<RangeCache, Ship::MAX_LENGTH> ranges_;
+
+        int finished_rounds_ = 0;
     };
 
 }
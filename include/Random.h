@@ -0,0 +1,102 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <array>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Seedable xoshiro256** generator, cheap to copy and to call.
+    // Generators created with the same seed and different stream numbers produce sequences
+    // that are 2^128 values apart, so they can be used as independent sources for players and strategies.
+    // It satisfies UniformRandomBitGenerator, so it can be used with <random> distributions.
+    class Random
+    {
+    public:
+        using result_type = std::uint64_t;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~result_type(0); }
+
+        // seeded from std::random_device
+        Random();
+        explicit Random(std::uint64_t seed, unsigned stream = 0);
+
+        // one seed from std::random_device
+        static std::uint64_t randomSeed();
+
+        // seed of the index-th game played with the base seed
+        static std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t index);
+
+        result_type operator()();
+
+        // uniformly distributed integer from [0, bound), bound must be greater than zero
+        std::uint32_t below(std::uint32_t bound);
+
+        // advance the generator by 2^128 values
+        void jump();
+
+        // words of the state, batched strategies keep generators of many games in arrays
+        using State = std::array<std::uint64_t, 4>;
+        State getState() const;
+        void setState(const State& state);
+
+    private:
+        std::uint64_t state_[4];
+
+        static std::uint64_t splitmix(std::uint64_t& x);
+        static std::uint64_t rotl(std::uint64_t x, int k);
+    };
+
+    inline std::uint64_t Random::rotl(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    inline Random::result_type Random::operator()()
+    {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+
+        return result;
+    }
+
+    inline Random::State Random::getState() const
+    {
+        return {{ state_[0], state_[1], state_[2], state_[3] }};
+    }
+
+    inline void Random::setState(const State& state)
+    {
+        for (int i = 0; i < 4; i++)
+            state_[i] = state[i];
+    }
+
+    inline std::uint32_t Random::below(std::uint32_t bound)
+    {
+        // Lemire's multiply-shift method, the division is needed only in rare cases to remove the bias
+        std::uint64_t m = ((*this)() >> 32) * bound;
+        std::uint32_t low = (std::uint32_t)m;
+        if (low < bound)
+        {
+            const std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold)
+            {
+                m = ((*this)() >> 32) * bound;
+                low = (std::uint32_t)m;
+            }
+        }
+        return (std::uint32_t)(m >> 32);
+    }
+
+}
+
+#endif // !RANDOM_H_
@@ -3,6 +3,9 @@
 
 #include "ShootStrategy.h"
 #include "ShipsGrid.h"
+#include "Random.h"
+#include "ShotBatch.h"
+#include "exceptions.h"
 
 #include <utility>
 #include <vector>
@@ -12,16 +15,58 @@
 namespace battleship
 {
 
-    class RandomStrategy : public ShootStrategy
+    class RandomStrategy final : public ShootStrategy
     {
     public:
         RandomStrategy() = default;
+        explicit RandomStrategy(Random rng);
         ~RandomStrategy() override = default;
 
+        // decisions of many games at once, every game uses its own generator from the batch
+        static void chooseShots(ShotBatch& batch, BatchIsa isa = BI_AUTO);
+
         int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) override;
         std::pair<int,int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>, SquareHash>> squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares) override;
+        int chooseShip(const ShipsLengths& ships_lengths, const Player& player) override;
+        std::pair<int,int> chooseSquare(const SquareSet& squares, const Player& player) override;
+
+    private:
+        Random rng_;
     };
 
+    inline void RandomStrategy::chooseShots(ShotBatch& batch, BatchIsa isa)
+    {
+        batch.chooseRandomShots(BSC_RANDOM, isa);
+    }
+
+    // called for every shot of simulated games, StaticAIPlayer inlines them
+
+    inline int RandomStrategy::chooseShip(const ShipsLengths& ships_lengths)
+    {
+        if (ships_lengths.empty())
+            throw BattleshipRuntimeError("RandomStrategy::chooseShip: no ship to choose.");
+        return ships_lengths[rng_.below(ships_lengths.size())];
+    }
+
+    inline std::pair<int,int> RandomStrategy::chooseSquare(const SquareSet& squares)
+    {
+        if (squares.empty())
+            throw BattleshipRuntimeError("RandomStrategy::chooseSquare: no square to choose.");
+        return squares.nth(rng_.below(squares.size()));
+    }
+
+    inline int RandomStrategy::chooseShip(const ShipsLengths& ships_lengths, const Player&)
+    {
+        return chooseShip(ships_lengths);
+    }
+
+    inline std::pair<int,int> RandomStrategy::chooseSquare(const SquareSet& squares, const Player&)
+    {
+        return chooseSquare(squares);
+    }
+
 }
 
 #endif // !RANDOM_STRATEGY_H_
@@ -1,6 +1,8 @@
 #ifndef SHIP_H_
 #define SHIP_H_
 
+#include "Bitboard.h"
+
 #include <utility>
 #include <vector>
 #include <memory>
@@ -29,6 +31,8 @@ namespace battleship
         int getRange() const;
         int getLength() const;
         int getHits() const;
+        // shots fired in the current round
+        int getShots() const;
         bool canShoot() const;
         bool isSunk() const;
         bool isPausing() const;
@@ -36,6 +40,12 @@ namespace battleship
         // this method return squares order increasingly be first then by second value
         std::unique_ptr<std::vector<std::pair<int, int>>> getOccupiedSquares() const;
 
+        // the same squares as getOccupiedSquares but as a bitboard, empty until location is set
+        Bitboard getOccupiedMask() const;
+
+        // all squares the ship can fire at, regardless of whether they were already shot
+        Bitboard getRangeMask() const;
+
         // inform ship that next round has started
         // shots counter should be set to zero
         // if is_pausing is true it should be set to false
@@ -51,12 +61,18 @@ namespace battleship
         // pause this ship until the next round
         void pause();
 
+        // set number of shots fired in the current round without checking whether the ship can shoot,
+        // it is used to restore a game in the middle of a round
+        void restoreShots(int shots);
+
         // remembers where ship was located. squares should be ordered increasingly by first then by second value
         // note that occupied_suqares should be sorted in ShipGrid::setShipLocation
         void setOccupiedSquares(std::unique_ptr<const std::vector<std::pair<int, int>>> occupied_squares);
 
     private:
         std::unique_ptr<const std::vector<std::pair<int, int>>> occupied_squares_;
+        Bitboard occupied_mask_;
+        Bitboard range_mask_;
         mutable int shots_counter_ = 0;
         int hits_counter_ = 0;
         bool is_pausing_ = false;
@@ -13,6 +13,22 @@
 namespace battleship
 {
 
+    // result of checking ship's location, PS_OK means the ship can be placed there
+    enum PlacementStatus
+    {
+        PS_OK,
+        PS_WRONG_LENGTH,
+        PS_OUT_OF_RANGE,
+        PS_WRONG_SHAPE,
+        PS_TOO_CLOSE
+    };
+
+    // squares of a ship, only the first length elements are used
+    using ShipSquares = std::array<std::pair<int, int>, Ship::MAX_LENGTH>;
+
+    // squares of all ships, index is the ship's length - 1
+    using Fleet = std::array<Bitboard, Ship::MAX_LENGTH>;
+
     class ShipsGrid : public Grid
     {
     public:
@@ -27,10 +43,21 @@ namespace battleship
         // If ship was hit square type should be ST_HIT, but if ship was sunk all ship's squares should be ST_SUNK
         ShotResult takeShot(std::pair<int, int> square);
 
-        // do two thinds: set ship location in table_ and pass occupied_squares to ship using it's
+        // do two thinds: set ship location in ships planes and pass occupied_squares to ship using it's
         // setOccupiedSquares() method. ship size is stored as vector size.
         void setShipLocation(std::unique_ptr<std::vector<std::pair<int,int>>> occupied_squares);
 
+        // the same checks as in setShipLocation, but the result is returned instead of thrown
+        PlacementStatus checkPlacement(ShipSquares squares, int length) const;
+
+        // set ship location like setShipLocation when checkPlacement returns PS_OK, otherwise do nothing
+        // it never throws, so it can be used for placing ships by trial
+        PlacementStatus tryPlace(ShipSquares squares, int length);
+
+        // set ships locations like setShipLocation and then take all shots at once
+        // ships must not be placed yet, it is used to restore saved game without replaying it
+        void restore(const Fleet& fleet, Bitboard shots);
+
         // let ship with speciifed length perform a shot
         void shoot(int ship_length);
 
@@ -38,10 +65,17 @@ namespace battleship
 
         void pauseShips(const std::vector<int>& ships_lengths);
 
+        // shots fired by ships in the current round, index is the ship's length - 1
+        void restoreShots(const std::array<int, Ship::MAX_LENGTH>& shots);
+
     private:
         // index is the ship's length - 1
         std::array<Ship, 3> ships_;
 
+        // squares must be sorted, on success mask is set to ship's squares
+        PlacementStatus checkSortedPlacement(const std::pair<int,int>* squares, int length, Bitboard& mask) const;
+        void place(std::unique_ptr<std::vector<std::pair<int,int>>> occupied_squares, Bitboard mask);
+
     };
 
 }
@@ -2,15 +2,57 @@
 #define SHOOT_STRATEGY_H_
 
 #include "ShipsGrid.h"
+#include "SquareSet.h"
 
 #include <utility>
 #include <vector>
 #include <unordered_set>
 #include <memory>
+#include <array>
+#include <cassert>
 
 namespace battleship
 {
 
+    class Player;
+    class MappedOpeningBook;
+
+    // Fixed-capacity list of ships lengths, passed to strategies without allocating memory
+    class ShipsLengths
+    {
+    public:
+        ShipsLengths() = default;
+
+        void push_back(int length);
+        bool empty() const;
+        int size() const;
+        int operator[](int i) const;
+
+        const int* begin() const;
+        const int* end() const;
+
+    private:
+        std::array<int, Ship::MAX_LENGTH> lengths_ {{ }};
+        int size_ = 0;
+    };
+
+    // settings of strategies which need to know more about the game than the player's state
+    struct StrategyOptions
+    {
+        // time for a single decision
+        int think_ms = 100;
+        // threads used by a single decision, 0 means one thread per hardware core
+        int threads = 0;
+        int max_rounds = 20;
+        // the main player shoots first in every round
+        bool moves_first = true;
+        // the game is solved exactly when there are at most this many untargeted squares in ranges of ships
+        // of both players, 0 turns solving off
+        int endgame_squares = 12;
+        // the first turn is played from the book when it is set, the book is shared by all strategies
+        std::shared_ptr<const MappedOpeningBook> opening_book;
+    };
+
     class ShootStrategy
     {
     public:
@@ -18,9 +60,49 @@ namespace battleship
 
         virtual int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) = 0;
         virtual std::pair<int,int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>, SquareHash>> squares) = 0;
+
+        // allocation free versions used by AIPlayer
+        // by default arguments are copied into containers and passed to the versions above
+        virtual int chooseShip(const ShipsLengths& ships_lengths);
+        virtual std::pair<int,int> chooseSquare(const SquareSet& squares);
+
+        // versions which can look at the state of the shooting player, AIPlayer calls these ones
+        // by default the player is ignored and the versions above are used
+        virtual int chooseShip(const ShipsLengths& ships_lengths, const Player& player);
+        virtual std::pair<int,int> chooseSquare(const SquareSet& squares, const Player& player);
     };
 
+    inline void ShipsLengths::push_back(int length)
+    {
+        assert(size_ < Ship::MAX_LENGTH);
+        lengths_[size_++] = length;
+    }
+
+    inline bool ShipsLengths::empty() const
+    {
+        return size_ == 0;
+    }
+
+    inline int ShipsLengths::size() const
+    {
+        return size_;
+    }
+
+    inline int ShipsLengths::operator[](int i) const
+    {
+        return lengths_[i];
+    }
+
+    inline const int* ShipsLengths::begin() const
+    {
+        return lengths_.data();
+    }
+
+    inline const int* ShipsLengths::end() const
+    {
+        return lengths_.data() + size_;
+    }
+
 }
 
 #endif // !SHOOT_STRATEGY_H_
-
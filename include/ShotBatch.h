@@ -0,0 +1,70 @@
+#ifndef SHOT_BATCH_H_
+#define SHOT_BATCH_H_
+
+#include "Ship.h"
+#include "Random.h"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace battleship
+{
+
+    // instruction set of batched strategies, AUTO takes the best one the processor supports
+    enum BatchIsa
+    {
+        BI_AUTO,
+        BI_SCALAR,
+        BI_AVX2
+    };
+
+    // how batched random shots choose the ship
+    enum BatchShipChoice
+    {
+        // like RandomStrategy
+        BSC_RANDOM,
+        // like GreedyStrategy
+        BSC_LONGEST
+    };
+
+    // Shooting sides of many independent games in struct-of-arrays layout, index of every array is the game.
+    // Every game has its own generator, so a batched strategy decides exactly like the strategy of
+    // a single game with the same generator. Games without ships which can shoot are skipped and their
+    // generators do not change.
+    struct ShotBatch
+    {
+        // input: bit length - 1 is set for ships which can shoot
+        std::vector<std::uint64_t> ships;
+        // input: low and high words of untargeted squares in range of every ship, index of the array is length - 1
+        std::array<std::vector<std::uint64_t>, Ship::MAX_LENGTH> untargeted_low;
+        std::array<std::vector<std::uint64_t>, Ship::MAX_LENGTH> untargeted_high;
+        // input and output: words of Random's state of every game
+        std::array<std::vector<std::uint64_t>, 4> rng;
+        // output: chosen ship and square, both are zero for skipped games
+        std::vector<std::uint8_t> ship_length;
+        std::vector<std::uint8_t> square;
+
+        explicit ShotBatch(std::size_t games = 0);
+
+        std::size_t size() const;
+        void resize(std::size_t games);
+
+        Random getRandom(std::size_t game) const;
+        void setRandom(std::size_t game, const Random& random);
+
+        // true when AVX2 version is compiled in and the processor supports it
+        static bool hasAvx2();
+
+        // ship and then random untargeted square in its range for every game
+        // throws BattleshipRuntimeError when AVX2 is requested and not available
+        void chooseRandomShots(BatchShipChoice choice, BatchIsa isa = BI_AUTO);
+    };
+
+    // batched version of a strategy, strategies which have one return it from StrategyFactory::batchPolicy
+    using BatchPolicy = void (*)(ShotBatch& batch, BatchIsa isa);
+
+}
+
+#endif // !SHOT_BATCH_H_
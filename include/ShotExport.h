@@ -0,0 +1,139 @@
+#ifndef SHOT_EXPORT_H_
+#define SHOT_EXPORT_H_
+
+#include "Player.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+namespace battleship
+{
+
+    // Every shot of simulated games in columnar layout, index of every column is the row.
+    struct ShotColumns
+    {
+        // index of the game, its players were seeded with Random::deriveSeed(seed, game)
+        std::vector<std::uint64_t> game;
+        // counting from 1
+        std::vector<std::uint8_t> round;
+        // 0 is the main player and 1 the opponent
+        std::vector<std::uint8_t> player;
+        std::vector<std::uint8_t> ship;
+        // index of the square in Bitboard
+        std::vector<std::uint8_t> square;
+        // ShotResult
+        std::vector<std::uint8_t> result;
+        // untargeted squares left in the ship's range after the shot
+        std::vector<std::uint8_t> range;
+
+        std::size_t size() const;
+        void clear();
+        void resize(std::size_t rows);
+    };
+
+    // Columnar binary file of shots. The file is a header followed by blocks, every block is its number
+    // of rows and then each column of ShotColumns as an array of that many fixed-width values, so a column
+    // of a block is read with a single read. Numbers are stored in byte order of the machine which wrote them.
+    struct ShotExport
+    {
+        // "BSSE" when read as bytes on little endian machine
+        static const std::uint32_t MAGIC = 0x45535342;
+        // increase after every change of the layout
+        static const std::uint32_t VERSION = 1;
+        static const std::uint32_t COLUMNS = 7;
+        // rows a buffer collects before it writes the block
+        static const std::size_t BLOCK_ROWS = 1 << 16;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t columns;
+            std::uint32_t reserved;
+            // seed of the simulation
+            std::uint64_t seed;
+        };
+
+        // rows of the file as CSV with a header line, the file is read block by block
+        // throws BattleshipRuntimeError when the file is not a shot export
+        static void writeCsv(const std::string& path, std::ostream& out);
+    };
+
+    static_assert(std::is_trivially_copyable<ShotExport::Header>::value, "header is copied as raw bytes");
+
+    // Writer of the shot export file shared by all threads, blocks are appended under a lock.
+    // BattleshipRuntimeError is thrown when the file cannot be written.
+    class ShotExportWriter
+    {
+    public:
+        ShotExportWriter(const std::string& path, std::uint64_t seed);
+
+        // throws BattleshipLogicError when the block has more than BLOCK_ROWS rows
+        void writeBlock(const ShotColumns& block);
+        // write everything buffered by the stream to the file
+        void flush();
+
+    private:
+        std::string path_;
+        std::mutex mutex_;
+        std::ofstream file_;
+    };
+
+    // Per-thread buffer of shots, it writes full blocks to the shared writer, so threads lock it only once
+    // per BLOCK_ROWS shots. It is the observer of Simulation::playStaticGame.
+    class ShotExportBuffer
+    {
+    public:
+        explicit ShotExportBuffer(ShotExportWriter& writer);
+        // rows left in the buffer are written, errors are ignored here, call flush to get them
+        ~ShotExportBuffer();
+
+        ShotExportBuffer(const ShotExportBuffer&) = delete;
+        ShotExportBuffer& operator=(const ShotExportBuffer&) = delete;
+
+        // game of the following shots
+        void setGame(std::uint64_t game);
+        static const bool NEEDS_SHIP = true;
+
+        // ship is the length of the ship which fired
+        void shot(int player, int round, const Player& shooter, int ship, std::pair<int, int> square,
+                  ShotResult result);
+        // write rows of the buffer as a block
+        void flush();
+
+    private:
+        ShotExportWriter& writer_;
+        ShotColumns columns_;
+        std::size_t rows_ = 0;
+        std::uint64_t game_ = 0;
+    };
+
+    // Blocks of the shot export file read one by one.
+    class ShotExportReader
+    {
+    public:
+        // throws BattleshipRuntimeError when the file is not a shot export of the current version
+        explicit ShotExportReader(const std::string& path);
+
+        const ShotExport::Header& header() const;
+
+        // replace columns with the next block, false at the end of the file
+        // throws BattleshipRuntimeError when the block is truncated
+        bool next(ShotColumns& block);
+
+    private:
+        std::string path_;
+        std::ifstream file_;
+        ShotExport::Header header_;
+    };
+
+}
+
+#endif // !SHOT_EXPORT_H_
@@ -0,0 +1,157 @@
+#ifndef SIMULATION_H_
+#define SIMULATION_H_
+
+#include "Player.h"
+
+#include <array>
+#include <utility>
+
+namespace battleship
+{
+
+    // result of a game from the main player's point of view
+    enum GameOutcome
+    {
+        GO_WIN,
+        GO_DRAW,
+        GO_LOSS
+    };
+
+    struct GameResult
+    {
+        GameOutcome outcome;
+        int rounds;
+    };
+
+    struct SimulationStats
+    {
+        long wins = 0;
+        long draws = 0;
+        long losses = 0;
+        long rounds = 0;
+
+        void add(const GameResult& result);
+        void merge(const SimulationStats& other);
+        long games() const;
+        double averageRounds() const;
+    };
+
+    // observer of simulated games which ignores their shots
+    struct NoShotObserver
+    {
+        // the ship which fired is found only for observers which need it
+        static const bool NEEDS_SHIP = false;
+
+        void shot(int, int, const Player&, int, std::pair<int, int>, ShotResult) { }
+    };
+
+    // Plays games between two AI players without any UI, delays or saving.
+    // Rules are the same as in GameLogic::run.
+    class Simulation
+    {
+    public:
+        explicit Simulation(int max_rounds);
+
+        // both players must have ships already set up, they are left in the final state
+        GameResult playGame(Player& main, Player& opponent) const;
+
+        // the same game for players of types known at compile time, with final types like StaticAIPlayer
+        // their shots are not virtual calls
+        template<typename Main, typename Opponent>
+        GameResult playStaticGame(Main& main, Opponent& opponent) const;
+
+        // the same game, observer.shot(player, round, shooter, ship, square, result) is called after every shot,
+        // player is 0 for the main player and 1 for the opponent, ship is the length of the ship which fired
+        // or 0 when the observer's NEEDS_SHIP is false
+        template<typename Main, typename Opponent, typename Observer>
+        GameResult playStaticGame(Main& main, Opponent& opponent, Observer& observer) const;
+
+    private:
+        int max_rounds_;
+
+        // shots of the player's ships before the shot, the ship which fired is the one whose count changed
+        template<typename Observer>
+        static std::array<int, Ship::MAX_LENGTH> shipShots(const Player& player);
+        template<typename Observer>
+        static int firedShip(const Player& player, const std::array<int, Ship::MAX_LENGTH>& shots);
+    };
+
+    template<typename Main, typename Opponent>
+    GameResult Simulation::playStaticGame(Main& main, Opponent& opponent) const
+    {
+        NoShotObserver observer;
+        return playStaticGame(main, opponent, observer);
+    }
+
+    template<typename Main, typename Opponent, typename Observer>
+    GameResult Simulation::playStaticGame(Main& main, Opponent& opponent, Observer& observer) const
+    {
+        int round = 0;
+        while (++round <= max_rounds_)
+        {
+            // main player, ai always takes the second shot when it is possible
+            if (!main.canShoot())
+            {
+                if (!main.mayShootNextRounds())
+                    return { GO_LOSS, round };
+            }
+            else
+            {
+                while (main.canShoot())
+                {
+                    const auto shots = shipShots<Observer>(main);
+                    auto p = main.shoot();
+                    auto sr = opponent.takeShot(p);
+                    main.update(p, sr);
+                    observer.shot(0, round, main, firedShip<Observer>(main, shots), p, sr);
+                }
+            }
+
+            // opponent player
+            if (!opponent.canShoot() && !opponent.mayShootNextRounds())
+                return { GO_WIN, round };
+
+            while (opponent.canShoot())
+            {
+                const auto shots = shipShots<Observer>(opponent);
+                auto p = opponent.shoot();
+                auto sr = main.takeShot(p);
+                opponent.update(p, sr);
+                observer.shot(1, round, opponent, firedShip<Observer>(opponent, shots), p, sr);
+            }
+
+            main.nextRound();
+            opponent.nextRound();
+        }
+
+        // the player whose ships were hit fewer times wins
+        int main_hits = main.getHits();
+        int opponent_hits = opponent.getHits();
+        if (main_hits == opponent_hits)
+            return { GO_DRAW, max_rounds_ };
+        return { main_hits < opponent_hits ? GO_WIN : GO_LOSS, max_rounds_ };
+    }
+
+    template<typename Observer>
+    std::array<int, Ship::MAX_LENGTH> Simulation::shipShots(const Player& player)
+    {
+        std::array<int, Ship::MAX_LENGTH> shots {};
+        if (Observer::NEEDS_SHIP)
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                shots[l - 1] = player.getPrimaryGird().getShip(l).getShots();
+        return shots;
+    }
+
+    template<typename Observer>
+    int Simulation::firedShip(const Player& player, const std::array<int, Ship::MAX_LENGTH>& shots)
+    {
+        if (Observer::NEEDS_SHIP)
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                if (player.getPrimaryGird().getShip(l).getShots() != shots[l - 1])
+                    return l;
+        return 0;
+    }
+
+}
+
+#endif // !SIMULATION_H_
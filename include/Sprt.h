@@ -0,0 +1,68 @@
+#ifndef SPRT_H_
+#define SPRT_H_
+
+#include "Simulation.h"
+
+#include <array>
+#include <utility>
+
+namespace battleship
+{
+
+    enum SprtDecision
+    {
+        SD_CONTINUE,
+        // the strategy is not better than elo0
+        SD_ACCEPT_H0,
+        // the strategy is at least elo1 better
+        SD_ACCEPT_H1
+    };
+
+    // Sequential probability ratio test of the logistic Elo difference between two strategies, H0: elo = elo0
+    // against H1: elo = elo1. Observations are pairs of games with swapped colours and the same layouts, so
+    // their results are correlated and the test counts the five possible scores of a pair (pentanomial model).
+    // The log-likelihood ratio is the usual normal approximation of the generalized SPRT.
+    class Sprt
+    {
+    public:
+        // throws BattleshipLogicError when elo0 is not lower than elo1 or error rates are not in (0, 1)
+        Sprt(double elo0, double elo1, double alpha, double beta);
+
+        // results of both games of a pair from the first strategy's point of view
+        void addPair(GameOutcome first, GameOutcome second);
+        // add pairs counted by another test with the same bounds
+        void merge(const Sprt& other);
+
+        long pairs() const;
+        // pairs with score 0, 1/4, 1/2, 3/4 and 1 of the first strategy
+        const std::array<long, 5>& getPentanomial() const;
+
+        // average score of the first strategy in a game
+        double score() const;
+        // Elo difference of the score and its 95% confidence interval
+        double elo() const;
+        std::pair<double, double> eloInterval() const;
+
+        double llr() const;
+        // the test accepts H0 at or below the lower bound and H1 at or above the upper one
+        double lowerBound() const;
+        double upperBound() const;
+        SprtDecision decision() const;
+
+        static double eloToScore(double elo);
+        static double scoreToElo(double score);
+
+    private:
+        double elo0_;
+        double elo1_;
+        double alpha_;
+        double beta_;
+        std::array<long, 5> pentanomial_ {{ }};
+
+        // variance of the score of a pair divided by the number of pairs, it is never zero
+        double scoreVariance() const;
+    };
+
+}
+
+#endif // !SPRT_H_
@@ -0,0 +1,147 @@
+#ifndef SQUARE_SET_H_
+#define SQUARE_SET_H_
+
+#include "Bitboard.h"
+
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+namespace battleship
+{
+
+    // Set of grid squares with value semantics, it never allocates memory.
+    // Squares are iterated in increasing order by first then by second value.
+    class SquareSet
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<int, int>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = value_type;
+
+            const_iterator() = default;
+            explicit const_iterator(Bitboard remaining);
+
+            value_type operator*() const;
+            const_iterator& operator++();
+            const_iterator operator++(int);
+            bool operator==(const const_iterator& other) const;
+            bool operator!=(const const_iterator& other) const;
+
+        private:
+            // squares not visited yet, the current one is the lowest
+            Bitboard remaining_;
+        };
+
+        SquareSet() = default;
+        explicit SquareSet(Bitboard squares);
+
+        bool empty() const;
+        int size() const;
+        bool contains(std::pair<int, int> square) const;
+        void insert(std::pair<int, int> square);
+        void erase(std::pair<int, int> square);
+
+        // n-th square in iteration order, n must be lower than size()
+        // it takes constant time, so a random square can be picked without iterating
+        std::pair<int, int> nth(int n) const;
+
+        const Bitboard& getMask() const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+    private:
+        Bitboard squares_;
+    };
+
+    inline SquareSet::const_iterator::const_iterator(Bitboard remaining)
+        : remaining_(remaining)
+    { }
+
+    inline SquareSet::const_iterator::value_type SquareSet::const_iterator::operator*() const
+    {
+        return Bitboard::toSquare(remaining_.lowest());
+    }
+
+    inline SquareSet::const_iterator& SquareSet::const_iterator::operator++()
+    {
+        remaining_.popLowest();
+        return *this;
+    }
+
+    inline SquareSet::const_iterator SquareSet::const_iterator::operator++(int)
+    {
+        auto r = *this;
+        ++*this;
+        return r;
+    }
+
+    inline bool SquareSet::const_iterator::operator==(const const_iterator& other) const
+    {
+        return remaining_ == other.remaining_;
+    }
+
+    inline bool SquareSet::const_iterator::operator!=(const const_iterator& other) const
+    {
+        return remaining_ != other.remaining_;
+    }
+
+    inline SquareSet::SquareSet(Bitboard squares)
+        : squares_(squares)
+    { }
+
+    inline bool SquareSet::empty() const
+    {
+        return squares_.empty();
+    }
+
+    inline int SquareSet::size() const
+    {
+        return squares_.count();
+    }
+
+    inline bool SquareSet::contains(std::pair<int, int> square) const
+    {
+        return square.first >= 0 && square.second >= 0 && square.first < Bitboard::SIZE
+                && square.second < Bitboard::SIZE && squares_.test(square);
+    }
+
+    inline void SquareSet::insert(std::pair<int, int> square)
+    {
+        squares_.set(square);
+    }
+
+    inline void SquareSet::erase(std::pair<int, int> square)
+    {
+        squares_.reset(square);
+    }
+
+    inline std::pair<int, int> SquareSet::nth(int n) const
+    {
+        return Bitboard::toSquare(squares_.nth(n));
+    }
+
+    inline const Bitboard& SquareSet::getMask() const
+    {
+        return squares_;
+    }
+
+    inline SquareSet::const_iterator SquareSet::begin() const
+    {
+        return const_iterator(squares_);
+    }
+
+    inline SquareSet::const_iterator SquareSet::end() const
+    {
+        return const_iterator();
+    }
+
+}
+
+#endif // !SQUARE_SET_H_
@@ -0,0 +1,93 @@
+#ifndef STATIC_AI_PLAYER_H_
+#define STATIC_AI_PLAYER_H_
+
+#include "Player.h"
+#include "ShootStrategy.h"
+#include "Random.h"
+#include "exceptions.h"
+
+#include <utility>
+#include <type_traits>
+
+namespace battleship
+{
+
+    // AIPlayer with the strategy of a type known at compile time, made for simulated games.
+    // The strategy is kept by value and both are final, so Simulation::playStaticGame calls shoot and
+    // the strategy's methods directly and can inline them. It plays exactly like AIPlayer with the same
+    // strategy and generators.
+    template<typename Strategy>
+    class StaticAIPlayer final : public Player
+    {
+        static_assert(std::is_base_of<ShootStrategy, Strategy>::value, "strategy has to implement ShootStrategy");
+        static_assert(std::is_final<Strategy>::value, "calls of the strategy are resolved statically only when it is final");
+
+    public:
+        // strategies which take no options are created from their generator only
+        StaticAIPlayer(Random strategy_rng, const StrategyOptions& options, Random rng);
+        ~StaticAIPlayer() override = default;
+
+        void setUpShips() override;
+        std::pair<int, int> shoot() override;
+
+        const Strategy& getStrategy() const;
+
+    private:
+        Strategy strategy_;
+        Random rng_;
+
+        StaticAIPlayer(std::true_type, Random strategy_rng, const StrategyOptions& options, Random rng);
+        StaticAIPlayer(std::false_type, Random strategy_rng, const StrategyOptions& options, Random rng);
+    };
+
+    template<typename Strategy>
+    StaticAIPlayer<Strategy>::StaticAIPlayer(Random strategy_rng, const StrategyOptions& options, Random rng)
+        : StaticAIPlayer(std::is_constructible<Strategy, Random, const StrategyOptions&>(), strategy_rng, options, rng)
+    { }
+
+    template<typename Strategy>
+    StaticAIPlayer<Strategy>::StaticAIPlayer(std::true_type, Random strategy_rng, const StrategyOptions& options,
+                                             Random rng)
+        : strategy_(strategy_rng, options)
+        , rng_(rng)
+    { }
+
+    template<typename Strategy>
+    StaticAIPlayer<Strategy>::StaticAIPlayer(std::false_type, Random strategy_rng, const StrategyOptions&, Random rng)
+        : strategy_(strategy_rng)
+        , rng_(rng)
+    { }
+
+    template<typename Strategy>
+    void StaticAIPlayer<Strategy>::setUpShips()
+    {
+        placeRandomFleet(rng_);
+    }
+
+    template<typename Strategy>
+    std::pair<int, int> StaticAIPlayer<Strategy>::shoot()
+    {
+        // the same as AIPlayer::shoot
+        ShipsLengths lengths;
+        for (auto& s : primary_grid_.getAllShips())
+        {
+            if (s.getLength() == 0)
+                throw BattleshipLogicError("StaticAIPlayer::shoot: cannot shoot before setting ships locations.");
+            if (s.canShoot() && !getUntargetedMask(s).empty())
+                lengths.push_back(s.getLength());
+        }
+
+        const int length = strategy_.chooseShip(lengths, *this);
+        primary_grid_.shoot(length);
+        return strategy_.chooseSquare(SquareSet(getUntargetedMask(primary_grid_.getShip(length))), *this);
+    }
+
+    template<typename Strategy>
+    const Strategy& StaticAIPlayer<Strategy>::getStrategy() const
+    {
+        return strategy_;
+    }
+
+}
+
+#endif // !STATIC_AI_PLAYER_H_
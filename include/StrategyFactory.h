@@ -0,0 +1,32 @@
+#ifndef STRATEGY_FACTORY_H_
+#define STRATEGY_FACTORY_H_
+
+#include "ShootStrategy.h"
+#include "Random.h"
+#include "ShotBatch.h"
+
+#include <string>
+#include <memory>
+
+namespace battleship
+{
+
+    // Creates strategies from names used in command line options and save files
+    class StrategyFactory
+    {
+    public:
+        static bool isStrategyName(const std::string& name);
+
+        // throws ArgumentsError for unknown name
+        // with an opening book in options the strategy is wrapped in OpeningBookStrategy
+        static std::unique_ptr<ShootStrategy> create(const std::string& name);
+        static std::unique_ptr<ShootStrategy> create(const std::string& name, Random rng);
+        static std::unique_ptr<ShootStrategy> create(const std::string& name, Random rng, const StrategyOptions& options);
+
+        // batched version of the strategy or nullptr when it has none
+        static BatchPolicy batchPolicy(const std::string& name);
+    };
+
+}
+
+#endif // !STRATEGY_FACTORY_H_
@@ -0,0 +1,89 @@
+#ifndef TOURNAMENT_H_
+#define TOURNAMENT_H_
+
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+#include "OpeningBook.h"
+#include "PlacementDistribution.h"
+
+#include <boost/program_options.hpp>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Runs many independent AI vs AI games on all cores and reports statistics and throughput.
+    // In the SPRT mode it plays pairs of games with swapped colours until the test decides whether
+    // the player is better than the opponent.
+    class Tournament
+    {
+    public:
+        Tournament(int argc, char** argv);
+
+        void run();
+
+    private:
+        int games_;
+        int max_rounds_;
+        int threads_;
+        int think_ms_;
+        int endgame_squares_;
+        // bounds and error rates of the SPRT mode
+        double elo0_;
+        double elo1_;
+        double alpha_;
+        double beta_;
+        std::shared_ptr<const MappedOpeningBook> opening_book_;
+        // trained placement of the main player's ships
+        std::shared_ptr<const PlacementDistribution> placement_;
+        std::string player_;
+        std::string opponent_;
+        // every game has its own seed derived from this one and the game's index
+        std::uint64_t seed_;
+
+        // games of a single lockstep batch
+        static const long LOCKSTEP_GAMES = 4096;
+        // pairs played between two checks of the test, the test is evaluated pair by pair in index order,
+        // so it stops at the same pair with any number of threads
+        static const long SPRT_BATCH_PAIRS = 4096;
+        // pairs a worker takes at once when games are not played in lockstep and when they are
+        static const long SPRT_PAIRS = 16;
+        static const long SPRT_LOCKSTEP_PAIRS = 256;
+
+        boost::program_options::options_description description_;
+        boost::program_options::variables_map used_options_;
+
+        void validateOptions();
+
+        // play the game with given index, the result depends only on seed_ and index
+        GameResult playGame(long index) const;
+        // the same game with the opponent's strategy moving first and the player's one second,
+        // seats keep their generators, so the strategies swap the layouts of the game with given index
+        GameResult playSwappedGame(long index) const;
+        GameResult playGame(long index, const std::string& main, const std::string& opponent, bool swapped) const;
+
+        // play games_ games on the pool, every worker keeps its own statistics merged after all games end
+        SimulationStats playGames(WorkStealingPool& pool, double& seconds) const;
+
+        // games per second for 1, 2, 4, ... threads up to threads_
+        void printScaling() const;
+
+        // pairs of games in batches on the pool until the test decides or games_ games are played
+        void runSprt(WorkStealingPool& pool) const;
+    };
+
+    #define TOURNAMENT_GAMES "games"
+    #define TOURNAMENT_THREADS "threads"
+    #define TOURNAMENT_SCALING "scaling"
+    #define TOURNAMENT_REPLAY "replay"
+    #define TOURNAMENT_SPRT "sprt"
+    #define TOURNAMENT_ELO0 "elo0"
+    #define TOURNAMENT_ELO1 "elo1"
+    #define TOURNAMENT_ALPHA "alpha"
+    #define TOURNAMENT_BETA "beta"
+
+}
+
+#endif // !TOURNAMENT_H_
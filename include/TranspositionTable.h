@@ -0,0 +1,46 @@
+#ifndef TRANSPOSITION_TABLE_H_
+#define TRANSPOSITION_TABLE_H_
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace battleship
+{
+
+    // Fixed-size table of values of solved states shared by threads without locks.
+    // Every entry keeps the value and the hash xored with it, so an entry written by two threads
+    // at once does not match either hash and is reported as missing instead of giving a wrong value.
+    // A new value always replaces the old one in its slot.
+    class TranspositionTable
+    {
+    public:
+        // number of entries is rounded down to a power of two
+        explicit TranspositionTable(std::size_t entries);
+
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+        std::size_t size() const;
+
+        // true and the stored value when the state with this hash was solved
+        bool probe(std::uint64_t hash, double& value) const;
+        void store(std::uint64_t hash, double value);
+
+        void clear();
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint64_t> check;
+            std::atomic<std::uint64_t> data;
+        };
+
+        std::unique_ptr<Entry[]> entries_;
+        std::size_t mask_;
+    };
+
+}
+
+#endif // !TRANSPOSITION_TABLE_H_
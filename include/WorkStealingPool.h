@@ -0,0 +1,62 @@
+#ifndef WORK_STEALING_POOL_H_
+#define WORK_STEALING_POOL_H_
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace battleship
+{
+
+    // Fixed set of worker threads, each with its own queue of work chunks.
+    // A worker takes chunks from the back of its own queue and, when it runs out of work,
+    // steals chunks from the front of the other workers' queues.
+    class WorkStealingPool
+    {
+    public:
+        // function called for every chunk, worker is the index of the thread running it
+        using Body = std::function<void(int worker, long begin, long end)>;
+
+        // threads <= 0 means one thread per hardware core
+        explicit WorkStealingPool(int threads = 0);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        int size() const;
+
+        // split [0, count) into chunks of at most grain elements, spread them evenly over the workers' queues
+        // and block until all chunks are processed. Must not be called concurrently.
+        void parallelFor(long count, long grain, const Body& body);
+
+    private:
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<std::pair<long, long>> chunks;
+        };
+
+        std::vector<std::thread> threads_;
+        std::vector<std::unique_ptr<Queue>> queues_;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        const Body* body_ = nullptr;
+        long generation_ = 0;
+        int active_ = 0;
+        bool stop_ = false;
+
+        void workerLoop(int worker);
+        bool popOrSteal(int worker, std::pair<long, long>& chunk);
+    };
+
+}
+
+#endif // !WORK_STEALING_POOL_H_
@@ -0,0 +1,51 @@
+#ifndef ZOBRIST_H_
+#define ZOBRIST_H_
+
+#include "GameState.h"
+#include "Bitboard.h"
+
+#include <cstdint>
+
+namespace battleship
+{
+
+    // Random keys of every part of GameState, the hash of a state is xor of keys of its parts.
+    // Shots and round changes update the hash by xoring keys of the parts they change only.
+    class Zobrist
+    {
+    public:
+        static const Zobrist& instance();
+
+        std::uint64_t hash(const GameState& s) const;
+
+        // hash of the state after s.apply(shot), s is the state before the shot
+        std::uint64_t afterShot(std::uint64_t hash, const GameState& s, Shot shot) const;
+        // hash of the state after s.endTurn()
+        std::uint64_t afterEndTurn(std::uint64_t hash, const GameState& s) const;
+        // hash of the state after s.nextRound()
+        std::uint64_t afterNextRound(std::uint64_t hash, const GameState& s) const;
+
+        // key distinguishing searches made for different sides of the same state
+        std::uint64_t side(int side) const;
+
+    private:
+        // the largest placement list is the one of double ship
+        static const int PLACEMENTS = 180;
+        // ship fires at most two shots in a round
+        static const int COUNTERS = 3;
+
+        std::uint64_t targeted_[2][Bitboard::SQUARES];
+        std::uint64_t fleet_[2][Ship::MAX_LENGTH][PLACEMENTS];
+        std::uint64_t shots_[2][Ship::MAX_LENGTH][COUNTERS];
+        std::uint64_t pausing_[2][Ship::MAX_LENGTH];
+        std::uint64_t round_[256];
+        std::uint64_t max_rounds_[256];
+        std::uint64_t turn_[2];
+        std::uint64_t side_[2];
+
+        Zobrist();
+    };
+
+}
+
+#endif // !ZOBRIST_H_
@@ -15,6 +15,9 @@ public:
     MOCK_METHOD1(chooseShipProxy, int(std::vector<int>* ships_lengths));
     MOCK_METHOD1(chooseSquareProxy, std::pair<int,int>(std::unordered_set<std::pair<int,int>, battleship::SquareHash>* squares));
 
+    using battleship::ShootStrategy::chooseShip;
+    using battleship::ShootStrategy::chooseSquare;
+
     // we cannot mock mehtod that take unique_ptr, thus we will delegate ptr to method that can take it
     int chooseShip(std::unique_ptr<std::vector<int>> ships_lengths) override;
     std::pair<int, int> chooseSquare(std::unique_ptr<std::unordered_set<std::pair<int,int>,
@@ -2,9 +2,6 @@
 #include "Grid.h"
 #include "exceptions.h"
 
-#include <random>
-#include <cassert>
-
 using std::unique_ptr;
 using std::vector;
 using std::array;
@@ -17,117 +14,48 @@ battleship::AIPlayer::AIPlayer(std::unique_ptr<battleship::ShootStrategy> strate
     , strategy_ptr_(move(strategy_ptr))
 { }
 
-void battleship::AIPlayer::setUpShips()
-{
-    enum Direction { UP, DOWN, LEFT, RIGHT };
-    std::random_device rd;
-
-    // triple
-    bool success = false;
-    int attempt = 0;
-    int fst;
-    int snd;
-    while (!success && attempt++ < MAX_ATTEMPTS)
-    {
-        fst = rd() % Grid::SIZE;
-        snd = rd() % Grid::SIZE;
-        auto v = Ship::makeVectorPtr({ {fst, snd} });
-
-        switch((Direction)(rd() % 4))
-        {
-        case UP:
-            v->push_back( {fst, snd - 1} );
-            v->push_back( {fst, snd - 2} );
-            break;
-        case DOWN:
-            v->push_back( {fst, snd + 1} );
-            v->push_back( {fst, snd + 2} );
-            break;
-        case LEFT:
-            v->push_back( {fst - 1, snd} );
-            v->push_back( {fst - 2, snd} );
-            break;
-        case RIGHT:
-            v->push_back( {fst + 1, snd} );
-            v->push_back( {fst + 2, snd} );
-            break;
-        default:
-            assert(false); // should not happen
-        }
-
-        try
-        {
-            primary_grid_.setShipLocation(move(v));
-            success = true;
-        }
-        catch (const InvalidCoordinateError&) { }
-        catch (const InvalidShipLocationError&) { }
-    }
-
-    // double
-    success = false;
-    attempt = 0;
-    while (!success && attempt++ < MAX_ATTEMPTS)
-    {
-        fst = rd() % Grid::SIZE;
-        snd = rd() % Grid::SIZE;
-        auto v = Ship::makeVectorPtr({ {fst, snd} });
-
-        switch((Direction)(rd() % 4))
-        {
-        case UP:    v->push_back( {fst, snd - 1} ); break;
-        case DOWN:  v->push_back( {fst, snd + 1} ); break;
-        case LEFT:  v->push_back( {fst - 1, snd} ); break;
-        case RIGHT: v->push_back( {fst + 1, snd} ); break;
-        default:
-            assert(false); // should not happen
-        }
+battleship::AIPlayer::AIPlayer(std::unique_ptr<battleship::ShootStrategy> strategy_ptr, Random rng)
+    : Player()
+    , strategy_ptr_(move(strategy_ptr))
+    , rng_(rng)
+{ }
 
-        try
-        {
-            primary_grid_.setShipLocation(move(v));
-            success = true;
-        }
-        catch (const InvalidCoordinateError&) { }
-        catch (const InvalidShipLocationError&) { }
-    }
+battleship::AIPlayer::AIPlayer(std::unique_ptr<battleship::ShootStrategy> strategy_ptr, Random rng,
+                               std::shared_ptr<const PlacementDistribution> placement)
+    : Player()
+    , strategy_ptr_(move(strategy_ptr))
+    , rng_(rng)
+    , placement_(move(placement))
+{ }
 
-    // single
-    success = false;
-    attempt = 0;
-    while (!success && attempt++ < MAX_ATTEMPTS)
-    {
-        fst = rd() % Grid::SIZE;
-        snd = rd() % Grid::SIZE;
-        auto v = Ship::makeVectorPtr({ {fst, snd} });
+void battleship::AIPlayer::setUpShips()
+{
+    if (placement_)
+        placeFleet(placement_->sample(rng_));
+    else
+        placeRandomFleet(rng_);
+}
 
-        try
-        {
-            primary_grid_.setShipLocation(move(v));
-            success = true;
-        }
-        catch (const InvalidCoordinateError&) { }
-        catch (const InvalidShipLocationError&) { }
-    }
+const battleship::ShootStrategy& battleship::AIPlayer::getStrategy() const
+{
+    return *strategy_ptr_;
 }
 
 std::pair<int, int> battleship::AIPlayer::shoot()
 {
-    auto v = make_unique<vector<int>>();
+    ShipsLengths lengths;
 
     for (auto& s : primary_grid_.getAllShips())
     {
         if (s.getLength() == 0)
             throw BattleshipLogicError("AIPlayer::shoot: cannot shoot before setting ships locations.");
-        if (s.canShoot() && !(secondary_grid_.getAvailableRange(s)->empty()))
-            v->push_back(s.getLength());
+        if (s.canShoot() && !getUntargetedMask(s).empty())
+            lengths.push_back(s.getLength());
     }
 
-    int length = strategy_ptr_->chooseShip(move(v));
+    int length = strategy_ptr_->chooseShip(lengths, *this);
     primary_grid_.shoot(length);
     auto& s = primary_grid_.getShip(length);
 
-
-
-    return strategy_ptr_->chooseSquare(move(secondary_grid_.getAvailableRange(s)));
+    return strategy_ptr_->chooseSquare(SquareSet(getUntargetedMask(s)), *this);
 }
@@ -0,0 +1,219 @@
+#include "AutosaveWriter.h"
+#include "exceptions.h"
+
+#include <algorithm>
+#include <cstdio>
+#ifdef _WIN32
+// std::min and std::max are used below
+#define NOMINMAX
+#include <windows.h>
+#else
+// Assume POSIX
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::string;
+
+namespace
+{
+#ifdef _WIN32
+    // the file is created or truncated, all its bytes are flushed to the disk before it is closed
+    bool writeDurably(const string& path, const string& content)
+    {
+        const HANDLE file = ::CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        const char* p = content.data();
+        std::size_t left = content.size();
+        bool ok = true;
+        while (ok && left > 0)
+        {
+            DWORD n = 0;
+            const DWORD chunk = static_cast<DWORD>(std::min<std::size_t>(left, 1 << 30));
+            ok = ::WriteFile(file, p, chunk, &n, nullptr) && n > 0;
+            p += n;
+            left -= n;
+        }
+        ok = ok && ::FlushFileBuffers(file);
+        return ::CloseHandle(file) && ok;
+    }
+
+    // the rename is written through, so it is durable when the call returns
+    bool replaceFile(const string& from, const string& to)
+    {
+        return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    }
+#else
+    // all bytes, write can stop in the middle
+    bool writeAll(int fd, const string& content)
+    {
+        const char* p = content.data();
+        std::size_t left = content.size();
+        while (left > 0)
+        {
+            const auto n = ::write(fd, p, left);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return false;
+            p += n;
+            left -= n;
+        }
+        return true;
+    }
+
+    // the file is created or truncated, all its bytes are synced to the disk before it is closed
+    bool writeDurably(const string& path, const string& content)
+    {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+        const bool ok = writeAll(fd, content) && ::fsync(fd) == 0;
+        return ::close(fd) == 0 && ok;
+    }
+
+    // directory entry of the renamed file is durable only after its directory is synced
+    bool replaceFile(const string& from, const string& to)
+    {
+        if (std::rename(from.c_str(), to.c_str()) != 0)
+            return false;
+
+        const auto slash = to.find_last_of('/');
+        const string dir = slash == string::npos ? "." : slash == 0 ? "/" : to.substr(0, slash);
+        const int fd = ::open(dir.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            ::fsync(fd);
+            ::close(fd);
+        }
+        return true;
+    }
+#endif
+}
+
+
+battleship::AutosaveWriter::AutosaveWriter(std::size_t capacity)
+    : capacity_(std::max<std::size_t>(1, capacity))
+    , thread_(&AutosaveWriter::writerLoop, this)
+{
+}
+
+battleship::AutosaveWriter::~AutosaveWriter()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+std::shared_ptr<battleship::AutosaveWriter> battleship::AutosaveWriter::shared()
+{
+    static const auto writer = std::make_shared<AutosaveWriter>();
+    return writer;
+}
+
+void battleship::AutosaveWriter::submit(const std::string& path, std::string content)
+{
+    {
+        unique_lock<mutex> lock(mutex_);
+        stats_.submitted++;
+        const auto waiting = [&] { return std::find_if(queue_.begin(), queue_.end(),
+                                                       [&](const Save& s) { return s.path == path; }); };
+        auto it = waiting();
+        if (it == queue_.end() && queue_.size() >= capacity_)
+        {
+            stats_.waited++;
+            space_.wait(lock, [this] { return queue_.size() < capacity_; });
+            it = waiting();
+        }
+        if (it != queue_.end())
+        {
+            it->content = std::move(content);
+            stats_.coalesced++;
+            return;
+        }
+        queue_.push_back({ path, std::move(content) });
+    }
+    wake_.notify_one();
+}
+
+void battleship::AutosaveWriter::flush()
+{
+    unique_lock<mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && !writing_; });
+}
+
+void battleship::AutosaveWriter::flush(const std::string& path)
+{
+    unique_lock<mutex> lock(mutex_);
+    idle_.wait(lock, [&]
+    {
+        return !(writing_ && writing_path_ == path)
+               && std::none_of(queue_.begin(), queue_.end(), [&](const Save& s) { return s.path == path; });
+    });
+}
+
+battleship::AutosaveWriter::Stats battleship::AutosaveWriter::getStats() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return stats_;
+}
+
+void battleship::AutosaveWriter::writeFile(const std::string& path, const std::string& content)
+{
+    const string temp = path + ".tmp";
+    if (!writeDurably(temp, content) || !replaceFile(temp, path))
+    {
+        std::remove(temp.c_str());
+        throw BattleshipRuntimeError("AutosaveWriter::writeFile: cannot write file '" + path + "'.");
+    }
+}
+
+void battleship::AutosaveWriter::writerLoop()
+{
+    while (true)
+    {
+        Save save;
+        {
+            unique_lock<mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+            // waiting saves are written before stopping
+            if (queue_.empty())
+                return;
+            save = std::move(queue_.front());
+            queue_.pop_front();
+            writing_ = true;
+            writing_path_ = save.path;
+        }
+        space_.notify_one();
+
+        bool written = true;
+        try
+        {
+            writeFile(save.path, save.content);
+        }
+        catch (const BattleshipRuntimeError&)
+        {
+            written = false;
+        }
+
+        {
+            lock_guard<mutex> lock(mutex_);
+            writing_ = false;
+            if (written)
+                stats_.written++;
+            else
+                stats_.failed++;
+        }
+        idle_.notify_all();
+    }
+}
@@ -0,0 +1,35 @@
+#include "Bitboard.h"
+
+#include <algorithm>
+
+using std::uint64_t;
+
+constexpr uint64_t battleship::Bitboard::HIGH_MASK;
+constexpr uint64_t battleship::Bitboard::FIRST_COLUMN_LOW;
+constexpr uint64_t battleship::Bitboard::FIRST_COLUMN_HIGH;
+constexpr uint64_t battleship::Bitboard::LAST_COLUMN_LOW;
+constexpr uint64_t battleship::Bitboard::LAST_COLUMN_HIGH;
+
+battleship::Bitboard battleship::Bitboard::rectangle(int first_min, int second_min, int first_max, int second_max)
+{
+    first_min = std::max(first_min, 0);
+    second_min = std::max(second_min, 0);
+    first_max = std::min(first_max, SIZE - 1);
+    second_max = std::min(second_max, SIZE - 1);
+
+    if (first_min > first_max || second_min > second_max)
+        return Bitboard();
+
+    // bits of a single row, then copied to every row of the rectangle
+    const uint64_t row = ((uint64_t(1) << (second_max + 1)) - 1) & ~((uint64_t(1) << second_min) - 1);
+    Bitboard r;
+    Bitboard line(row, 0);
+    for (int a = 0; a < first_min; ++a)
+        line = line.shiftFirstUp();
+    for (int a = first_min; a <= first_max; ++a)
+    {
+        r |= line;
+        line = line.shiftFirstUp();
+    }
+    return r;
+}
@@ -0,0 +1,88 @@
+#include "ConsistentLayouts.h"
+
+using Placement = battleship::FleetLayouts::Placement;
+
+
+battleship::ConsistentLayouts::Tables::Tables()
+{
+    const auto& layouts = FleetLayouts::instance();
+    const auto& doubles = layouts.getPlacements(2);
+    for (auto& t : layouts.getPlacements(3))
+    {
+        DoublesSet s;
+        for (int j = 0; j < (int)doubles.size(); j++)
+            if ((doubles[j].mask & t.neighbourhood).empty())
+                s.set(j);
+        legal_with_triple.push_back(s);
+    }
+    for (int j = 0; j < (int)doubles.size(); j++)
+    {
+        for (auto b = doubles[j].mask; !b.empty(); )
+            covering[b.popLowest()].set(j);
+        for (auto b = doubles[j].neighbourhood; !b.empty(); )
+            touching[b.popLowest()].set(j);
+    }
+}
+
+const battleship::ConsistentLayouts::Tables& battleship::ConsistentLayouts::Tables::instance()
+{
+    static const Tables tables;
+    return tables;
+}
+
+battleship::ConsistentLayouts::ConsistentLayouts(const Grid& shots)
+    : hit_(shots.getPlane(ST_HIT))
+    , miss_(shots.getPlane(ST_MISS))
+    , sunk_(shots.getPlane(ST_SUNK))
+{
+    static_assert(Ship::MAX_LENGTH == 3, "layouts are grouped for three ships");
+
+    // ships do not touch, so every group of touching sunk squares is a whole ship
+    for (Bitboard remaining = sunk_; !remaining.empty(); )
+    {
+        Bitboard ship = Bitboard::fromIndex(remaining.lowest());
+        for (Bitboard grown = ship.dilate() & sunk_; grown != ship; grown = ship.dilate() & sunk_)
+            ship = grown;
+        remaining &= ~ship;
+
+        const int length = ship.count();
+        if (length > Ship::MAX_LENGTH || is_sunk_[length - 1])
+        {
+            possible_ = false;
+            return;
+        }
+        sunk_ships_[length - 1] = ship;
+        is_sunk_[length - 1] = true;
+    }
+
+    const auto& doubles = FleetLayouts::instance().getPlacements(2);
+    for (int j = 0; j < (int)doubles.size(); j++)
+        if (fits(doubles[j]))
+            fitting_doubles_.set(j);
+
+    // hit single ship would be sunk, so it cannot touch any hit square
+    singles_ = is_sunk_[0] ? sunk_ships_[0] : ~(hit_ | sunk_).dilate() & ~miss_;
+}
+
+bool battleship::ConsistentLayouts::isPossible() const
+{
+    return possible_;
+}
+
+bool battleship::ConsistentLayouts::isSunk(int length) const
+{
+    return is_sunk_[length - 1];
+}
+
+const battleship::DoublesSet& battleship::ConsistentLayouts::touching(int square)
+{
+    return Tables::instance().touching[square];
+}
+
+bool battleship::ConsistentLayouts::fits(const Placement& p) const
+{
+    return is_sunk_[p.length - 1]
+            ? p.mask == sunk_ships_[p.length - 1]
+            : (p.mask & (miss_ | sunk_)).empty() && (p.neighbourhood & ~p.mask & (hit_ | sunk_)).empty()
+                    && !(p.mask & ~hit_).empty();
+}
@@ -0,0 +1,180 @@
+#include "DensityStrategy.h"
+#include "FleetLayouts.h"
+#include "ConsistentLayouts.h"
+#include "Player.h"
+#include "exceptions.h"
+
+using std::unique_ptr;
+using std::vector;
+using std::pair;
+using std::array;
+using std::unordered_set;
+using std::uint32_t;
+
+
+battleship::DensityStrategy::DensityStrategy(Random rng)
+    : rng_(rng)
+{ }
+
+battleship::DensityStrategy::Density battleship::DensityStrategy::countLayouts(const Grid& shots)
+{
+    static_assert(Ship::MAX_LENGTH == 3, "layouts are counted for three ships");
+
+    // the first shot of every game is chosen on the empty grid, so its density is counted once
+    if (shots.getPlane(ST_EMPTY) == Bitboard::full())
+    {
+        static const Density initial = countUncached(Grid());
+        return initial;
+    }
+    return countUncached(shots);
+}
+
+battleship::DensityStrategy::Density battleship::DensityStrategy::countUncached(const Grid& shots)
+{
+    Density d;
+    d.counts.fill(0);
+    d.layouts = 0;
+
+    const ConsistentLayouts consistent(shots);
+    const auto empty = shots.getPlane(ST_EMPTY);
+    const auto& layouts = FleetLayouts::instance();
+    const auto& triples = layouts.getPlacements(3);
+    const auto& doubles = layouts.getPlacements(2);
+
+    // single ship is counted as a set of squares for every pair of other ships
+    // layouts are summed for every placement first, so squares of ships are visited once per placement
+    array<std::uint64_t, 2 * Bitboard::SQUARES> double_layouts {};
+    array<std::uint64_t, Bitboard::SQUARES> single_layouts {};
+    consistent.forEachTriple([&](int i, const DoublesSet& valid, Bitboard t_singles)
+    {
+        std::uint64_t t_layouts = 0;
+        valid.forEach([&](int j)
+        {
+            const std::uint64_t n = (t_singles & ~doubles[j].neighbourhood).count();
+            t_layouts += n;
+            double_layouts[j] += n;
+        });
+        d.layouts += t_layouts;
+        for (auto b = triples[i].mask & empty; !b.empty(); )
+            d.counts[b.popLowest()] += t_layouts;
+
+        // single ship on the square fits every valid double except the ones touching it
+        if (!consistent.isSunk(1))
+        {
+            const std::uint64_t v = valid.count();
+            for (auto b = t_singles; !b.empty(); )
+            {
+                const int q = b.popLowest();
+                single_layouts[q] += v - (valid & ConsistentLayouts::touching(q)).count();
+            }
+        }
+    });
+
+    for (int j = 0; j < (int)doubles.size(); j++)
+        for (auto b = doubles[j].mask & empty; !b.empty(); )
+            d.counts[b.popLowest()] += double_layouts[j];
+    for (int q = 0; q < Bitboard::SQUARES; q++)
+        d.counts[q] += single_layouts[q];
+
+    return d;
+}
+
+int battleship::DensityStrategy::chooseShip(unique_ptr<vector<int>> ships_lengths)
+{
+    ShipsLengths l;
+    for (auto x : *ships_lengths)
+        l.push_back(x);
+    return chooseShip(l);
+}
+
+pair<int,int> battleship::DensityStrategy::chooseSquare(unique_ptr<unordered_set<pair<int,int>, SquareHash>> squares)
+{
+    SquareSet s;
+    for (auto& x : *squares)
+        s.insert(x);
+    return chooseSquare(s);
+}
+
+int battleship::DensityStrategy::chooseShip(const ShipsLengths& ships_lengths)
+{
+    if (ships_lengths.empty())
+        throw BattleshipRuntimeError("DensityStrategy::chooseShip: no ship to choose.");
+    return ships_lengths[rng_.below(ships_lengths.size())];
+}
+
+pair<int,int> battleship::DensityStrategy::chooseSquare(const SquareSet& squares)
+{
+    if (squares.empty())
+        throw BattleshipRuntimeError("DensityStrategy::chooseSquare: no square to choose.");
+    return squares.nth(rng_.below(squares.size()));
+}
+
+int battleship::DensityStrategy::chooseShip(const ShipsLengths& ships_lengths, const Player& player)
+{
+    if (ships_lengths.empty())
+        throw BattleshipRuntimeError("DensityStrategy::chooseShip: no ship to choose.");
+
+    // ship which can reach the best square, longer ship when there are more of them
+    getDensity(player.getSecondaryGrid());
+    int best_length = 0;
+    uint32_t best_count = 0;
+    for (auto l : ships_lengths)
+    {
+        uint32_t count = 0;
+        bestSquare(SquareSet(player.getUntargetedMask(player.getPrimaryGird().getShip(l))), count);
+        if (best_length == 0 || count > best_count || (count == best_count && l > best_length))
+        {
+            best_length = l;
+            best_count = count;
+        }
+    }
+    return best_length;
+}
+
+pair<int,int> battleship::DensityStrategy::chooseSquare(const SquareSet& squares, const Player& player)
+{
+    if (squares.empty())
+        throw BattleshipRuntimeError("DensityStrategy::chooseSquare: no square to choose.");
+
+    getDensity(player.getSecondaryGrid());
+    uint32_t count = 0;
+    return bestSquare(squares, count);
+}
+
+const battleship::DensityStrategy::Density& battleship::DensityStrategy::getDensity(const Grid& shots)
+{
+    const auto hit = shots.getPlane(ST_HIT);
+    const auto miss = shots.getPlane(ST_MISS);
+    const auto sunk = shots.getPlane(ST_SUNK);
+    if (!counted_ || hit != counted_hit_ || miss != counted_miss_ || sunk != counted_sunk_)
+    {
+        density_ = countLayouts(shots);
+        counted_hit_ = hit;
+        counted_miss_ = miss;
+        counted_sunk_ = sunk;
+        counted_ = true;
+    }
+    return density_;
+}
+
+pair<int,int> battleship::DensityStrategy::bestSquare(const SquareSet& squares, uint32_t& best_count)
+{
+    // reservoir sampling among squares with the highest count
+    best_count = 0;
+    int best = -1;
+    int ties = 0;
+    for (auto b = squares.getMask(); !b.empty(); )
+    {
+        const int i = b.popLowest();
+        const auto c = density_.counts[i];
+        if (best == -1 || c > best_count)
+        {
+            best = i;
+            best_count = c;
+            ties = 1;
+        }
+        else if (c == best_count && rng_.below(++ties) == 0)
+            best = i;
+    }
+    return Bitboard::toSquare(best);
+}
@@ -0,0 +1,141 @@
+#include "EndgameSolver.h"
+#include "Zobrist.h"
+#include "Simulation.h"
+
+#include <algorithm>
+
+namespace
+{
+    // nodes visited between checks of the clock
+    const long DEADLINE_CHECK_NODES = 1024;
+}
+
+
+battleship::EndgameSolver::EndgameSolver(TranspositionTable& table, int side)
+    : table_(table)
+    , side_(side)
+{ }
+
+int battleship::EndgameSolver::remainingSquares(const GameState& state)
+{
+    int n = 0;
+    for (int side = 0; side < 2; side++)
+    {
+        Bitboard squares;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            if (!state.isSunk(side, l))
+                squares |= state.getUntargeted(side, l);
+        n += squares.count();
+    }
+    return n;
+}
+
+double battleship::EndgameSolver::solve(const GameState& state)
+{
+    const auto& zobrist = Zobrist::instance();
+    aborted_ = false;
+    return search(state, zobrist.hash(state) ^ zobrist.side(side_));
+}
+
+void battleship::EndgameSolver::setDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    deadline_ = deadline;
+}
+
+bool battleship::EndgameSolver::isAborted() const
+{
+    return aborted_;
+}
+
+long battleship::EndgameSolver::getNodes() const
+{
+    return nodes_;
+}
+
+double battleship::EndgameSolver::search(GameState s, std::uint64_t hash)
+{
+    const auto& zobrist = Zobrist::instance();
+    if (aborted_ || (nodes_ % DEADLINE_CHECK_NODES == 0 && std::chrono::steady_clock::now() >= deadline_))
+    {
+        aborted_ = true;
+        return 0.0;
+    }
+    nodes_++;
+
+    const auto result = [&](GameOutcome outcome)
+    {
+        const double value = (outcome == GO_WIN ? 1.0 : (outcome == GO_DRAW ? 0.5 : 0.0))
+                             + 0.01 * (s.getHits(1) - s.getHits(0));
+        return side_ == 0 ? value : 1.0 - value;
+    };
+
+    // turns without shots are passed in the same way as in rollouts until someone can shoot
+    while (!s.canShoot(s.turn))
+    {
+        if (s.turn == 0)
+        {
+            hash = zobrist.afterEndTurn(hash, s);
+            s.endTurn();
+            if (!s.canShoot(1) && !s.mayShootNextRounds(1))
+                return result(GO_WIN);
+        }
+        else
+        {
+            hash = zobrist.afterNextRound(hash, s);
+            s.nextRound();
+            if (s.round >= s.max_rounds)
+            {
+                const int main_hits = s.getHits(0);
+                const int opponent_hits = s.getHits(1);
+                return result(main_hits == opponent_hits ? GO_DRAW : (main_hits < opponent_hits ? GO_WIN : GO_LOSS));
+            }
+            if (!s.canShoot(0) && !s.mayShootNextRounds(0))
+                return result(GO_LOSS);
+        }
+    }
+
+    double value;
+    if (table_.probe(hash, value))
+        return value;
+
+    const auto child = [&](Shot shot)
+    {
+        GameState c = s;
+        const auto h = zobrist.afterShot(hash, s, shot);
+        c.apply(shot);
+        return search(c, h);
+    };
+
+    if (s.turn == side_)
+    {
+        // the best shot
+        value = -1.0;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            if (s.canShoot(s.turn, l))
+                for (auto b = s.getUntargeted(s.turn, l); !b.empty(); )
+                    value = std::max(value, child({ l, b.popLowest() }));
+    }
+    else
+    {
+        // random ship, then random square in its range
+        int ships = 0;
+        value = 0.0;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            if (s.canShoot(s.turn, l))
+            {
+                const auto squares = s.getUntargeted(s.turn, l);
+                double sum = 0.0;
+                for (auto b = squares; !b.empty(); )
+                    sum += child({ l, b.popLowest() });
+                value += sum / squares.count();
+                ships++;
+            }
+        value /= ships;
+    }
+
+    // values of unfinished subtrees are not stored
+    if (aborted_)
+        return 0.0;
+    table_.store(hash, value);
+    return value;
+}
@@ -0,0 +1,103 @@
+#include "FleetLayouts.h"
+#include "exceptions.h"
+
+#include <algorithm>
+
+using std::vector;
+using std::uint32_t;
+
+
+battleship::FleetLayouts::FleetLayouts()
+{
+    static_assert(Ship::MAX_LENGTH == 3, "layouts are packed for three ships");
+
+    for (int length = 1; length <= Ship::MAX_LENGTH; length++)
+    {
+        auto& v = placements_[length - 1];
+        // horizontal ships, then vertical ones, single ship only once
+        for (int vertical = 0; vertical < (length > 1 ? 2 : 1); vertical++)
+            for (int a = 0; a < Bitboard::SIZE; a++)
+                for (int b = 0; b + length <= Bitboard::SIZE; b++)
+                {
+                    Placement p;
+                    p.length = length;
+                    for (int i = 0; i < length; i++)
+                    {
+                        p.squares[i] = vertical ? std::make_pair(b + i, a) : std::make_pair(a, b + i);
+                        p.mask.set(p.squares[i]);
+                    }
+                    p.neighbourhood = p.mask.dilate();
+                    const int range = Ship::RANGES[length];
+                    p.range = Bitboard::rectangle(p.squares[0].first - range, p.squares[0].second - range,
+                            p.squares[length - 1].first + range, p.squares[length - 1].second + range);
+                    v.push_back(p);
+                }
+    }
+
+    const auto& singles = placements_[0];
+    const auto& doubles = placements_[1];
+    const auto& triples = placements_[2];
+    for (int t = 0; t < (int)triples.size(); t++)
+        for (int d = 0; d < (int)doubles.size(); d++)
+        {
+            if (!(triples[t].neighbourhood & doubles[d].mask).empty())
+                continue;
+            const auto taken = triples[t].neighbourhood | doubles[d].neighbourhood;
+            for (int s = 0; s < (int)singles.size(); s++)
+                if (!taken.test(singles[s].squares[0]))
+                    layouts_.push_back(pack({{ s, d, t }}));
+        }
+}
+
+std::size_t battleship::FleetLayouts::size() const
+{
+    return layouts_.size();
+}
+
+battleship::FleetLayouts::Layout battleship::FleetLayouts::at(std::size_t index) const
+{
+    return unpack(layouts_.at(index));
+}
+
+long battleship::FleetLayouts::indexOf(const Layout& layout) const
+{
+    for (int i = 0; i < Ship::MAX_LENGTH; i++)
+        if (layout[i] < 0 || layout[i] >= (int)placements_[i].size())
+            return -1;
+
+    const auto code = pack(layout);
+    auto it = std::lower_bound(layouts_.begin(), layouts_.end(), code);
+    return (it != layouts_.end() && *it == code) ? it - layouts_.begin() : -1;
+}
+
+int battleship::FleetLayouts::placementIndex(int length, Bitboard mask) const
+{
+    const auto& v = getPlacements(length);
+    for (int i = 0; i < (int)v.size(); i++)
+        if (v[i].mask == mask)
+            return i;
+    return -1;
+}
+
+battleship::FleetLayouts::Layout battleship::FleetLayouts::sample(Random& rng) const
+{
+    return unpack(layouts_[rng.below(layouts_.size())]);
+}
+
+battleship::Bitboard battleship::FleetLayouts::getMask(const Layout& layout) const
+{
+    Bitboard r;
+    for (int i = 0; i < Ship::MAX_LENGTH; i++)
+        r |= placements_[i][layout[i]].mask;
+    return r;
+}
+
+uint32_t battleship::FleetLayouts::pack(const Layout& layout)
+{
+    return layout[0] | layout[1] << 8 | layout[2] << 16;
+}
+
+battleship::FleetLayouts::Layout battleship::FleetLayouts::unpack(uint32_t code)
+{
+    return {{ (int)(code & 0xff), (int)((code >> 8) & 0xff), (int)(code >> 16) }};
+}
@@ -0,0 +1,354 @@
+#include "GameJournal.h"
+#include "FleetLayouts.h"
+#include "exceptions.h"
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace bip = boost::interprocess;
+namespace fs = boost::filesystem;
+using std::string;
+using std::vector;
+using std::size_t;
+
+const std::uint32_t battleship::GameJournal::MAGIC;
+const std::uint32_t battleship::GameJournal::VERSION;
+
+namespace
+{
+    battleship::GameJournal::Record record(battleship::GameJournal::RecordType type, int player, int ship,
+                                           int index, int result, int round)
+    {
+        battleship::GameJournal::Record r {};
+        r.type = type;
+        r.player = player;
+        r.ship = ship;
+        r.index = index;
+        r.result = result;
+        r.round = round;
+        return r;
+    }
+
+    battleship::ShotResult toResult(battleship::SquareType type)
+    {
+        if (type == battleship::ST_HIT)
+            return battleship::SR_HIT;
+        if (type == battleship::ST_SUNK)
+            return battleship::SR_SUNK;
+        return battleship::SR_MISS;
+    }
+
+    [[noreturn]] void broken(size_t record, const string& reason)
+    {
+        throw battleship::BattleshipRuntimeError("MappedGameJournal: record " + std::to_string(record) + ' ' + reason + '.');
+    }
+}
+
+
+battleship::GameJournal::Header battleship::GameJournal::makeHeader(int max_rounds, std::uint64_t seed,
+                                                                    const std::string& main_type,
+                                                                    const std::string& opponent_type)
+{
+    if (main_type.size() >= TYPE_LENGTH || opponent_type.size() >= TYPE_LENGTH)
+        throw BattleshipLogicError("GameJournal::makeHeader: player type name too long.");
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.max_rounds = max_rounds;
+    h.seed = seed;
+    h.created_at = std::time(nullptr);
+    std::memcpy(h.types[0], main_type.data(), main_type.size());
+    std::memcpy(h.types[1], opponent_type.data(), opponent_type.size());
+    return h;
+}
+
+bool battleship::GameJournal::isJournalFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios_base::binary);
+    std::uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return file && magic == MAGIC;
+}
+
+vector<battleship::GameJournal::Record> battleship::GameJournal::stateRecords(const GameState& state)
+{
+    vector<Record> records;
+    for (int side = 0; side < 2; side++)
+    {
+        const auto& s = state.sides[side];
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            records.push_back(record(JR_PLACEMENT, side, l, s.fleet[l - 1], 0, state.round));
+
+        const auto grid = state.getSecondaryGrid(side);
+        for (auto targeted = state.getTargeted(side); !targeted.empty(); )
+        {
+            const int q = targeted.popLowest();
+            records.push_back(record(JR_TARGET, side, 0, q, toResult(grid.at(Bitboard::toSquare(q))), state.round));
+        }
+
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            if (s.pausing & (1 << (l - 1)))
+                records.push_back(record(JR_PAUSE, side, l, 0, 0, state.round));
+    }
+    return records;
+}
+
+battleship::GameJournalWriter::GameJournalWriter(const std::string& path, const GameJournal::Header& header,
+                                                 const GameState& state)
+    : path_(path)
+{
+    file_.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        file_.open(path, std::ios_base::binary | std::ios_base::trunc);
+        auto h = header;
+        h.first_round = state.round;
+        file_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        const auto records = GameJournal::stateRecords(state);
+        file_.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(GameJournal::Record));
+        file_.flush();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("GameJournalWriter: cannot write file '" + path + "'.");
+    }
+}
+
+battleship::GameJournalWriter::GameJournalWriter(const std::string& path)
+    : path_(path)
+{
+    // the mapping has to be closed before the file is cut
+    size_t size = 0;
+    {
+        MappedGameJournal journal(path);
+        size = journal.finishedSize();
+    }
+
+    file_.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        fs::resize_file(path, size);
+        file_.open(path, std::ios_base::binary | std::ios_base::app);
+    }
+    catch (const fs::filesystem_error&)
+    {
+        throw BattleshipRuntimeError("GameJournalWriter: cannot write file '" + path + "'.");
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("GameJournalWriter: cannot write file '" + path + "'.");
+    }
+}
+
+void battleship::GameJournalWriter::shot(int player, Shot shot, ShotResult result, int round)
+{
+    write(record(GameJournal::JR_SHOT, player, shot.ship_length, shot.square, result, round));
+}
+
+void battleship::GameJournalWriter::endRound(int finished_rounds)
+{
+    write(record(GameJournal::JR_ROUND, 0, 0, 0, 0, finished_rounds));
+    try
+    {
+        file_.flush();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("GameJournalWriter: cannot write file '" + path_ + "'.");
+    }
+}
+
+void battleship::GameJournalWriter::write(const GameJournal::Record& record)
+{
+    try
+    {
+        file_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("GameJournalWriter: cannot write file '" + path_ + "'.");
+    }
+}
+
+battleship::MappedGameJournal::MappedGameJournal(const std::string& path)
+{
+    try
+    {
+        file_ = bip::file_mapping(path.c_str(), bip::read_only);
+        region_ = bip::mapped_region(file_, bip::read_only);
+    }
+    catch (const bip::interprocess_exception&)
+    {
+        throw BattleshipRuntimeError("MappedGameJournal: cannot map file '" + path + "'.");
+    }
+
+    if (region_.get_size() < sizeof(GameJournal::Header) || header().magic != GameJournal::MAGIC)
+        throw BattleshipRuntimeError("MappedGameJournal: file '" + path + "' is not a game journal.");
+    if (header().version != GameJournal::VERSION)
+        throw BattleshipRuntimeError("MappedGameJournal: unsupported journal version in file '" + path + "'.");
+    size_ = (region_.get_size() - sizeof(GameJournal::Header)) / sizeof(GameJournal::Record);
+
+    // records of the starting state come first, then every round ends with its record
+    size_t i = 0;
+    while (i < size_ && records()[i].type >= GameJournal::JR_PLACEMENT && records()[i].type <= GameJournal::JR_PAUSE)
+        i++;
+    rounds_.push_back(i);
+    for (; i < size_; i++)
+    {
+        if (records()[i].type == GameJournal::JR_ROUND)
+            rounds_.push_back(i + 1);
+        else if (records()[i].type != GameJournal::JR_SHOT)
+            throw BattleshipRuntimeError("MappedGameJournal: file '" + path + "' has a record of unknown type.");
+    }
+}
+
+const battleship::GameJournal::Header& battleship::MappedGameJournal::header() const
+{
+    // region is page aligned, so it is aligned enough for the header
+    return *static_cast<const GameJournal::Header*>(region_.get_address());
+}
+
+std::string battleship::MappedGameJournal::getType(int player) const
+{
+    const auto& t = header().types[player];
+    return string(t, strnlen(t, GameJournal::TYPE_LENGTH));
+}
+
+size_t battleship::MappedGameJournal::size() const
+{
+    return size_;
+}
+
+const battleship::GameJournal::Record& battleship::MappedGameJournal::at(std::size_t record) const
+{
+    if (record >= size_)
+        throw BattleshipRuntimeError("MappedGameJournal::at: record out of range.");
+    return records()[record];
+}
+
+int battleship::MappedGameJournal::firstRound() const
+{
+    return header().first_round;
+}
+
+int battleship::MappedGameJournal::lastRound() const
+{
+    return firstRound() + static_cast<int>(rounds_.size()) - 1;
+}
+
+size_t battleship::MappedGameJournal::roundEnd(int round) const
+{
+    if (round < firstRound() || round > lastRound())
+        throw BattleshipRuntimeError("MappedGameJournal::roundEnd: round " + std::to_string(round) + " is not in the journal.");
+    return rounds_[round - firstRound()];
+}
+
+size_t battleship::MappedGameJournal::finishedSize() const
+{
+    return sizeof(GameJournal::Header) + rounds_.back() * sizeof(GameJournal::Record);
+}
+
+battleship::GameState battleship::MappedGameJournal::stateAt(int round) const
+{
+    return replay(roundEnd(round));
+}
+
+battleship::GameState battleship::MappedGameJournal::replay(std::size_t count) const
+{
+    if (count > size_)
+        throw BattleshipRuntimeError("MappedGameJournal::replay: journal has fewer records.");
+    if (firstRound() < 0 || firstRound() > header().max_rounds || header().max_rounds > 0xFF)
+        throw BattleshipRuntimeError("MappedGameJournal::replay: wrong rounds in the header.");
+
+    const auto& layouts = FleetLayouts::instance();
+    GameState s {};
+    s.round = firstRound();
+    s.max_rounds = header().max_rounds;
+
+    // starting state, the results of targets are checked when all of them are known
+    const auto* r = records();
+    int placed[2] = { 0, 0 };
+    const size_t start = rounds_.front();
+    for (size_t i = 0; i < start && i < count; i++)
+    {
+        if (r[i].player > 1)
+            broken(i, "has wrong player");
+        auto& side = s.sides[r[i].player];
+        if (r[i].type == GameJournal::JR_TARGET)
+        {
+            if (r[i].index >= Bitboard::SQUARES)
+                broken(i, "has wrong square");
+            side.targeted[r[i].index / 64] |= std::uint64_t(1) << (r[i].index % 64);
+            continue;
+        }
+
+        if (r[i].ship < 1 || r[i].ship > Ship::MAX_LENGTH)
+            broken(i, "has wrong ship");
+        if (r[i].type == GameJournal::JR_PAUSE)
+            side.pausing |= 1 << (r[i].ship - 1);
+        else
+        {
+            if (r[i].index >= layouts.getPlacements(r[i].ship).size())
+                broken(i, "has wrong placement");
+            side.fleet[r[i].ship - 1] = r[i].index;
+            placed[r[i].player] |= 1 << (r[i].ship - 1);
+        }
+    }
+
+    const int fleet = (1 << Ship::MAX_LENGTH) - 1;
+    if (placed[0] != fleet || placed[1] != fleet)
+        broken(std::min(start, count), "comes before all ships are placed");
+    for (int side = 0; side < 2; side++)
+    {
+        FleetLayouts::Layout layout;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            layout[l - 1] = s.sides[side].fleet[l - 1];
+        if (layouts.indexOf(layout) < 0)
+            broken(0, "starts an illegal fleet");
+    }
+    for (size_t i = 0; i < start && i < count; i++)
+        if (r[i].type == GameJournal::JR_TARGET)
+        {
+            const auto grid = s.getSecondaryGrid(r[i].player);
+            if (toResult(grid.at(Bitboard::toSquare(r[i].index))) != r[i].result)
+                broken(i, "has wrong result");
+        }
+
+    // rounds are replayed with the rules of the game, so a journal which breaks them is not accepted
+    for (size_t i = start; i < count; i++)
+    {
+        if (r[i].type == GameJournal::JR_ROUND)
+        {
+            if (r[i].round != s.round + 1 || s.round >= s.max_rounds)
+                broken(i, "ends wrong round");
+            s.nextRound();
+            continue;
+        }
+
+        const int player = r[i].player;
+        if (player > 1 || player < s.turn)
+            broken(i, "has wrong player");
+        if (r[i].round != s.round + 1 || s.round >= s.max_rounds)
+            broken(i, "has wrong round");
+        if (player == 1 && s.turn == 0)
+            s.endTurn();
+        if (r[i].ship < 1 || r[i].ship > Ship::MAX_LENGTH || !s.canShoot(player, r[i].ship))
+            broken(i, "is a shot of ship which cannot shoot");
+        if (r[i].index >= Bitboard::SQUARES || !s.getUntargeted(player, r[i].ship).test(r[i].index))
+            broken(i, "is a shot out of the ship's range");
+        if (s.apply({ r[i].ship, r[i].index }) != r[i].result)
+            broken(i, "has wrong result");
+    }
+    return s;
+}
+
+const battleship::GameJournal::Record* battleship::MappedGameJournal::records() const
+{
+    return reinterpret_cast<const GameJournal::Record*>(static_cast<const char*>(region_.get_address())
+                                                        + sizeof(GameJournal::Header));
+}
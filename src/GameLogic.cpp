@@ -1,8 +1,14 @@
 #include "GameLogic.h"
 #include "AIPlayer.h"
-#include "RandomStrategy.h"
-#include "GreedyStrategy.h"
+#include "StrategyFactory.h"
+#include "MonteCarloStrategy.h"
+#include "OpeningBookStrategy.h"
 #include "HumanPlayer.h"
+#include "Simulation.h"
+#include "GameSnapshot.h"
+#include "GameState.h"
+#include "AutosaveWriter.h"
+#include "ShotExport.h"
 
 #include <boost/filesystem.hpp>
 #include <iostream>
@@ -10,6 +16,7 @@
 #include <thread>
 #include <vector>
 #include <fstream>
+#include <sstream>
 #include <utility>
 #include <ctime>
 #include <chrono>
@@ -21,8 +28,22 @@ using std::make_unique;
 using std::vector;
 using std::pair;
 
-battleship::GameLogic::GameLogic(int argc, char** argv, std::shared_ptr<UI> ui)
+namespace
+{
+    // shots fired by the player's ships in the current round, index is the ship's length - 1
+    std::array<int, battleship::Ship::MAX_LENGTH> shipShots(const battleship::Player& player)
+    {
+        std::array<int, battleship::Ship::MAX_LENGTH> shots;
+        for (int l = 1; l <= battleship::Ship::MAX_LENGTH; l++)
+            shots[l - 1] = player.getPrimaryGird().getShip(l).getShots();
+        return shots;
+    }
+}
+
+battleship::GameLogic::GameLogic(int argc, char** argv, std::shared_ptr<UI> ui,
+                                 std::shared_ptr<AutosaveWriter> autosave)
     : ui_(ui)
+    , autosave_(autosave)
     , description_(loadDescritpion())
     , positional_(loadPositional())
     , state_format_(loadStateFormat())
@@ -31,10 +52,26 @@ battleship::GameLogic::GameLogic(int argc, char** argv, std::shared_ptr<UI> ui)
     po::store(po::command_line_parser(argc, argv).options(description_).positional(positional_).run(), used_options_);
     po::notify(used_options_);
 
+    // help, simulation and conversion have no game to step through
     if (used_options_.count(HELP))
+    {
+        phase_ = GP_OVER;
         return;
+    }
 
     validateCmdlineOptions();
+    if (used_options_.count(OPENING_BOOK))
+        opening_book_ = std::make_shared<MappedOpeningBook>(used_options_[OPENING_BOOK].as<string>());
+    if (used_options_.count(PLACEMENT))
+        placement_ = std::make_shared<PlacementDistribution>(PlacementDistribution::load(used_options_[PLACEMENT].as<string>()));
+    seed_ = used_options_.count(SEED) ? used_options_[SEED].as<std::uint64_t>() : Random::randomSeed();
+
+    // players for simulated games are created in simulate()
+    if (used_options_.count(SIMULATE))
+    {
+        phase_ = GP_OVER;
+        return;
+    }
 
     // load saved state from file if LOAD option
     if (used_options_.count(LOAD))
@@ -42,6 +79,8 @@ battleship::GameLogic::GameLogic(int argc, char** argv, std::shared_ptr<UI> ui)
     // otherways just create empty players
     else
         initializePlayers();
+    if (used_options_.count(CONVERT))
+        phase_ = GP_OVER;
 }
 
 battleship::GameLogic::~GameLogic()
@@ -62,16 +101,23 @@ void battleship::GameLogic::initializePlayers()
         main_player_ = new HumanPlayer(ui_);
         is_human_ = true;
     }
-    else if (str.compare(RANDOM) == 0)
-            main_player_ = new AIPlayer(make_unique<RandomStrategy>());
     else
-            main_player_ = new AIPlayer(make_unique<GreedyStrategy>());
+        main_player_ = createAIPlayer(str, seed_, 0);
 
     // opponent player
-    if (used_options_[OPPONENT].as<string>().compare(RANDOM) == 0)
-        opponent_player_ = new AIPlayer(make_unique<RandomStrategy>());
-    else
-        opponent_player_ = new AIPlayer(make_unique<GreedyStrategy>());
+    opponent_player_ = createAIPlayer(used_options_[OPPONENT].as<string>(), seed_, 2);
+}
+
+battleship::Player* battleship::GameLogic::createAIPlayer(const std::string& type, std::uint64_t seed,
+                                                          unsigned stream) const
+{
+    StrategyOptions options;
+    options.think_ms = think_ms_;
+    options.endgame_squares = endgame_squares_;
+    options.opening_book = opening_book_;
+    options.max_rounds = max_rounds_;
+    options.moves_first = stream == 0;
+    return new AIPlayer(StrategyFactory::create(type, Random(seed, stream + 1), options), Random(seed, stream), placement_);
 }
 
 po::options_description& battleship::GameLogic::loadDescritpion()
@@ -80,12 +126,30 @@ po::options_description& battleship::GameLogic::loadDescritpion()
     desc.add_options()
             (HELP ",h", "produce help message")
             (ROUNDS ",r", po::value<int>(&max_rounds_), "set max rounds number, (>0), (<=20)")
-            (OPPONENT ",o", po::value<string>(), "set opponent type: 'greedy', 'random'")
-            (PLAYER ",p", po::value<string>()->default_value("human"), "set player type: 'human', 'greedy', 'random'")
+            (OPPONENT ",o", po::value<string>(), "set opponent type: 'greedy', 'random', 'density',"\
+                     " 'montecarlo'")
+            (PLAYER ",p", po::value<string>()->default_value("human"), "set player type: 'human', 'greedy', 'random',"\
+                     " 'density', 'montecarlo'")
             (LOAD ",l", po::value<string>(&input_name_)->implicit_value(DEFAULT_FILE), "load game state from file")
             (SAVE ",s", po::value<string>(&output_name_)->default_value(DEFAULT_FILE),
                      "set name for autosave.\nthe game will be save after each round.\nif name was left to default,"\
                      " the save will be deleted after normal game end")
+            (SAVE_FORMAT, po::value<string>(&save_format_)->default_value(TEXT_FORMAT),
+                     "set format of saved game: 'text', 'binary', 'journal'")
+            (CONVERT, "load game from '--" LOAD "' file, save it to '--" SAVE "' file in '--" SAVE_FORMAT "' and exit")
+            (THINK_MS, po::value<int>(&think_ms_)->default_value(100), "time in milliseconds for a single decision of"\
+                     " 'montecarlo' player")
+            (ENDGAME_SQUARES, po::value<int>(&endgame_squares_)->default_value(12), "'montecarlo' player solves the game"\
+                     " exactly when at most this many squares in range of ships are left, 0 turns it off")
+            (OPENING_BOOK, po::value<string>(), "file made by battleship_opening_book, ai players take their first"\
+                     " turn from it")
+            (PLACEMENT, po::value<string>(), "file made by battleship_placement_trainer, ai players place their ships"\
+                     " from it")
+            (SEED, po::value<std::uint64_t>(), "seed for ai players, the same seed gives the same game")
+            (SIMULATE, po::value<int>(), "play given number of games between ai players without ui and autosave,"\
+                     " then print statistics")
+            (EXPORT, po::value<string>(), "write every shot of simulated games to the file in columnar binary format")
+            (EXPORT_CSV, po::value<string>(), "write the shots from '--" EXPORT "' file also to this CSV file")
     ;
     return desc;
 }
@@ -127,9 +191,32 @@ void battleship::GameLogic::validateCmdlineOptions()
         if (used_options_.count(ROUNDS)) throw ArgumentsError("conflict options: '--" LOAD "' and '--" ROUNDS "'.");
         if (used_options_.count(OPPONENT)) throw ArgumentsError("conflict options: '--" LOAD "' and '--" OPPONENT "'.");
 //        if (used_options_.count(PLAYER)) throw ArgumentsError("conflict options: '--" LOAD "' and '--" PLAYER "'.");
+        if (used_options_.count(SIMULATE)) throw ArgumentsError("conflict options: '--" LOAD "' and '--" SIMULATE "'.");
     }
     else
         validateUsedOptions();
+
+    if (save_format_.compare(TEXT_FORMAT) && save_format_.compare(BINARY_FORMAT) && save_format_.compare(JOURNAL_FORMAT))
+        throw ArgumentsError("the argument ('" + save_format_ + "') for option '--" SAVE_FORMAT "' is invalid.");
+    if (think_ms_ <= 0)
+        throw ArgumentsError("the argument ('" + std::to_string(think_ms_) + "') for option '--" THINK_MS "' is invalid.");
+    if (endgame_squares_ < 0)
+        throw ArgumentsError("the argument ('" + std::to_string(endgame_squares_) + "') for option '--" ENDGAME_SQUARES "' is invalid.");
+    if (used_options_.count(CONVERT) && !used_options_.count(LOAD))
+        throw ArgumentsError("option '--" CONVERT "' requires '--" LOAD "' option.");
+
+    if (used_options_.count(SIMULATE))
+    {
+        auto n = used_options_[SIMULATE].as<int>();
+        if (n <= 0)
+            throw ArgumentsError("the argument ('" + std::to_string(n) + "') for option '--" SIMULATE "' is invalid.");
+        if (used_options_[PLAYER].as<string>().compare(HUMAN) == 0)
+            throw ArgumentsError("option '--" SIMULATE "' requires '--" PLAYER "' to be an ai player.");
+    }
+    if (used_options_.count(EXPORT) && !used_options_.count(SIMULATE))
+        throw ArgumentsError("option '--" EXPORT "' requires '--" SIMULATE "' option.");
+    if (used_options_.count(EXPORT_CSV) && !used_options_.count(EXPORT))
+        throw ArgumentsError("option '--" EXPORT_CSV "' requires '--" EXPORT "' option.");
 }
 
 void battleship::GameLogic::validateUsedOptions()
@@ -142,11 +229,11 @@ void battleship::GameLogic::validateUsedOptions()
         throw ArgumentsError("the argument ('" + std::to_string(r) + "') for option '--" ROUNDS "' is invalid.");
 
     auto str = used_options_[OPPONENT].as<string>();
-    if (str.compare(RANDOM) && str.compare(GREEDY))
+    if (!StrategyFactory::isStrategyName(str))
         throw ArgumentsError("the argument ('" + str + "') for option '--" OPPONENT "' is invalid.");
 
     str = used_options_[PLAYER].as<string>();
-    if (str.compare(RANDOM) && str.compare(GREEDY) && str.compare(HUMAN))
+    if (!StrategyFactory::isStrategyName(str) && str.compare(HUMAN))
         throw ArgumentsError("the argument ('" + str + "') for option '--" PLAYER "' is invalid.");
 }
 
@@ -178,6 +265,16 @@ void battleship::GameLogic::validateGameState()
 }
 
 void battleship::GameLogic::loadGameFromFile()
+{
+    if (GameSnapshot::isSnapshotFile(input_name_))
+        loadBinaryGameFromFile();
+    else if (GameJournal::isJournalFile(input_name_))
+        loadJournalGameFromFile();
+    else
+        loadTextGameFromFile();
+}
+
+void battleship::GameLogic::loadTextGameFromFile()
 {
     // read game state from file
     std::ifstream file;
@@ -191,129 +288,315 @@ void battleship::GameLogic::loadGameFromFile()
     file.close();
     validateGameState();
 
-    // initialize game state
-
+    // the state is set at once instead of replaying the saved shots, their order is not known anyway
+    const auto state = textGameState();
+    round_counter_ = state.round;
     initializePlayers();
     try
     {
-        round_counter_ = used_options_[ROUND_NUMBER].as<int>();
+        state.toPlayers(*main_player_, *opponent_player_);
+    }
+    catch (const BattleshipRuntimeError&)
+    {
+        throw ArgumentsError("Invalid game state in file: '" + input_name_ + "'.");
+    }
+    catch (const BattleshipLogicError&)
+    {
+        throw ArgumentsError("Invalid game state in file: '" + input_name_ + "'.");
+    }
+}
 
-        // set up ships
-        main_player_->setUpShips(used_options_[PLAYER_SHIP_1].as<vector<int>>(),
-                                 used_options_[PLAYER_SHIP_2].as<vector<int>>(),
-                                 used_options_[PLAYER_SHIP_3].as<vector<int>>());
-        opponent_player_->setUpShips(used_options_[OPPONENT_SHIP_1].as<vector<int>>(),
-                                     used_options_[OPPONENT_SHIP_2].as<vector<int>>(),
-                                     used_options_[OPPONENT_SHIP_3].as<vector<int>>());
-
-        // simulate hits
-        if (used_options_.count(PLAYER_HITS))
+battleship::GameState battleship::GameLogic::textGameState() const
+{
+    const string error = "Invalid game state in file: '" + input_name_ + "'.";
+
+    // squares of coordinates pairs, the number of coordinates is already checked to be even
+    auto squares = [&](const char* option)
+    {
+        Bitboard b;
+        if (!used_options_.count(option))
+            return b;
+        const auto& v = used_options_[option].as<vector<int>>();
+        for (std::size_t i = 0; i + 1 < v.size(); i += 2)
         {
-            const auto& v = used_options_[PLAYER_HITS].as<vector<int>>();
-            for (auto it = v.begin(); it != v.end(); it += 2)
-            {
-                pair<int,int> p = { *it, *(it + 1) };
-                main_player_->update(p, opponent_player_->takeShot(p));
-            }
+            if (v[i] < 0 || v[i] >= Bitboard::SIZE || v[i + 1] < 0 || v[i + 1] >= Bitboard::SIZE)
+                throw ArgumentsError(error);
+            b.set(Bitboard::toIndex({ v[i], v[i + 1] }));
         }
-        if (used_options_.count(OPPONENT_HITS))
+        return b;
+    };
+
+    const char* ships[2][Ship::MAX_LENGTH] = { { PLAYER_SHIP_1, PLAYER_SHIP_2, PLAYER_SHIP_3 },
+                                               { OPPONENT_SHIP_1, OPPONENT_SHIP_2, OPPONENT_SHIP_3 } };
+    const char* hits[2] = { PLAYER_HITS, OPPONENT_HITS };
+    const char* pausing[2] = { PLAYER_PAUSING_SHIPS, OPPONENT_PAUSING_SHIPS };
+
+    const int round = used_options_[ROUND_NUMBER].as<int>();
+    if (round < 0 || round > max_rounds_)
+        throw ArgumentsError(error);
+
+    GameState s {};
+    s.round = round;
+    s.max_rounds = max_rounds_;
+    const auto& layouts = FleetLayouts::instance();
+    for (int side = 0; side < 2; side++)
+    {
+        auto& d = s.sides[side];
+        FleetLayouts::Layout layout;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
         {
-            const auto& v = used_options_[OPPONENT_HITS].as<vector<int>>();
-            for (auto it = v.begin(); it != v.end(); it += 2)
+            const int index = layouts.placementIndex(l, squares(ships[side][l - 1]));
+            if (index < 0)
+                throw ArgumentsError(error);
+            layout[l - 1] = index;
+            d.fleet[l - 1] = index;
+        }
+        // ships must not touch each other
+        if (layouts.indexOf(layout) < 0)
+            throw ArgumentsError(error);
+
+        const auto targeted = squares(hits[side]);
+        d.targeted[0] = targeted.low();
+        d.targeted[1] = targeted.high();
+
+        if (used_options_.count(pausing[side]))
+            for (int l : used_options_[pausing[side]].as<vector<int>>())
             {
-                pair<int,int> p = { *it, *(it + 1) };
-                opponent_player_->update(p, main_player_->takeShot(p));
+                if (l < 1 || l > Ship::MAX_LENGTH)
+                    throw ArgumentsError(error);
+                d.pausing |= 1 << (l - 1);
             }
+    }
+    return s;
+}
+
+void battleship::GameLogic::saveGameToFile() const
+{
+    try
+    {
+        // the open journal gets only the end of the round, its shots are already written
+        if (journal_)
+            journal_->endRound(round_counter_);
+        else if (save_format_.compare(JOURNAL_FORMAT) == 0)
+            writeJournalGameToFile();
+        else
+        {
+            // the game goes on while the writer's thread saves it
+            if (!autosave_)
+                autosave_ = AutosaveWriter::shared();
+            autosave_->submit(output_name_, serializeGame());
         }
+    }
+    catch (const std::ios_base::failure&) { }
+    catch (const BattleshipRuntimeError&) { }
+}
+
+void battleship::GameLogic::writeGameToFile() const
+{
+    if (save_format_.compare(JOURNAL_FORMAT) == 0)
+        writeJournalGameToFile();
+    else
+        AutosaveWriter::writeFile(output_name_, serializeGame());
+}
+
+std::string battleship::GameLogic::serializeGame() const
+{
+    return save_format_.compare(BINARY_FORMAT) == 0 ? binaryGame() : textGame();
+}
+
+std::string battleship::GameLogic::textGame() const
+{
+    std::ostringstream file;
+
+    // save status
+    // save actual time
+    std::time_t now_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    struct tm *p = std::localtime(&now_c);
+    file << STATE_INFO << " = "  << 1900 + p->tm_year << '-' << 1 + p->tm_mon << '-' << 1 + p->tm_mday
+         << "_" << p->tm_hour << ":" << p->tm_min << ":" << p->tm_sec <<'\n';
+    file << ROUND_NUMBER << " = " << round_counter_ << '\n';
+    file << ROUNDS << " = " << max_rounds_ << '\n';
+    file << OPPONENT << " = " << used_options_[OPPONENT].as<string>() << '\n';
+    file << PLAYER << " = " << used_options_[PLAYER].as<string>() << '\n';
+
+    // save ships
+    auto v = main_player_->getPrimaryGird().getShip(1).getOccupiedSquares();
+    for (auto t : *v)
+        file << PLAYER_SHIP_1 << " = " << t.first << '\n' << PLAYER_SHIP_1 << " = " << t.second << '\n';
+    if (main_player_->getPrimaryGird().getShip(1).isPausing())
+        file << PLAYER_PAUSING_SHIPS << " = 1\n";
+
+    v = main_player_->getPrimaryGird().getShip(2).getOccupiedSquares();
+    for (auto t : *v)
+        file << PLAYER_SHIP_2 << " = " << t.first << '\n' << PLAYER_SHIP_2 << " = " << t.second << '\n';
+    if (main_player_->getPrimaryGird().getShip(2).isPausing())
+        file << PLAYER_PAUSING_SHIPS << " = 2\n";
+
+    v = main_player_->getPrimaryGird().getShip(3).getOccupiedSquares();
+    for (auto t : *v)
+        file << PLAYER_SHIP_3 << " = " << t.first << '\n' << PLAYER_SHIP_3 << " = " << t.second << '\n';
+    if (main_player_->getPrimaryGird().getShip(3).isPausing())
+        file << PLAYER_PAUSING_SHIPS << " = 3\n";
+
+    v = opponent_player_->getPrimaryGird().getShip(1).getOccupiedSquares();
+    for (auto t : *v)
+        file << OPPONENT_SHIP_1 << " = " << t.first << '\n' << OPPONENT_SHIP_1 << " = " << t.second << '\n';
+    if (opponent_player_->getPrimaryGird().getShip(1).isPausing())
+        file << OPPONENT_PAUSING_SHIPS << " = 1\n";
+
+    v = opponent_player_->getPrimaryGird().getShip(2).getOccupiedSquares();
+    for (auto t : *v)
+        file << OPPONENT_SHIP_2 << " = " << t.first << '\n' << OPPONENT_SHIP_2 << " = " << t.second << '\n';
+    if (opponent_player_->getPrimaryGird().getShip(2).isPausing())
+        file << OPPONENT_PAUSING_SHIPS << " = 2\n";
+
+    v = opponent_player_->getPrimaryGird().getShip(3).getOccupiedSquares();
+    for (auto t : *v)
+        file << OPPONENT_SHIP_3 << " = " << t.first << '\n' << OPPONENT_SHIP_3 << " = " << t.second << '\n';
+    if (opponent_player_->getPrimaryGird().getShip(3).isPausing())
+        file << OPPONENT_PAUSING_SHIPS << " = 3\n";
+
+    // save hits
+    auto& mg = main_player_->getSecondaryGrid();
+    for (int x = 0; x < 10; x++)
+         for (int y = 0; y < 10; y++)
+         if (mg.at({x,y}) != ST_EMPTY)
+             file << PLAYER_HITS << " = " << x << '\n' << PLAYER_HITS << " = " << y << '\n';
+
+    auto& og = opponent_player_->getSecondaryGrid();
+    for (int x = 0; x < 10; x++)
+         for (int y = 0; y < 10; y++)
+         if (og.at({x,y}) != ST_EMPTY)
+             file << OPPONENT_HITS << " = " << x << '\n' << OPPONENT_HITS << " = " << y << '\n';
+
+    return file.str();
+}
+
+std::string battleship::GameLogic::binaryGame() const
+{
+    auto snapshot = GameSnapshot::make();
+    snapshot.round_number = round_counter_;
+    snapshot.max_rounds = max_rounds_;
+    snapshot.seed = seed_;
+    snapshot.setPlayer(0, *main_player_, used_options_[PLAYER].as<string>());
+    snapshot.setPlayer(1, *opponent_player_, used_options_[OPPONENT].as<string>());
+    return string(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+}
 
-        // pausing ships
-        if (used_options_.count(PLAYER_PAUSING_SHIPS))
-            main_player_->pauseShips(used_options_[PLAYER_PAUSING_SHIPS].as<vector<int>>());
-        if (used_options_.count(OPPONENT_PAUSING_SHIPS))
-            opponent_player_->pauseShips(used_options_[OPPONENT_PAUSING_SHIPS].as<vector<int>>());
+void battleship::GameLogic::loadBinaryGameFromFile()
+{
+    const string error = "Invalid game state in file: '" + input_name_ + "'.";
+    try
+    {
+        MappedSnapshot file(input_name_);
+        const auto& snapshot = file.get();
+
+        // options are applied in the same way as the ones from text file, command line ones take precedence
+        std::istringstream options(string(ROUNDS) + " = " + std::to_string(snapshot.max_rounds) + '\n'
+                                   + OPPONENT + " = " + snapshot.getType(1) + '\n'
+                                   + PLAYER + " = " + snapshot.getType(0) + '\n');
+        po::store(po::parse_config_file(options, description_), used_options_);
+        po::notify(used_options_);
+        validateUsedOptions();
+        if (snapshot.round_number < 0 || snapshot.round_number > max_rounds_)
+            throw ArgumentsError(error);
+
+        if (!used_options_.count(SEED))
+            seed_ = snapshot.seed;
+        round_counter_ = snapshot.round_number;
+
+        initializePlayers();
+        snapshot.restorePlayer(0, *main_player_);
+        snapshot.restorePlayer(1, *opponent_player_);
+        main_player_->setFinishedRounds(round_counter_);
+        opponent_player_->setFinishedRounds(round_counter_);
     }
     catch (const BattleshipRuntimeError&)
     {
-        throw ArgumentsError("Invalid game state in file: '" + input_name_ + "'.");
+        throw ArgumentsError(error);
     }
     catch (const BattleshipLogicError&)
     {
-        throw ArgumentsError("Invalid game state in file: '" + input_name_ + "'.");
+        throw ArgumentsError(error);
     }
+
+    // shots of each player have to match the opponent's grid
+    for (auto t : { ST_HIT, ST_MISS, ST_SUNK })
+        if (main_player_->getSecondaryGrid().getPlane(t) != opponent_player_->getPrimaryGird().getPlane(t)
+                || opponent_player_->getSecondaryGrid().getPlane(t) != main_player_->getPrimaryGird().getPlane(t))
+            throw ArgumentsError(error);
 }
 
-void battleship::GameLogic::saveGameToFile() const
+battleship::GameJournal::Header battleship::GameLogic::journalHeader() const
+{
+    return GameJournal::makeHeader(max_rounds_, seed_, used_options_[PLAYER].as<string>(),
+                                   used_options_[OPPONENT].as<string>());
+}
+
+void battleship::GameLogic::writeJournalGameToFile() const
+{
+    GameJournalWriter(output_name_, journalHeader(), GameState::fromPlayers(*main_player_, *opponent_player_, max_rounds_));
+}
+
+void battleship::GameLogic::loadJournalGameFromFile()
+{
+    const string error = "Invalid game state in file: '" + input_name_ + "'.";
+    try
+    {
+        MappedGameJournal journal(input_name_);
+
+        // options are applied in the same way as the ones from text file, command line ones take precedence
+        std::istringstream options(string(ROUNDS) + " = " + std::to_string(journal.header().max_rounds) + '\n'
+                                   + OPPONENT + " = " + journal.getType(1) + '\n'
+                                   + PLAYER + " = " + journal.getType(0) + '\n');
+        po::store(po::parse_config_file(options, description_), used_options_);
+        po::notify(used_options_);
+        validateUsedOptions();
+
+        if (!used_options_.count(SEED))
+            seed_ = journal.header().seed;
+
+        // the game goes on from the last finished round, shots of the unfinished one are dropped
+        const auto state = journal.stateAt(journal.lastRound());
+        round_counter_ = state.round;
+        initializePlayers();
+        state.toPlayers(*main_player_, *opponent_player_);
+    }
+    catch (const BattleshipRuntimeError&)
+    {
+        throw ArgumentsError(error);
+    }
+    catch (const BattleshipLogicError&)
+    {
+        throw ArgumentsError(error);
+    }
+}
+
+void battleship::GameLogic::openJournal()
 {
-    std::ofstream file;
-    file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    if (used_options_.count(LOAD) && GameJournal::isJournalFile(input_name_) && fs::exists(output_name_)
+            && fs::equivalent(input_name_, output_name_))
+        journal_ = make_unique<GameJournalWriter>(output_name_);
+    else
+        journal_ = make_unique<GameJournalWriter>(output_name_, journalHeader(),
+                                                  GameState::fromPlayers(*main_player_, *opponent_player_, max_rounds_));
+}
+
+void battleship::GameLogic::recordShot(int player, const Player& shooter, const std::array<int, Ship::MAX_LENGTH>& shots,
+                                       std::pair<int, int> square, ShotResult result)
+{
+    if (!journal_)
+        return;
+
+    int length = 0;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        if (shooter.getPrimaryGird().getShip(l).getShots() != shots[l - 1])
+            length = l;
     try
     {
-        file.open(output_name_);
-
-        // save status
-        // save actual time
-        std::time_t now_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-        struct tm *p = std::localtime(&now_c);
-        file << STATE_INFO << " = "  << 1900 + p->tm_year << '-' << 1 + p->tm_mon << '-' << 1 + p->tm_mday
-             << "_" << p->tm_hour << ":" << p->tm_min << ":" << p->tm_sec <<'\n';
-        file << ROUND_NUMBER << " = " << round_counter_ << '\n';
-        file << ROUNDS << " = " << max_rounds_ << '\n';
-        file << OPPONENT << " = " << used_options_[OPPONENT].as<string>() << '\n';
-        file << PLAYER << " = " << used_options_[PLAYER].as<string>() << '\n';
-
-        // save ships
-        auto v = main_player_->getPrimaryGird().getShip(1).getOccupiedSquares();
-        for (auto t : *v)
-            file << PLAYER_SHIP_1 << " = " << t.first << '\n' << PLAYER_SHIP_1 << " = " << t.second << '\n';
-        if (main_player_->getPrimaryGird().getShip(1).isPausing())
-            file << PLAYER_PAUSING_SHIPS << " = 1\n";
-
-        v = main_player_->getPrimaryGird().getShip(2).getOccupiedSquares();
-        for (auto t : *v)
-            file << PLAYER_SHIP_2 << " = " << t.first << '\n' << PLAYER_SHIP_2 << " = " << t.second << '\n';
-        if (main_player_->getPrimaryGird().getShip(2).isPausing())
-            file << PLAYER_PAUSING_SHIPS << " = 2\n";
-
-        v = main_player_->getPrimaryGird().getShip(3).getOccupiedSquares();
-        for (auto t : *v)
-            file << PLAYER_SHIP_3 << " = " << t.first << '\n' << PLAYER_SHIP_3 << " = " << t.second << '\n';
-        if (main_player_->getPrimaryGird().getShip(3).isPausing())
-            file << PLAYER_PAUSING_SHIPS << " = 3\n";
-
-        v = opponent_player_->getPrimaryGird().getShip(1).getOccupiedSquares();
-        for (auto t : *v)
-            file << OPPONENT_SHIP_1 << " = " << t.first << '\n' << OPPONENT_SHIP_1 << " = " << t.second << '\n';
-        if (opponent_player_->getPrimaryGird().getShip(1).isPausing())
-            file << OPPONENT_PAUSING_SHIPS << " = 1\n";
-
-        v = opponent_player_->getPrimaryGird().getShip(2).getOccupiedSquares();
-        for (auto t : *v)
-            file << OPPONENT_SHIP_2 << " = " << t.first << '\n' << OPPONENT_SHIP_2 << " = " << t.second << '\n';
-        if (opponent_player_->getPrimaryGird().getShip(2).isPausing())
-            file << OPPONENT_PAUSING_SHIPS << " = 2\n";
-
-        v = opponent_player_->getPrimaryGird().getShip(3).getOccupiedSquares();
-        for (auto t : *v)
-            file << OPPONENT_SHIP_3 << " = " << t.first << '\n' << OPPONENT_SHIP_3 << " = " << t.second << '\n';
-        if (opponent_player_->getPrimaryGird().getShip(3).isPausing())
-            file << OPPONENT_PAUSING_SHIPS << " = 3\n";
-
-        // save hits
-        auto& mg = main_player_->getSecondaryGrid();
-        for (int x = 0; x < 10; x++)
-             for (int y = 0; y < 10; y++)
-             if (mg.at({x,y}) != ST_EMPTY)
-                 file << PLAYER_HITS << " = " << x << '\n' << PLAYER_HITS << " = " << y << '\n';
-
-        auto& og = opponent_player_->getSecondaryGrid();
-        for (int x = 0; x < 10; x++)
-             for (int y = 0; y < 10; y++)
-             if (og.at({x,y}) != ST_EMPTY)
-                 file << OPPONENT_HITS << " = " << x << '\n' << OPPONENT_HITS << " = " << y << '\n';
-
-        file.close();
+        journal_->shot(player, { length, Bitboard::toIndex(square) }, result, round_counter_);
     }
-    catch (const std::ios_base::failure& e) { }
+    catch (const BattleshipRuntimeError&) { }
 }
 
 void battleship::GameLogic::updateUI()
@@ -327,6 +610,79 @@ void battleship::GameLogic::updateUI()
         ui_->displayPlayers(*main_player_, *opponent_player_);
 }
 
+void battleship::GameLogic::simulate()
+{
+    const int games = used_options_[SIMULATE].as<int>();
+    const auto& player_type = used_options_[PLAYER].as<string>();
+    const auto& opponent_type = used_options_[OPPONENT].as<string>();
+    Simulation simulation(max_rounds_);
+    SimulationStats stats;
+    MonteCarloStrategy::Stats search;
+
+    // every shot goes to the export when it is asked for, a single thread needs a single buffer
+    std::unique_ptr<ShotExportWriter> writer;
+    std::unique_ptr<ShotExportBuffer> buffer;
+    if (used_options_.count(EXPORT))
+    {
+        writer = make_unique<ShotExportWriter>(used_options_[EXPORT].as<string>(), seed_);
+        buffer = make_unique<ShotExportBuffer>(*writer);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < games; i++)
+    {
+        const auto seed = Random::deriveSeed(seed_, i);
+        std::unique_ptr<Player> main(createAIPlayer(player_type, seed, 0));
+        std::unique_ptr<Player> opponent(createAIPlayer(opponent_type, seed, 2));
+        main->setUpShips();
+        opponent->setUpShips();
+        if (buffer)
+        {
+            buffer->setGame(i);
+            stats.add(simulation.playStaticGame(*main, *opponent, *buffer));
+        }
+        else
+            stats.add(simulation.playGame(*main, *opponent));
+
+        // rollouts of searching players are reported with the results
+        for (auto* p : { main.get(), opponent.get() })
+        {
+            const auto* strategy = &static_cast<AIPlayer*>(p)->getStrategy();
+            if (auto* book = dynamic_cast<const OpeningBookStrategy*>(strategy))
+                strategy = &book->getFallback();
+            if (auto* s = dynamic_cast<const MonteCarloStrategy*>(strategy))
+            {
+                search.decisions += s->getStats().decisions;
+                search.rollouts += s->getStats().rollouts;
+                search.seconds += s->getStats().seconds;
+            }
+        }
+    }
+    if (buffer)
+    {
+        buffer->flush();
+        writer->flush();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "games: " << stats.games() << " (" << player_type << " vs " << opponent_type << "), seed: "
+              << seed_ << '\n'
+              << "wins / draws / losses: " << stats.wins << " / " << stats.draws << " / " << stats.losses << '\n'
+              << "average rounds: " << stats.averageRounds() << '\n'
+              << "games per second: " << (elapsed.count() > 0 ? stats.games() / elapsed.count() : 0.0) << std::endl;
+    if (search.decisions > 0)
+        std::cout << "decisions: " << search.decisions << ", rollouts per second: "
+                  << (search.seconds > 0 ? search.rollouts / search.seconds : 0.0) << std::endl;
+
+    if (used_options_.count(EXPORT_CSV))
+    {
+        std::ofstream csv(used_options_[EXPORT_CSV].as<string>());
+        ShotExport::writeCsv(used_options_[EXPORT].as<string>(), csv);
+        if (!csv)
+            throw BattleshipRuntimeError("cannot write file '" + used_options_[EXPORT_CSV].as<string>() + "'.");
+    }
+}
+
 void battleship::GameLogic::run()
 {
     if (used_options_.count(HELP))
@@ -335,20 +691,84 @@ void battleship::GameLogic::run()
         return;
     }
 
-    // set up ships
-    if (!used_options_.count(LOAD))
+    if (used_options_.count(SIMULATE))
     {
-        if (is_human_)
-        {
-            ui_->cleanScreen();
-            ui_->displayPlayer(*main_player_);
-        }
-        main_player_->setUpShips();
-        opponent_player_->setUpShips();
+        simulate();
+        return;
     }
 
-    while (++round_counter_ <= max_rounds_)
+    if (used_options_.count(CONVERT))
     {
+        writeGameToFile();
+        return;
+    }
+
+    // the game is a sequence of steps, delays of ai moves are waited here
+    while (true)
+    {
+        const auto s = step();
+        if (s.status == GS_OVER)
+            break;
+        if (s.delay_ms > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds{s.delay_ms});
+    }
+}
+
+battleship::GameStatus battleship::GameLogic::getStatus() const
+{
+    switch (phase_)
+    {
+    case GP_OVER:
+        return GS_OVER;
+    case GP_SETUP:
+        return is_human_ && !used_options_.count(LOAD) ? GS_AWAITING_INPUT : GS_RUNNING;
+    case GP_MAIN_SHOT:
+        return is_human_ ? GS_AWAITING_INPUT : GS_RUNNING;
+    case GP_MAIN_EXTRA_SHOT:
+        return is_human_ && main_player_->canShoot() ? GS_AWAITING_INPUT : GS_RUNNING;
+    default:
+        return GS_RUNNING;
+    }
+}
+
+battleship::GameStep battleship::GameLogic::step()
+{
+    int delay = 0;
+    switch (phase_)
+    {
+    case GP_SETUP:
+        // set up ships
+        if (!used_options_.count(LOAD))
+        {
+            if (is_human_)
+            {
+                ui_->cleanScreen();
+                ui_->displayPlayer(*main_player_);
+            }
+            main_player_->setUpShips();
+            opponent_player_->setUpShips();
+        }
+
+        // journal is written during the game instead of saving it after every round
+        if (save_format_.compare(JOURNAL_FORMAT) == 0)
+        {
+            try
+            {
+                openJournal();
+            }
+            catch (const BattleshipRuntimeError&) { }
+        }
+        phase_ = GP_ROUND;
+        break;
+
+    case GP_ROUND:
+        if (++round_counter_ > max_rounds_)
+        {
+            finishGame();
+            phase_ = GP_OVER;
+            break;
+        }
+
         updateUI();
         // main player
         if (!main_player_->canShoot())
@@ -356,54 +776,86 @@ void battleship::GameLogic::run()
             if (!main_player_->mayShootNextRounds())
             {
                 ui_->displayMessage("You lost!\n");
-                return;
+                phase_ = GP_OVER;
             }
             else
+            {
                 ui_->displayMessage("In this round you are pausing.");
+                phase_ = GP_OPPONENT_TURN;
+            }
+            break;
         }
-        else
+        if (!is_human_)
         {
-            if (!is_human_)
-            {
-                ui_->displayMessage("Player's turn...");
-                std::this_thread::sleep_for(std::chrono::milliseconds{AI_REACTION_TIME});
-            }
-            auto p = main_player_->shoot();
-            main_player_->update(p, opponent_player_->takeShot(p));
-            updateUI();
+            ui_->displayMessage("Player's turn...");
+            delay = AI_REACTION_TIME;
+        }
+        phase_ = GP_MAIN_SHOT;
+        break;
 
-            while(main_player_->canShoot()
-                  && (!is_human_ || ui_->askQuestion("Do you want to shoot one more time in this round?")))
-            {
-                auto p = main_player_->shoot();
-                auto sr = opponent_player_->takeShot(p);
-                main_player_->update(p, sr);
-                updateUI();
-            }
+    case GP_MAIN_SHOT:
+        playShot(0);
+        updateUI();
+        phase_ = GP_MAIN_EXTRA_SHOT;
+        break;
+
+    case GP_MAIN_EXTRA_SHOT:
+        if (main_player_->canShoot()
+                && (!is_human_ || ui_->askQuestion("Do you want to shoot one more time in this round?")))
+        {
+            playShot(0);
+            updateUI();
         }
+        else
+            phase_ = GP_OPPONENT_TURN;
+        break;
 
+    case GP_OPPONENT_TURN:
         // opponent player
         if (!opponent_player_->canShoot() && !opponent_player_->mayShootNextRounds())
         {
             ui_->displayMessage("You win!");
-            return;
+            phase_ = GP_OVER;
+            break;
         }
-
         ui_->displayMessage("The opponent's turn...");
-        std::this_thread::sleep_for(std::chrono::milliseconds{AI_REACTION_TIME});
+        delay = AI_REACTION_TIME;
+        phase_ = GP_OPPONENT_SHOT;
+        break;
 
-        while (opponent_player_->canShoot())
+    case GP_OPPONENT_SHOT:
+        if (opponent_player_->canShoot())
         {
-            auto p = opponent_player_->shoot();
-            opponent_player_->update(p, main_player_->takeShot(p));
+            playShot(1);
+            break;
         }
 
         // next round
         main_player_->nextRound();
         opponent_player_->nextRound();
         saveGameToFile();
+        phase_ = GP_ROUND;
+        break;
+
+    case GP_OVER:
+        break;
     }
+    return { getStatus(), delay };
+}
 
+void battleship::GameLogic::playShot(int player)
+{
+    auto& shooter = player == 0 ? *main_player_ : *opponent_player_;
+    auto& target = player == 0 ? *opponent_player_ : *main_player_;
+    auto shots = shipShots(shooter);
+    auto p = shooter.shoot();
+    auto sr = target.takeShot(p);
+    shooter.update(p, sr);
+    recordShot(player, shooter, shots, p, sr);
+}
+
+void battleship::GameLogic::finishGame()
+{
     // count hits
     int main_hits = main_player_->getHits();
     int opponent_hits = opponent_player_->getHits();
@@ -415,7 +867,9 @@ void battleship::GameLogic::run()
     else
         ui_->displayMessage("You lost!\n(after playing all rounds the opponent hit you more times)");
 
-    // delete save file if it was default name
+    // delete save file if it was default name, the last save must not be written after that
+    if (autosave_)
+        autosave_->flush(output_name_);
     if (output_name_.compare(DEFAULT_FILE) == 0 && fs::exists(output_name_))
         fs::remove(output_name_);
 }
@@ -0,0 +1,127 @@
+#include "GameSnapshot.h"
+#include "exceptions.h"
+
+#include <boost/interprocess/exceptions.hpp>
+#include <fstream>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+namespace bip = boost::interprocess;
+using std::string;
+using std::vector;
+using std::uint64_t;
+
+battleship::GameSnapshot battleship::GameSnapshot::make()
+{
+    GameSnapshot s;
+    std::memset(&s, 0, sizeof(s));
+    s.magic = MAGIC;
+    s.version = VERSION;
+    s.saved_at = std::time(nullptr);
+    return s;
+}
+
+bool battleship::GameSnapshot::isSnapshotFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios_base::binary);
+    std::uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return file && magic == MAGIC;
+}
+
+void battleship::GameSnapshot::setPlayer(int index, const Player& player, const std::string& type)
+{
+    if (index < 0 || index > 1)
+        throw BattleshipLogicError("GameSnapshot::setPlayer: wrong player index.");
+    if (type.size() >= TYPE_LENGTH)
+        throw BattleshipLogicError("GameSnapshot::setPlayer: player type name too long.");
+
+    auto& p = players[index];
+    auto words = [](uint64_t (&w)[2], Bitboard b) { w[0] = b.low(); w[1] = b.high(); };
+
+    p.pausing = 0;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        const auto& s = player.getPrimaryGird().getShip(l);
+        words(p.fleet[l - 1], s.getOccupiedMask());
+        if (s.isPausing())
+            p.pausing |= 1u << (l - 1);
+    }
+
+    const auto& g = player.getSecondaryGrid();
+    words(p.hit, g.getPlane(ST_HIT));
+    words(p.miss, g.getPlane(ST_MISS));
+    words(p.sunk, g.getPlane(ST_SUNK));
+
+    std::memset(p.type, 0, TYPE_LENGTH);
+    std::memcpy(p.type, type.data(), type.size());
+}
+
+std::string battleship::GameSnapshot::getType(int index) const
+{
+    const auto& t = players[index].type;
+    return string(t, strnlen(t, TYPE_LENGTH));
+}
+
+void battleship::GameSnapshot::restorePlayer(int index, Player& player) const
+{
+    const auto& p = players[index];
+    const auto& o = players[1 - index];
+    auto bitboard = [](const uint64_t (&w)[2]) { return Bitboard(w[0], w[1]); };
+
+    Fleet fleet;
+    vector<int> pausing;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        fleet[l - 1] = bitboard(p.fleet[l - 1]);
+        if (p.pausing & (1u << (l - 1)))
+            pausing.push_back(l);
+    }
+
+    Grid secondary;
+    secondary.restore(bitboard(p.hit), bitboard(p.miss), bitboard(p.sunk));
+
+    const auto opponent_shots = bitboard(o.hit) | bitboard(o.miss) | bitboard(o.sunk);
+    player.restore(fleet, opponent_shots, secondary, pausing);
+}
+
+void battleship::GameSnapshot::write(const std::string& path) const
+{
+    std::ofstream file;
+    file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        file.open(path, std::ios_base::binary | std::ios_base::trunc);
+        file.write(reinterpret_cast<const char*>(this), sizeof(*this));
+        file.close();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("GameSnapshot::write: cannot write file '" + path + "'.");
+    }
+}
+
+battleship::MappedSnapshot::MappedSnapshot(const std::string& path)
+{
+    try
+    {
+        file_ = bip::file_mapping(path.c_str(), bip::read_only);
+        region_ = bip::mapped_region(file_, bip::read_only);
+    }
+    catch (const bip::interprocess_exception&)
+    {
+        throw BattleshipRuntimeError("MappedSnapshot: cannot map file '" + path + "'.");
+    }
+
+    if (region_.get_size() != sizeof(GameSnapshot) || get().magic != GameSnapshot::MAGIC)
+        throw BattleshipRuntimeError("MappedSnapshot: file '" + path + "' is not a game snapshot.");
+    if (get().version != GameSnapshot::VERSION)
+        throw BattleshipRuntimeError("MappedSnapshot: unsupported snapshot version in file '" + path + "'.");
+}
+
+const battleship::GameSnapshot& battleship::MappedSnapshot::get() const
+{
+    // region is page aligned, so it is aligned enough for the snapshot
+    return *static_cast<const GameSnapshot*>(region_.get_address());
+}
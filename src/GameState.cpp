@@ -0,0 +1,216 @@
+#include "GameState.h"
+#include "FleetLayouts.h"
+#include "Player.h"
+#include "exceptions.h"
+
+#include <array>
+#include <vector>
+
+namespace
+{
+    const battleship::FleetLayouts::Placement& placement(const battleship::GameState& s, int side, int length)
+    {
+        return battleship::FleetLayouts::instance().getPlacements(length)[s.sides[side].fleet[length - 1]];
+    }
+}
+
+battleship::GameState battleship::GameState::fromPlayers(const Player& main, const Player& opponent, int max_rounds,
+                                                        int turn)
+{
+    if (main.getFinishedRounds() != opponent.getFinishedRounds())
+        throw BattleshipRuntimeError("GameState::fromPlayers: players are in different rounds.");
+
+    GameState s {};
+    s.round = main.getFinishedRounds();
+    s.max_rounds = max_rounds;
+    s.turn = turn;
+
+    const Player* players[] = { &main, &opponent };
+    for (int side = 0; side < 2; side++)
+    {
+        auto& d = s.sides[side];
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            const auto& ship = players[side]->getPrimaryGird().getShip(l);
+            const int index = FleetLayouts::instance().placementIndex(l, ship.getOccupiedMask());
+            if (index < 0)
+                throw BattleshipLogicError("GameState::fromPlayers: ships are not placed.");
+            d.fleet[l - 1] = index;
+            d.shots[l - 1] = ship.getShots();
+            if (ship.isPausing())
+                d.pausing |= 1 << (l - 1);
+        }
+
+        const auto targeted = ~players[side]->getSecondaryGrid().getPlane(ST_EMPTY);
+        d.targeted[0] = targeted.low();
+        d.targeted[1] = targeted.high();
+    }
+
+    for (int side = 0; side < 2; side++)
+    {
+        const auto grid = s.getSecondaryGrid(side);
+        const auto& other = players[1 - side]->getPrimaryGird();
+        for (auto t : { ST_HIT, ST_MISS, ST_SUNK })
+            if (players[side]->getSecondaryGrid().getPlane(t) != grid.getPlane(t) || other.getPlane(t) != grid.getPlane(t))
+                throw BattleshipRuntimeError("GameState::fromPlayers: shots do not match the opponent's grid.");
+    }
+    return s;
+}
+
+battleship::Bitboard battleship::GameState::getTargeted(int side) const
+{
+    return Bitboard(sides[side].targeted[0], sides[side].targeted[1]);
+}
+
+battleship::Bitboard battleship::GameState::getShip(int side, int length) const
+{
+    return placement(*this, side, length).mask;
+}
+
+bool battleship::GameState::isSunk(int side, int length) const
+{
+    return (getShip(side, length) & ~getTargeted(1 - side)).empty();
+}
+
+int battleship::GameState::getHits(int side) const
+{
+    const auto shots = getTargeted(1 - side);
+    int hits = 0;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        hits += (getShip(side, l) & shots).count();
+    return hits;
+}
+
+battleship::Bitboard battleship::GameState::getUntargeted(int side, int length) const
+{
+    return placement(*this, side, length).range & ~getTargeted(side);
+}
+
+battleship::Grid battleship::GameState::getSecondaryGrid(int side) const
+{
+    const auto shots = getTargeted(side);
+    Bitboard ships;
+    Bitboard sunk;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        const auto mask = getShip(1 - side, l);
+        ships |= mask;
+        if ((mask & ~shots).empty())
+            sunk |= mask;
+    }
+
+    Grid g;
+    g.restore(shots & ships & ~sunk, shots & ~ships, sunk);
+    return g;
+}
+
+bool battleship::GameState::canShoot(int side, int length) const
+{
+    const auto& s = sides[side];
+    if ((s.pausing & (1 << (length - 1))) || s.shots[length - 1] >= Ship::MAX_SHOTS[length])
+        return false;
+    const auto& p = placement(*this, side, length);
+    return !(p.mask & ~getTargeted(1 - side)).empty() && !(p.range & ~getTargeted(side)).empty();
+}
+
+bool battleship::GameState::canShoot(int side) const
+{
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        if (canShoot(side, l))
+            return true;
+    return false;
+}
+
+bool battleship::GameState::mayShootNextRounds(int side) const
+{
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        if (!(sides[side].pausing & (1 << (l - 1))) && sides[side].shots[l - 1] >= Ship::MAX_SHOTS[l])
+            continue;
+        const auto& p = placement(*this, side, l);
+        if (!(p.mask & ~getTargeted(1 - side)).empty() && !(p.range & ~getTargeted(side)).empty())
+            return true;
+    }
+    return false;
+}
+
+battleship::ShotResult battleship::GameState::apply(Shot shot)
+{
+    auto& s = sides[turn];
+    s.pausing |= ((1 << Ship::MAX_LENGTH) - 1) & ~(1 << (shot.ship_length - 1));
+    s.shots[shot.ship_length - 1]++;
+    s.targeted[shot.square / 64] |= std::uint64_t(1) << (shot.square % 64);
+
+    const auto shots = getTargeted(turn);
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        const auto& p = placement(*this, 1 - turn, l);
+        if (p.mask.test(shot.square))
+            return (p.mask & ~shots).empty() ? SR_SUNK : SR_HIT;
+    }
+    return SR_MISS;
+}
+
+void battleship::GameState::endTurn()
+{
+    turn = 1;
+}
+
+void battleship::GameState::nextRound()
+{
+    for (auto& s : sides)
+    {
+        s.pausing = 0;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            if (s.shots[l - 1] >= Ship::PAUSING_AFTER_SHOTS)
+                s.pausing |= 1 << (l - 1);
+            s.shots[l - 1] = 0;
+        }
+    }
+    round++;
+    turn = 0;
+}
+
+void battleship::GameState::toPlayers(Player& main, Player& opponent) const
+{
+    Player* players[] = { &main, &opponent };
+    for (int side = 0; side < 2; side++)
+    {
+        const auto& d = sides[side];
+        Fleet fleet;
+        std::array<int, Ship::MAX_LENGTH> shots;
+        std::vector<int> pausing;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            fleet[l - 1] = getShip(side, l);
+            shots[l - 1] = d.shots[l - 1];
+            if (d.pausing & (1 << (l - 1)))
+                pausing.push_back(l);
+        }
+
+        players[side]->restore(fleet, getTargeted(1 - side), getSecondaryGrid(side), pausing);
+        players[side]->restoreShots(shots);
+        players[side]->setFinishedRounds(round);
+    }
+}
+
+bool battleship::operator==(const GameState& l, const GameState& r)
+{
+    for (int side = 0; side < 2; side++)
+    {
+        const auto& a = l.sides[side];
+        const auto& b = r.sides[side];
+        for (int i = 0; i < Ship::MAX_LENGTH; i++)
+            if (a.fleet[i] != b.fleet[i] || a.shots[i] != b.shots[i])
+                return false;
+        if (a.pausing != b.pausing || a.targeted[0] != b.targeted[0] || a.targeted[1] != b.targeted[1])
+            return false;
+    }
+    return l.round == r.round && l.max_rounds == r.max_rounds && l.turn == r.turn;
+}
+
+bool battleship::operator!=(const GameState& l, const GameState& r)
+{
+    return !(l == r);
+}
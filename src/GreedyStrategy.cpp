@@ -1,8 +1,5 @@
 #include "GreedyStrategy.h"
 
-#include <random>
-#include <algorithm>
-
 using std::unique_ptr;
 using std::reference_wrapper;
 using std::vector;
@@ -10,20 +7,22 @@ using std::pair;
 using std::unordered_set;
 
 
+battleship::GreedyStrategy::GreedyStrategy(Random rng)
+    : rng_(rng)
+{ }
+
 int battleship::GreedyStrategy::chooseShip(unique_ptr<vector<int>> ships_lengths)
 {
-    if (ships_lengths->empty())
-        throw BattleshipRuntimeError("GreedyStrategy::chooseShip: no ship to choose.");
-    std::sort(ships_lengths->begin(), ships_lengths->end());
-    return *ships_lengths->rbegin();
+    ShipsLengths l;
+    for (auto x : *ships_lengths)
+        l.push_back(x);
+    return chooseShip(l);
 }
 
 pair<int,int> battleship::GreedyStrategy::chooseSquare(unique_ptr<unordered_set<pair<int,int>, SquareHash>> squares)
 {
-    if (squares->empty())
-        throw BattleshipRuntimeError("GreedyStrategy::chooseSquare: no square to choose.");
-    unsigned position = std::random_device{}() % squares->size();
-    auto it = squares->begin();
-    while(position--) ++it;
-    return *it;
+    SquareSet s;
+    for (auto& x : *squares)
+        s.insert(x);
+    return chooseSquare(s);
 }
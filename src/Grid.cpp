@@ -1,14 +1,12 @@
 #include "Grid.h"
 #include "exceptions.h"
 
-#include <stack>
 #include <iostream>
 
 using std::unordered_set;
 using std::unique_ptr;
 using std::pair;
 using std::make_unique;
-using std::stack;
 
 
 std::size_t battleship::SquareHash::operator()(const pair<int, int>& pii) const
@@ -18,38 +16,47 @@ std::size_t battleship::SquareHash::operator()(const pair<int, int>& pii) const
     return ((unsigned)pii.first << 4) + (unsigned)pii.second;
 }
 
-battleship::Grid::Grid()
+unique_ptr<unordered_set<pair<int,int>, battleship::SquareHash>> battleship::Grid::getAvailableRange(
+        const Ship& ship) const
 {
-    for (int a = 0; a < 10; ++a)
-        for (int b = 0; b < 10; ++b)
-            table_[a][b] = SquareType::ST_EMPTY;
+    auto mask = getAvailableMask(ship);
+
+    auto r = make_unique<unordered_set<pair<int, int>, battleship::SquareHash>>();
+    while (!mask.empty())
+        r->insert(Bitboard::toSquare(mask.popLowest()));
+
+    return r;
 }
 
-unique_ptr<unordered_set<pair<int,int>, battleship::SquareHash>> battleship::Grid::getAvailableRange(
-        const Ship& ship) const
+battleship::Bitboard battleship::Grid::getAvailableMask(const Ship& ship) const
 {
     if (ship.isSunk())
-        throw BattleshipLogicError("Grid::getAvailableRange: the ship is sunk");
+        throw BattleshipLogicError("Grid::getAvailableMask: the ship is sunk");
     if (ship.getLength() == 0)
-        throw BattleshipLogicError("Grid::getAvailableRange: the ship is not yet placed on the grid");
+        throw BattleshipLogicError("Grid::getAvailableMask: the ship is not yet placed on the grid");
 
-    auto r = make_unique<unordered_set<pair<int, int>, battleship::SquareHash>>();
-    auto s = ship.getOccupiedSquares();
-    int range = ship.getRange();
+    return ship.getRangeMask() & getPlane(ST_EMPTY);
+}
+
+battleship::SquareSet battleship::Grid::getAvailableSquares(const Ship& ship) const
+{
+    return SquareSet(getAvailableMask(ship));
+}
 
-    for (int i = 0; i < ship.getLength(); i++)
+battleship::Bitboard battleship::Grid::getPlane(SquareType type) const
+{
+    switch (type)
     {
-        const pair<int, int> p = (*s)[i];
-
-        for (int a = -range; a <= range; ++a)
-            for (int b = -range; b <= range; ++b)
-            {
-                if (p.first + a <= 9 && p.first + a >= 0 && p.second + b <= 9 && p.second + b >= 0)
-                    if (table_[p.first + a][p.second + b] == ST_EMPTY) r->insert({ p.first + a, p.second + b });
-            }
+    case ST_SINGLE: return ships_planes_[0];
+    case ST_DOUBLE: return ships_planes_[1];
+    case ST_TRIPLE: return ships_planes_[2];
+    case ST_MISS:   return miss_plane_;
+    case ST_SUNK:   return sunk_plane_;
+    case ST_HIT:    return hit_plane_;
+    case ST_EMPTY:
+        return ~(ships_planes_[0] | ships_planes_[1] | ships_planes_[2] | miss_plane_ | sunk_plane_ | hit_plane_);
     }
-
-    return r;
+    throw BattleshipLogicError("Grid::getPlane: unknown square type.");
 }
 
 battleship::SquareType battleship::Grid::at(pair<int,int> square) const
@@ -57,7 +64,14 @@ battleship::SquareType battleship::Grid::at(pair<int,int> square) const
     if (square.second > 9 || square.second < 0 || square.first > 9 || square.first < 0) 
         throw InvalidCoordinateError("Grid::at: coordinates out of allowed range.");
 
-    return table_[square.first][square.second];
+    const int i = Bitboard::toIndex(square);
+    if (hit_plane_.test(i)) return ST_HIT;
+    if (miss_plane_.test(i)) return ST_MISS;
+    if (sunk_plane_.test(i)) return ST_SUNK;
+    if (ships_planes_[0].test(i)) return ST_SINGLE;
+    if (ships_planes_[1].test(i)) return ST_DOUBLE;
+    if (ships_planes_[2].test(i)) return ST_TRIPLE;
+    return ST_EMPTY;
 }
 
 void battleship::Grid::update(std::pair<int,int> square, ShotResult result)
@@ -68,59 +82,65 @@ void battleship::Grid::update(std::pair<int,int> square, ShotResult result)
     // missed
     if (result == SR_MISS)
     {
-        table_[square.first][square.second] = ST_MISS;
+        miss_plane_.set(square);
         return;
     }
 
-    stack<pair<int, int>> st;
-    unordered_set<pair<int,int>, battleship::SquareHash> visited;
-
-    st.push(square);
-    visited.insert(square);
-    bool sunk_ship_too_close = false;
-
-    while (!st.empty())
+    // grow the cluster of hit squares connected with the shot one until it stops changing
+    // bitboards are used so the whole update does not allocate
+    Bitboard cluster = Bitboard::fromSquare(square);
+    while (cluster.count() <= Ship::MAX_LENGTH)
     {
-        auto p = st.top();
-        st.pop();
-
-        for (int a = -1; a <= 1; a++)
-        {
-            for (int b = -1; b <= 1; b++)
-            {
-                const int fst = p.first + a;
-                const int snd = p.second + b;
-                if (fst < 0 || snd < 0 || fst >= 10 || snd >= 10 || visited.count({ fst, snd }))
-                    continue;
-                if (table_[fst][snd] == ST_SUNK)
-                {
-                    sunk_ship_too_close = true;
-                    break;
-                }
-                if (table_[fst][snd] == ST_HIT)
-                {
-                    st.push({ fst, snd });
-                    visited.insert({ fst, snd });
-                }
-            }
-        }
+        const Bitboard grown = (cluster.dilate() & hit_plane_) | cluster;
+        if (grown == cluster)
+            break;
+        cluster = grown;
     }
 
-    if (sunk_ship_too_close || visited.size() > Ship::MAX_LENGTH)
+    const int length = cluster.count();
+    const bool sunk_ship_too_close = !(cluster.dilate() & sunk_plane_).empty();
+
+    if (sunk_ship_too_close || length > Ship::MAX_LENGTH)
         throw BattleshipRuntimeError("Grid::update: obtained ships too close or too long ship.");
 
     // hit
     if (result == SR_HIT)
     {
-        table_[square.first][square.second] = ST_HIT;
+        hit_plane_.set(square);
         return;
     }
 
     // sunk
-    if (sunk_ships_.count(visited.size()))
+    if (sunk_lengths_ & (1u << length))
         throw BattleshipRuntimeError("Grid::update: already sunk ship with the same length.");
 
-    sunk_ships_.insert(visited.size());
-    for (auto p : visited)
-        table_[p.first][p.second] = ST_SUNK;
+    sunk_lengths_ |= 1u << length;
+    hit_plane_ &= ~cluster;
+    sunk_plane_ |= cluster;
+}
+
+void battleship::Grid::restore(Bitboard hit, Bitboard miss, Bitboard sunk)
+{
+    if (!((hit & miss) | (hit & sunk) | (miss & sunk)).empty())
+        throw BattleshipRuntimeError("Grid::restore: square cannot have two types.");
+
+    // every group of touching sunk squares is one ship
+    unsigned sunk_lengths = 0;
+    for (Bitboard remaining = sunk; !remaining.empty(); )
+    {
+        Bitboard ship = Bitboard::fromIndex(remaining.lowest());
+        for (Bitboard grown = ship.dilate() & sunk; grown != ship; grown = ship.dilate() & sunk)
+            ship = grown;
+
+        const int length = ship.count();
+        if (length > Ship::MAX_LENGTH || (sunk_lengths & (1u << length)))
+            throw BattleshipRuntimeError("Grid::restore: wrong sunk ships.");
+        sunk_lengths |= 1u << length;
+        remaining &= ~ship;
+    }
+
+    hit_plane_ = hit;
+    miss_plane_ = miss;
+    sunk_plane_ = sunk;
+    sunk_lengths_ = sunk_lengths;
 }
@@ -0,0 +1,160 @@
+#include "LockstepSimulation.h"
+#include "FleetLayouts.h"
+#include "exceptions.h"
+
+using std::vector;
+
+
+battleship::LockstepSimulation::LockstepSimulation(int max_rounds, BatchPolicy main, BatchPolicy opponent,
+                                                   BatchIsa isa)
+    : max_rounds_(max_rounds)
+    , main_(main)
+    , opponent_(opponent)
+    , isa_(isa)
+{
+    if (!main_ || !opponent_)
+        throw BattleshipLogicError("LockstepSimulation: both players need batched strategies.");
+}
+
+vector<battleship::GameResult> battleship::LockstepSimulation::playGames(std::uint64_t seed, long begin, long end) const
+{
+    return play(seed, begin, end, nullptr, nullptr);
+}
+
+vector<battleship::GameResult> battleship::LockstepSimulation::playGames(std::uint64_t seed, long begin, long end,
+                                                                         const vector<FleetLayouts::Layout>& main_fleets,
+                                                                         vector<GameState>& final_states) const
+{
+    if (long(main_fleets.size()) != end - begin)
+        throw BattleshipLogicError("LockstepSimulation::playGames: every game needs the main player's fleet.");
+    return play(seed, begin, end, &main_fleets, &final_states);
+}
+
+vector<battleship::GameResult> battleship::LockstepSimulation::play(std::uint64_t seed, long begin, long end,
+                                                                    const vector<FleetLayouts::Layout>* main_fleets,
+                                                                    vector<GameState>* final_states) const
+{
+    const long n = end - begin;
+    vector<Game> games(n);
+    ShotBatch batches[2] = { ShotBatch(n), ShotBatch(n) };
+
+    // the same generators as players and strategies of Tournament::playGame
+    const auto& layouts = FleetLayouts::instance();
+    for (long i = 0; i < n; i++)
+    {
+        const auto game_seed = Random::deriveSeed(seed, begin + i);
+        auto& s = games[i].state;
+        s = GameState {};
+        s.max_rounds = max_rounds_;
+        for (int side = 0; side < 2; side++)
+        {
+            Random rng(game_seed, 2 * side);
+            const auto layout = side == 0 && main_fleets ? (*main_fleets)[i] : layouts.sample(rng);
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                s.sides[side].fleet[l - 1] = layout[l - 1];
+            batches[side].setRandom(i, Random(game_seed, 2 * side + 1));
+        }
+        games[i].started = false;
+        games[i].finished = false;
+    }
+
+    long active = n;
+    while (active > 0)
+    {
+        // games have ships only in the batch of the side on turn, finished games in none
+        long shooting[2] = { 0, 0 };
+        for (long i = 0; i < n; i++)
+        {
+            auto& game = games[i];
+            if (!game.finished && advance(game))
+            {
+                game.finished = true;
+                active--;
+            }
+
+            const auto& s = game.state;
+            const int side = s.turn;
+            batches[1 - side].ships[i] = 0;
+            if (game.finished)
+            {
+                batches[side].ships[i] = 0;
+                continue;
+            }
+
+            auto& b = batches[side];
+            std::uint64_t ships = 0;
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            {
+                if (s.canShoot(side, l))
+                    ships |= 1 << (l - 1);
+                const auto untargeted = s.getUntargeted(side, l);
+                b.untargeted_low[l - 1][i] = untargeted.low();
+                b.untargeted_high[l - 1][i] = untargeted.high();
+            }
+            b.ships[i] = ships;
+            shooting[side]++;
+        }
+
+        if (shooting[0] > 0)
+            main_(batches[0], isa_);
+        if (shooting[1] > 0)
+            opponent_(batches[1], isa_);
+
+        for (long i = 0; i < n; i++)
+            if (!games[i].finished)
+            {
+                auto& s = games[i].state;
+                const auto& b = batches[s.turn];
+                s.apply({ b.ship_length[i], b.square[i] });
+            }
+    }
+
+    vector<GameResult> results;
+    results.reserve(n);
+    for (auto& game : games)
+        results.push_back(game.result);
+    if (final_states)
+    {
+        final_states->clear();
+        for (auto& game : games)
+            final_states->push_back(game.state);
+    }
+    return results;
+}
+
+bool battleship::LockstepSimulation::advance(Game& game) const
+{
+    // the same checks as Simulation::playGame makes in every turn
+    auto& s = game.state;
+    for (;;)
+    {
+        const int side = s.turn;
+        if (!game.started)
+        {
+            game.started = true;
+            if (!s.canShoot(side) && !s.mayShootNextRounds(side))
+            {
+                game.result = { side == 0 ? GO_LOSS : GO_WIN, s.round + 1 };
+                return true;
+            }
+        }
+        if (s.canShoot(side))
+            return false;
+
+        game.started = false;
+        if (side == 0)
+            s.endTurn();
+        else
+        {
+            s.nextRound();
+            if (s.round >= max_rounds_)
+            {
+                const int main_hits = s.getHits(0);
+                const int opponent_hits = s.getHits(1);
+                game.result = { main_hits == opponent_hits ? GO_DRAW : (main_hits < opponent_hits ? GO_WIN : GO_LOSS),
+                                max_rounds_ };
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,365 @@
+#include "MonteCarloStrategy.h"
+#include "ConsistentLayouts.h"
+#include "FleetLayouts.h"
+#include "Player.h"
+#include "exceptions.h"
+
+#include <algorithm>
+#include <chrono>
+
+using std::unique_ptr;
+using std::vector;
+using std::pair;
+using std::unordered_set;
+using std::make_unique;
+
+namespace
+{
+    // Samples opponent's fleets uniformly from layouts consistent with the grid.
+    // Layouts are grouped by triple and double ship, a group is chosen with probability proportional
+    // to the number of squares left for the single ship and then one of these squares is chosen.
+    class FleetSampler
+    {
+    public:
+        explicit FleetSampler(const battleship::Grid& shots)
+            : any_(shots.getPlane(battleship::ST_EMPTY) == battleship::Bitboard::full())
+        {
+            if (any_)
+                return;
+
+            const auto& doubles = battleship::FleetLayouts::instance().getPlacements(2);
+            battleship::ConsistentLayouts(shots).forEachTriple(
+                    [&](int triple, const battleship::DoublesSet& valid, battleship::Bitboard t_singles)
+            {
+                valid.forEach([&](int j)
+                {
+                    const auto singles = t_singles & ~doubles[j].neighbourhood;
+                    if (singles.empty())
+                        return;
+                    total_ += singles.count();
+                    groups_.push_back({ total_, triple, j, singles });
+                });
+            });
+        }
+
+        bool empty() const
+        {
+            return !any_ && total_ == 0;
+        }
+
+        battleship::FleetLayouts::Layout sample(battleship::Random& rng) const
+        {
+            // every legal layout agrees with the empty grid
+            if (any_)
+                return battleship::FleetLayouts::instance().sample(rng);
+
+            const std::uint32_t r = rng.below(total_);
+            auto it = std::upper_bound(groups_.begin(), groups_.end(), r,
+                                       [](std::uint32_t x, const Group& g) { return x < g.end; });
+            const std::uint32_t begin = it->end - it->singles.count();
+            // placements of the single ship have the same indices as their squares
+            return {{ it->singles.nth(r - begin), it->double_index, it->triple }};
+        }
+
+    private:
+        struct Group
+        {
+            // number of layouts in this group and all groups before it
+            std::uint32_t end;
+            int triple;
+            int double_index;
+            battleship::Bitboard singles;
+        };
+
+        bool any_;
+        std::uint32_t total_ = 0;
+        vector<Group> groups_;
+    };
+
+    // random shots of the side on turn until it cannot shoot anymore
+    void playTurn(battleship::GameState& s, battleship::Random& rng)
+    {
+        for (;;)
+        {
+            int lengths[battleship::Ship::MAX_LENGTH];
+            int n = 0;
+            for (int l = 1; l <= battleship::Ship::MAX_LENGTH; l++)
+                if (s.canShoot(s.turn, l))
+                    lengths[n++] = l;
+            if (n == 0)
+                return;
+
+            const int length = lengths[rng.below(n)];
+            const auto squares = s.getUntargeted(s.turn, length);
+            s.apply({ length, squares.nth(rng.below(squares.count())) });
+        }
+    }
+}
+
+
+battleship::MonteCarloStrategy::MonteCarloStrategy(Random rng, const StrategyOptions& options)
+    : rng_(rng)
+    , options_(options)
+{
+    if (options_.threads != 1)
+        pool_ = make_unique<WorkStealingPool>(options_.threads);
+
+    const auto seed = rng_();
+    for (int w = 0; w < (pool_ ? pool_->size() : 1); w++)
+        worker_rngs_.emplace_back(seed, w);
+
+    // clearing the table takes a while, it is not paid from the time budget of a decision
+    if (options_.endgame_squares > 0)
+    {
+        table_ = make_unique<TranspositionTable>(std::size_t(ENDGAME_TABLE_ENTRIES));
+        for (std::size_t w = 0; w < worker_rngs_.size(); w++)
+            solvers_.emplace_back(*table_, options_.moves_first ? 0 : 1);
+    }
+}
+
+double battleship::MonteCarloStrategy::rollout(GameState state, Random& rng)
+{
+    auto& s = state;
+    const auto result = [&](GameOutcome outcome)
+    {
+        const double value = outcome == GO_WIN ? 1.0 : (outcome == GO_DRAW ? 0.5 : 0.0);
+        return value + 0.01 * (s.getHits(1) - s.getHits(0));
+    };
+
+    // the turn in progress is finished first, then the game goes on like in Simulation::playGame
+    playTurn(s, rng);
+    for (;;)
+    {
+        if (s.turn == 0)
+        {
+            s.endTurn();
+            if (!s.canShoot(1) && !s.mayShootNextRounds(1))
+                return result(GO_WIN);
+        }
+        else
+        {
+            s.nextRound();
+            if (s.round >= s.max_rounds)
+            {
+                const int main_hits = s.getHits(0);
+                const int opponent_hits = s.getHits(1);
+                return result(main_hits == opponent_hits ? GO_DRAW : (main_hits < opponent_hits ? GO_WIN : GO_LOSS));
+            }
+            if (!s.canShoot(0) && !s.mayShootNextRounds(0))
+                return result(GO_LOSS);
+        }
+        playTurn(s, rng);
+    }
+}
+
+const battleship::MonteCarloStrategy::Stats& battleship::MonteCarloStrategy::getStats() const
+{
+    return stats_;
+}
+
+int battleship::MonteCarloStrategy::chooseShip(unique_ptr<vector<int>> ships_lengths)
+{
+    ShipsLengths l;
+    for (auto x : *ships_lengths)
+        l.push_back(x);
+    return chooseShip(l);
+}
+
+pair<int,int> battleship::MonteCarloStrategy::chooseSquare(unique_ptr<unordered_set<pair<int,int>, SquareHash>> squares)
+{
+    SquareSet s;
+    for (auto& x : *squares)
+        s.insert(x);
+    return chooseSquare(s);
+}
+
+int battleship::MonteCarloStrategy::chooseShip(const ShipsLengths& ships_lengths)
+{
+    if (ships_lengths.empty())
+        throw BattleshipRuntimeError("MonteCarloStrategy::chooseShip: no ship to choose.");
+    return ships_lengths[rng_.below(ships_lengths.size())];
+}
+
+pair<int,int> battleship::MonteCarloStrategy::chooseSquare(const SquareSet& squares)
+{
+    if (squares.empty())
+        throw BattleshipRuntimeError("MonteCarloStrategy::chooseSquare: no square to choose.");
+    return squares.nth(rng_.below(squares.size()));
+}
+
+int battleship::MonteCarloStrategy::chooseShip(const ShipsLengths& ships_lengths, const Player& player)
+{
+    if (ships_lengths.empty())
+        throw BattleshipRuntimeError("MonteCarloStrategy::chooseShip: no ship to choose.");
+
+    // the square is decided together with the ship and returned by the following chooseSquare
+    const auto shot = decide(ships_lengths, player);
+    chosen_square_ = shot.square;
+    return shot.ship_length;
+}
+
+pair<int,int> battleship::MonteCarloStrategy::chooseSquare(const SquareSet& squares, const Player&)
+{
+    if (squares.empty())
+        throw BattleshipRuntimeError("MonteCarloStrategy::chooseSquare: no square to choose.");
+
+    const int square = chosen_square_;
+    chosen_square_ = -1;
+    if (square >= 0 && squares.getMask().test(square))
+        return Bitboard::toSquare(square);
+    return chooseSquare(squares);
+}
+
+battleship::GameState battleship::MonteCarloStrategy::observe(const Player& player) const
+{
+    GameState s {};
+    const int me = options_.moves_first ? 0 : 1;
+    s.round = player.getFinishedRounds();
+    s.max_rounds = options_.max_rounds;
+    s.turn = me;
+
+    // the opponent's ships are not known, they are assumed to be able to shoot in the next round
+    auto& side = s.sides[me];
+    const auto& layouts = FleetLayouts::instance();
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        const auto& ship = player.getPrimaryGird().getShip(l);
+        side.fleet[l - 1] = layouts.placementIndex(l, ship.getOccupiedMask());
+        side.shots[l - 1] = ship.getShots();
+        if (ship.isPausing())
+            side.pausing |= 1 << (l - 1);
+    }
+
+    const auto mine = ~player.getSecondaryGrid().getPlane(ST_EMPTY);
+    side.targeted[0] = mine.low();
+    side.targeted[1] = mine.high();
+
+    const auto& primary = player.getPrimaryGird();
+    const auto theirs = primary.getPlane(ST_HIT) | primary.getPlane(ST_MISS) | primary.getPlane(ST_SUNK);
+    s.sides[1 - me].targeted[0] = theirs.low();
+    s.sides[1 - me].targeted[1] = theirs.high();
+    return s;
+}
+
+battleship::Shot battleship::MonteCarloStrategy::decide(const ShipsLengths& ships_lengths, const Player& player)
+{
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    const auto deadline = start + std::chrono::milliseconds(options_.think_ms);
+
+    vector<Shot> actions;
+    for (auto l : ships_lengths)
+        for (auto b = player.getUntargetedMask(player.getPrimaryGird().getShip(l)); !b.empty(); )
+            actions.push_back({ l, b.popLowest() });
+
+    const FleetSampler sampler(player.getSecondaryGrid());
+    if (actions.size() == 1 || sampler.empty())
+        return actions[rng_.below(actions.size())];
+
+    const auto base = observe(player);
+    const int me = base.turn;
+    const auto withFleet = [&](const FleetLayouts::Layout& layout)
+    {
+        GameState s = base;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            s.sides[1 - me].fleet[l - 1] = layout[l - 1];
+        return s;
+    };
+
+    bool endgame = options_.endgame_squares > 0;
+    for (int i = 0; endgame && i < ENDGAME_PROBES; i++)
+        endgame = EndgameSolver::remainingSquares(withFleet(sampler.sample(rng_))) <= options_.endgame_squares;
+    // every worker sums results of its rollouts, sums are added up when the time is over
+    vector<vector<double>> sums(worker_rngs_.size(), vector<double>(actions.size()));
+    const WorkStealingPool::Body rollouts = [&](int worker, long begin, long end)
+    {
+        auto& rng = worker_rngs_[worker];
+        auto& sum = sums[worker];
+        for (long a = begin; a < end; a++)
+            for (int k = 0; k < ROLLOUTS_PER_BATCH; k++)
+            {
+                GameState s = withFleet(sampler.sample(rng));
+                s.apply(actions[a]);
+                const double value = rollout(s, rng);
+                sum[a] += me == 0 ? value : 1.0 - value;
+            }
+    };
+
+    // in the endgame all actions are solved for the same fleet, an action whose solve reaches
+    // the deadline gets the value of a single rollout instead
+    GameState fleet_state;
+    vector<long> fallbacks(worker_rngs_.size());
+    const WorkStealingPool::Body solve = [&](int worker, long begin, long end)
+    {
+        auto& solver = solvers_[worker];
+        for (long a = begin; a < end; a++)
+        {
+            GameState s = fleet_state;
+            s.apply(actions[a]);
+            const double value = solver.solve(s);
+            if (!solver.isAborted())
+                sums[worker][a] += value;
+            else
+            {
+                const double r = rollout(s, worker_rngs_[worker]);
+                sums[worker][a] += me == 0 ? r : 1.0 - r;
+                fallbacks[worker]++;
+            }
+        }
+    };
+
+    // at least one batch is played, so every action has some results
+    long nodes = 0;
+    for (auto& s : solvers_)
+    {
+        nodes -= s.getNodes();
+        s.setDeadline(deadline);
+    }
+    long rollout_batches = 0;
+    do
+    {
+        // the probes do not bound the size of every sampled fleet
+        if (endgame)
+            fleet_state = withFleet(sampler.sample(rng_));
+        if (endgame && EndgameSolver::remainingSquares(fleet_state) <= options_.endgame_squares)
+            runBatch(actions.size(), solve);
+        else
+        {
+            runBatch(actions.size(), rollouts);
+            rollout_batches++;
+        }
+    }
+    while (clock::now() < deadline);
+    for (auto& s : solvers_)
+        nodes += s.getNodes();
+
+    int best = 0;
+    double best_sum = 0;
+    for (int a = 0; a < (int)actions.size(); a++)
+    {
+        double sum = 0;
+        for (auto& w : sums)
+            sum += w[a];
+        if (a == 0 || sum > best_sum)
+        {
+            best = a;
+            best_sum = sum;
+        }
+    }
+
+    stats_.decisions++;
+    stats_.rollouts += rollout_batches * ROLLOUTS_PER_BATCH * (long)actions.size();
+    for (auto f : fallbacks)
+        stats_.aborted_solves += f;
+    stats_.nodes += nodes;
+    stats_.seconds += std::chrono::duration<double>(clock::now() - start).count();
+    return actions[best];
+}
+
+void battleship::MonteCarloStrategy::runBatch(long count, const WorkStealingPool::Body& body)
+{
+    if (pool_)
+        pool_->parallelFor(count, 1, body);
+    else
+        body(0, 0, count);
+}
@@ -0,0 +1,157 @@
+#include "OpeningBook.h"
+#include "DensityStrategy.h"
+#include "exceptions.h"
+
+#include <boost/interprocess/exceptions.hpp>
+#include <algorithm>
+#include <array>
+#include <fstream>
+
+namespace bip = boost::interprocess;
+using std::vector;
+using std::uint8_t;
+using std::uint64_t;
+
+const std::uint8_t battleship::OpeningBook::NO_SQUARE;
+
+namespace
+{
+    // the best squares of a single ship's placement and their number of layouts
+    struct Turn
+    {
+        uint64_t layouts = 0;
+        uint8_t squares[battleship::OpeningBook::TURN_SHOTS];
+    };
+
+    // squares in range with the highest counts, ties go to the lower square
+    // sum of their counts is the expected number of hits times the number of layouts
+    Turn bestTurn(const battleship::FleetLayouts::Placement& p, const battleship::DensityStrategy::Density& density)
+    {
+        const int shots = battleship::Ship::MAX_SHOTS[p.length];
+        if (shots > battleship::OpeningBook::TURN_SHOTS)
+            throw battleship::BattleshipLogicError("OpeningBook::generate: turn has more shots than the entry.");
+
+        Turn t;
+        std::fill(std::begin(t.squares), std::end(t.squares), battleship::OpeningBook::NO_SQUARE);
+        auto range = p.range;
+        for (int k = 0; k < shots && !range.empty(); k++)
+        {
+            int best = -1;
+            for (auto b = range; !b.empty(); )
+            {
+                const int q = b.popLowest();
+                if (best == -1 || density.counts[q] > density.counts[best])
+                    best = q;
+            }
+            t.squares[k] = best;
+            t.layouts += density.counts[best];
+            range.reset(best);
+        }
+        return t;
+    }
+}
+
+
+vector<battleship::OpeningBook::Entry> battleship::OpeningBook::generate()
+{
+    const auto& layouts = FleetLayouts::instance();
+    const auto density = DensityStrategy::countLayouts(Grid());
+
+    // the best turn of every ship depends only on its own placement
+    std::array<vector<Turn>, Ship::MAX_LENGTH> turns;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        for (auto& p : layouts.getPlacements(l))
+            turns[l - 1].push_back(bestTurn(p, density));
+
+    vector<Entry> entries;
+    entries.reserve(layouts.size());
+    for (std::size_t i = 0; i < layouts.size(); i++)
+    {
+        const auto layout = layouts.at(i);
+
+        // longer ship when turns are equally good, like DensityStrategy
+        int best = 1;
+        for (int l = 2; l <= Ship::MAX_LENGTH; l++)
+            if (turns[l - 1][layout[l - 1]].layouts >= turns[best - 1][layout[best - 1]].layouts)
+                best = l;
+
+        const auto& t = turns[best - 1][layout[best - 1]];
+        Entry e {};
+        e.layout = FleetLayouts::pack(layout);
+        e.ship = best;
+        std::copy(std::begin(t.squares), std::end(t.squares), e.squares);
+        entries.push_back(e);
+    }
+    return entries;
+}
+
+void battleship::OpeningBook::write(const std::string& path, const vector<Entry>& entries)
+{
+    Header h {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.entries = entries.size();
+
+    std::ofstream file;
+    file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        file.open(path, std::ios_base::binary | std::ios_base::trunc);
+        file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+        file.close();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("OpeningBook::write: cannot write file '" + path + "'.");
+    }
+}
+
+battleship::MappedOpeningBook::MappedOpeningBook(const std::string& path)
+{
+    try
+    {
+        file_ = bip::file_mapping(path.c_str(), bip::read_only);
+        region_ = bip::mapped_region(file_, bip::read_only);
+    }
+    catch (const bip::interprocess_exception&)
+    {
+        throw BattleshipRuntimeError("MappedOpeningBook: cannot map file '" + path + "'.");
+    }
+
+    if (region_.get_size() < sizeof(OpeningBook::Header) || header().magic != OpeningBook::MAGIC)
+        throw BattleshipRuntimeError("MappedOpeningBook: file '" + path + "' is not an opening book.");
+    if (header().version != OpeningBook::VERSION)
+        throw BattleshipRuntimeError("MappedOpeningBook: unsupported opening book version in file '" + path + "'.");
+    // entries are compared to the size of the data, their size in bytes can overflow
+    const auto data = region_.get_size() - sizeof(OpeningBook::Header);
+    if (data % sizeof(OpeningBook::Entry) != 0 || header().entries != data / sizeof(OpeningBook::Entry))
+        throw BattleshipRuntimeError("MappedOpeningBook: file '" + path + "' is truncated.");
+}
+
+std::size_t battleship::MappedOpeningBook::size() const
+{
+    return header().entries;
+}
+
+const battleship::OpeningBook::Entry* battleship::MappedOpeningBook::find(const FleetLayouts::Layout& layout) const
+{
+    const auto code = FleetLayouts::pack(layout);
+    const auto begin = entries();
+    const auto end = begin + size();
+    const auto it = std::lower_bound(begin, end, code,
+                                     [](const OpeningBook::Entry& e, std::uint32_t c) { return e.layout < c; });
+    return it != end && it->layout == code ? it : nullptr;
+}
+
+const battleship::OpeningBook::Header& battleship::MappedOpeningBook::header() const
+{
+    // region is page aligned, so it is aligned enough for the header
+    return *static_cast<const OpeningBook::Header*>(region_.get_address());
+}
+
+const battleship::OpeningBook::Entry* battleship::MappedOpeningBook::entries() const
+{
+    return reinterpret_cast<const OpeningBook::Entry*>(static_cast<const char*>(region_.get_address())
+                                                       + sizeof(OpeningBook::Header));
+}
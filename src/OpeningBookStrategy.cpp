@@ -0,0 +1,100 @@
+#include "OpeningBookStrategy.h"
+#include "Player.h"
+#include "exceptions.h"
+
+#include <algorithm>
+
+using std::unique_ptr;
+using std::shared_ptr;
+using std::vector;
+using std::pair;
+using std::unordered_set;
+using std::move;
+
+
+battleship::OpeningBookStrategy::OpeningBookStrategy(shared_ptr<const MappedOpeningBook> book,
+                                                     unique_ptr<ShootStrategy> fallback)
+    : book_(move(book))
+    , fallback_(move(fallback))
+{
+    if (!book_ || !fallback_)
+        throw BattleshipLogicError("OpeningBookStrategy: book and fallback strategy are required.");
+}
+
+const battleship::ShootStrategy& battleship::OpeningBookStrategy::getFallback() const
+{
+    return *fallback_;
+}
+
+int battleship::OpeningBookStrategy::chooseShip(unique_ptr<vector<int>> ships_lengths)
+{
+    book_square_ = -1;
+    return fallback_->chooseShip(move(ships_lengths));
+}
+
+pair<int,int> battleship::OpeningBookStrategy::chooseSquare(unique_ptr<unordered_set<pair<int,int>, SquareHash>> squares)
+{
+    return fallback_->chooseSquare(move(squares));
+}
+
+int battleship::OpeningBookStrategy::chooseShip(const ShipsLengths& ships_lengths)
+{
+    book_square_ = -1;
+    return fallback_->chooseShip(ships_lengths);
+}
+
+pair<int,int> battleship::OpeningBookStrategy::chooseSquare(const SquareSet& squares)
+{
+    return fallback_->chooseSquare(squares);
+}
+
+int battleship::OpeningBookStrategy::chooseShip(const ShipsLengths& ships_lengths, const Player& player)
+{
+    int ship = 0;
+    book_square_ = lookup(ships_lengths, player, ship);
+    if (book_square_ >= 0)
+        return ship;
+    return fallback_->chooseShip(ships_lengths, player);
+}
+
+pair<int,int> battleship::OpeningBookStrategy::chooseSquare(const SquareSet& squares, const Player& player)
+{
+    const int square = book_square_;
+    book_square_ = -1;
+    if (square >= 0 && squares.getMask().test(square))
+        return Bitboard::toSquare(square);
+    return fallback_->chooseSquare(squares, player);
+}
+
+int battleship::OpeningBookStrategy::lookup(const ShipsLengths& ships_lengths, const Player& player, int& ship) const
+{
+    // only misses of the first turn, the book does not know what to do after a hit
+    const auto& shots = player.getSecondaryGrid();
+    if (player.getFinishedRounds() != 0 || !(shots.getPlane(ST_HIT) | shots.getPlane(ST_SUNK)).empty())
+        return -1;
+
+    FleetLayouts::Layout layout;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        layout[l - 1] = FleetLayouts::instance().placementIndex(l, player.getPrimaryGird().getShip(l).getOccupiedMask());
+        if (layout[l - 1] < 0)
+            return -1;
+    }
+    const auto* entry = book_->find(layout);
+    if (!entry || std::find(ships_lengths.begin(), ships_lengths.end(), entry->ship) == ships_lengths.end())
+        return -1;
+
+    // shots made so far have to be the first squares of the entry
+    const auto targeted = ~shots.getPlane(ST_EMPTY);
+    Bitboard planned;
+    for (int k = 0; k < OpeningBook::TURN_SHOTS && entry->squares[k] != OpeningBook::NO_SQUARE; k++)
+    {
+        if (planned == targeted)
+        {
+            ship = entry->ship;
+            return entry->squares[k];
+        }
+        planned.set(entry->squares[k]);
+    }
+    return -1;
+}
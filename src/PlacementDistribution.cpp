@@ -0,0 +1,130 @@
+#include "PlacementDistribution.h"
+#include "exceptions.h"
+
+#include <fstream>
+#include <cmath>
+
+using std::vector;
+using std::uint32_t;
+using std::uint64_t;
+
+
+battleship::PlacementDistribution::PlacementDistribution(const vector<double>& weights)
+{
+    const auto n = weights.size();
+    if (n != FleetLayouts::instance().size())
+        throw BattleshipLogicError("PlacementDistribution: every legal layout needs a weight.");
+
+    double total = 0;
+    for (auto w : weights)
+    {
+        if (!(w >= 0) || std::isinf(w))
+            throw BattleshipLogicError("PlacementDistribution: weights must be finite and not negative.");
+        total += w;
+    }
+    if (total <= 0)
+        throw BattleshipLogicError("PlacementDistribution: at least one weight must be positive.");
+
+    // Vose's method: columns with less than the average weight are filled up from larger ones
+    probabilities_.resize(n);
+    threshold_.resize(n);
+    alias_.resize(n);
+    vector<double> scaled(n);
+    vector<uint32_t> small, large;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        probabilities_[i] = weights[i] / total;
+        scaled[i] = weights[i] / total * n;
+        (scaled[i] < 1 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty())
+    {
+        const auto s = small.back();
+        const auto l = large.back();
+        small.pop_back();
+        threshold_[s] = uint32_t(scaled[s] * 4294967296.0);
+        alias_[s] = l;
+        scaled[l] -= 1 - scaled[s];
+        if (scaled[l] < 1)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // the rest is full up to rounding errors
+    for (auto i : large)
+    {
+        threshold_[i] = UINT32_MAX;
+        alias_[i] = i;
+    }
+    for (auto i : small)
+    {
+        threshold_[i] = UINT32_MAX;
+        alias_[i] = i;
+    }
+}
+
+battleship::PlacementDistribution battleship::PlacementDistribution::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios_base::binary);
+    Header h {};
+    if (!file || !file.read(reinterpret_cast<char*>(&h), sizeof(h)) || h.magic != MAGIC)
+        throw BattleshipRuntimeError("PlacementDistribution::load: file '" + path + "' is not a placement distribution.");
+    if (h.version != VERSION)
+        throw BattleshipRuntimeError("PlacementDistribution::load: unsupported version in file '" + path + "'.");
+    if (h.layouts != FleetLayouts::instance().size())
+        throw BattleshipRuntimeError("PlacementDistribution::load: file '" + path + "' has a wrong number of layouts.");
+
+    vector<float> stored(h.layouts);
+    if (!file.read(reinterpret_cast<char*>(stored.data()), stored.size() * sizeof(float)) || file.peek() != EOF)
+        throw BattleshipRuntimeError("PlacementDistribution::load: file '" + path + "' has a wrong size.");
+
+    try
+    {
+        return PlacementDistribution(vector<double>(stored.begin(), stored.end()));
+    }
+    catch (const BattleshipLogicError&)
+    {
+        throw BattleshipRuntimeError("PlacementDistribution::load: file '" + path + "' has invalid weights.");
+    }
+}
+
+void battleship::PlacementDistribution::write(const std::string& path, const vector<double>& weights)
+{
+    Header h {};
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.layouts = weights.size();
+    const vector<float> stored(weights.begin(), weights.end());
+
+    std::ofstream file;
+    file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        file.open(path, std::ios_base::binary | std::ios_base::trunc);
+        file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        file.write(reinterpret_cast<const char*>(stored.data()), stored.size() * sizeof(float));
+        file.close();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("PlacementDistribution::write: cannot write file '" + path + "'.");
+    }
+}
+
+std::size_t battleship::PlacementDistribution::size() const
+{
+    return probabilities_.size();
+}
+
+double battleship::PlacementDistribution::probability(std::size_t layout) const
+{
+    return probabilities_.at(layout);
+}
+
+battleship::FleetLayouts::Layout battleship::PlacementDistribution::sample(Random& rng) const
+{
+    const auto column = rng.below(threshold_.size());
+    const auto coin = uint32_t(rng() >> 32);
+    return FleetLayouts::instance().at(coin < threshold_[column] ? column : alias_[column]);
+}
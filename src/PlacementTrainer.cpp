@@ -0,0 +1,153 @@
+#include "PlacementTrainer.h"
+#include "PlacementDistribution.h"
+#include "WorkStealingPool.h"
+#include "StrategyFactory.h"
+#include "GameLogic.h"
+#include "exceptions.h"
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+namespace po = boost::program_options;
+using std::string;
+using std::vector;
+
+
+battleship::PlacementTrainer::PlacementTrainer(int argc, char** argv)
+    : description_("Allowed options")
+{
+    description_.add_options()
+            (HELP ",h", "produce help message")
+            (TRAINER_OUTPUT, po::value<string>(&output_), "file for the placement distribution, it is used with"\
+                     " '--placement' of battleship and battleship_tournament")
+            (OPPONENT ",o", po::value<string>(&opponent_)->default_value(GREEDY), "strategy the placement is trained"\
+                     " against: 'greedy', 'random'")
+            (PLAYER ",p", po::value<string>(&player_)->default_value(GREEDY), "strategy shooting for the trained"\
+                     " player: 'greedy', 'random'")
+            (TRAINER_GAMES ",g", po::value<int>(&games_)->default_value(8), "games played by every layout")
+            (ROUNDS ",r", po::value<int>(&max_rounds_)->default_value(20), "set max rounds number, (>0), (<=20)")
+            (TRAINER_TEMPERATURE, po::value<double>(&temperature_)->default_value(1.0), "weight of a layout is"\
+                     " exp(-conceded hits / temperature), lower values make the placement less random")
+            (TRAINER_THREADS ",t", po::value<int>(&threads_)->default_value(0), "number of threads, 0 means all cores")
+            (SEED, po::value<std::uint64_t>(&seed_), "base seed, by default a random one is used")
+    ;
+
+    po::positional_options_description positional;
+    positional.add(TRAINER_OUTPUT, 1);
+    po::store(po::command_line_parser(argc, argv).options(description_).positional(positional).run(), used_options_);
+    po::notify(used_options_);
+
+    if (!used_options_.count(SEED))
+        seed_ = Random::randomSeed();
+
+    if (!used_options_.count(HELP))
+        validateOptions();
+}
+
+void battleship::PlacementTrainer::validateOptions()
+{
+    if (!used_options_.count(TRAINER_OUTPUT))
+        throw ArgumentsError("the option '--" TRAINER_OUTPUT "' is required.");
+    if (!StrategyFactory::isStrategyName(player_) || !StrategyFactory::batchPolicy(player_))
+        throw ArgumentsError("the argument ('" + player_ + "') for option '--" PLAYER "' is invalid.");
+    if (!StrategyFactory::isStrategyName(opponent_) || !StrategyFactory::batchPolicy(opponent_))
+        throw ArgumentsError("the argument ('" + opponent_ + "') for option '--" OPPONENT "' is invalid.");
+    if (games_ <= 0)
+        throw ArgumentsError("the argument ('" + std::to_string(games_) + "') for option '--" TRAINER_GAMES "' is invalid.");
+    if (max_rounds_ <= 0 || max_rounds_ > 20)
+        throw ArgumentsError("the argument ('" + std::to_string(max_rounds_) + "') for option '--" ROUNDS "' is invalid.");
+    if (!(temperature_ > 0))
+        throw ArgumentsError("the argument for option '--" TRAINER_TEMPERATURE "' is invalid.");
+    if (threads_ < 0)
+        throw ArgumentsError("the argument ('" + std::to_string(threads_) + "') for option '--" TRAINER_THREADS "' is invalid.");
+}
+
+vector<battleship::PlacementTrainer::LayoutStats> battleship::PlacementTrainer::evaluate(
+        const LockstepSimulation& simulation, std::uint64_t seed, int games, long begin, long end)
+{
+    const auto& layouts = FleetLayouts::instance();
+    vector<FleetLayouts::Layout> fleets;
+    fleets.reserve((end - begin) * games);
+    for (long l = begin; l < end; l++)
+        fleets.insert(fleets.end(), games, layouts.at(l));
+
+    vector<GameState> states;
+    const auto results = simulation.playGames(seed, begin * games, end * games, fleets, states);
+
+    vector<LayoutStats> stats(end - begin);
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        auto& s = stats[i / games];
+        s.survival += results[i].outcome != GO_LOSS;
+        s.conceded += states[i].getHits(0);
+    }
+    for (auto& s : stats)
+    {
+        s.survival /= games;
+        s.conceded /= games;
+    }
+    return stats;
+}
+
+vector<double> battleship::PlacementTrainer::weights(const vector<LayoutStats>& stats, double temperature)
+{
+    if (stats.empty())
+        return {};
+
+    // relative to the best layout, so the weights do not underflow
+    double best = stats.front().conceded;
+    for (auto& s : stats)
+        best = std::min(best, s.conceded);
+
+    vector<double> w;
+    w.reserve(stats.size());
+    for (auto& s : stats)
+        w.push_back(std::exp(-(s.conceded - best) / temperature));
+    return w;
+}
+
+void battleship::PlacementTrainer::run()
+{
+    if (used_options_.count(HELP))
+    {
+        std::cout << description_ << std::endl;
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const long layouts = FleetLayouts::instance().size();
+    const LockstepSimulation simulation(max_rounds_, StrategyFactory::batchPolicy(player_),
+                                        StrategyFactory::batchPolicy(opponent_));
+
+    // a few thousand games in every lockstep batch, workers fill disjoint parts of the statistics
+    vector<LayoutStats> stats(layouts);
+    WorkStealingPool pool(threads_);
+    const long grain = std::max(1, 4096 / games_);
+    pool.parallelFor(layouts, grain, [&](int, long begin, long end) {
+        const auto part = evaluate(simulation, seed_, games_, begin, end);
+        std::copy(part.begin(), part.end(), stats.begin() + begin);
+    });
+
+    const auto w = weights(stats, temperature_);
+    PlacementDistribution::write(output_, w);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // hits conceded by uniform and by trained placement
+    const PlacementDistribution trained(w);
+    double uniform_conceded = 0, trained_conceded = 0, uniform_survival = 0, trained_survival = 0;
+    for (long l = 0; l < layouts; l++)
+    {
+        uniform_conceded += stats[l].conceded / layouts;
+        uniform_survival += stats[l].survival / layouts;
+        trained_conceded += stats[l].conceded * trained.probability(l);
+        trained_survival += stats[l].survival * trained.probability(l);
+    }
+
+    std::cout << "layouts: " << layouts << ", games: " << layouts * games_ << " (" << player_ << " vs "
+              << opponent_ << "), threads: " << pool.size() << ", seed: " << seed_ << '\n'
+              << "uniform placement: " << uniform_conceded << " hits conceded, " << uniform_survival << " survival\n"
+              << "trained placement: " << trained_conceded << " hits conceded, " << trained_survival << " survival\n"
+              << "seconds: " << elapsed.count() << std::endl;
+}
@@ -1,4 +1,6 @@
 #include "Player.h"
+#include "FleetLayouts.h"
+#include "exceptions.h"
 
 using std::pair;
 using std::vector;
@@ -9,7 +11,7 @@ bool battleship::Player::canShoot() const
     bool can_shoot = false;
 
     for (auto& x : primary_grid_.getAllShips())
-        can_shoot |= x.canShoot() && !(secondary_grid_.getAvailableRange(x)->empty());
+        can_shoot |= x.canShoot() && !getUntargetedMask(x).empty();
 
     return can_shoot;
 }
@@ -20,7 +22,7 @@ bool battleship::Player::mayShootNextRounds() const
 
     for (auto& s : primary_grid_.getAllShips())
         may_shoot |= (!s.isSunk()) && (s.canShoot() || s.isPausing())
-                                   && !(secondary_grid_.getAvailableRange(s)->empty());
+                                   && !getUntargetedMask(s).empty();
     return may_shoot;
 }
 
@@ -32,6 +34,33 @@ int battleship::Player::getHits() const
     return hits;
 }
 
+int battleship::Player::getFinishedRounds() const
+{
+    return finished_rounds_;
+}
+
+void battleship::Player::setFinishedRounds(int rounds)
+{
+    finished_rounds_ = rounds;
+}
+
+void battleship::Player::placeRandomFleet(Random& rng)
+{
+    // every legal layout is equally likely
+    placeFleet(FleetLayouts::instance().sample(rng));
+}
+
+void battleship::Player::placeFleet(const FleetLayouts::Layout& layout)
+{
+    const auto& layouts = FleetLayouts::instance();
+    for (int length = Ship::MAX_LENGTH; length > 0; length--)
+    {
+        const auto& p = layouts.getPlacements(length)[layout[length - 1]];
+        if (primary_grid_.tryPlace(p.squares, length) != PS_OK)
+            throw BattleshipLogicError("Player::placeFleet: ships can be set up only on the empty grid.");
+    }
+}
+
 const battleship::ShipsGrid& battleship::Player::getPrimaryGird() const
 {
     return primary_grid_;
@@ -42,9 +71,25 @@ const battleship::Grid& battleship::Player::getSecondaryGrid() const
     return secondary_grid_;
 }
 
+battleship::Bitboard battleship::Player::getUntargetedMask(const Ship& ship) const
+{
+    // let the grid report sunk or not placed ships
+    if (ship.isSunk() || ship.getLength() == 0)
+        return secondary_grid_.getAvailableMask(ship);
+
+    auto& r = ranges_[ship.getLength() - 1];
+    if (r.location != ship.getOccupiedMask())
+    {
+        r.location = ship.getOccupiedMask();
+        r.untargeted = secondary_grid_.getAvailableMask(ship);
+    }
+    return r.untargeted;
+}
+
 void battleship::Player::nextRound()
 {
     primary_grid_.nextRound();
+    finished_rounds_++;
 }
 
 battleship::ShotResult battleship::Player::takeShot(pair<int, int> square)
@@ -55,6 +100,10 @@ battleship::ShotResult battleship::Player::takeShot(pair<int, int> square)
 void battleship::Player::update(pair<int, int> square, battleship::ShotResult result)
 {
     secondary_grid_.update(square, result);
+
+    // the square is no longer available for any ship
+    for (auto& r : ranges_)
+        r.untargeted.reset(square);
 }
 
 void battleship::Player::setUpShips(const vector<int>& single_args,
@@ -77,6 +126,20 @@ void battleship::Player::setUpShips(const vector<int>& single_args,
     primary_grid_.setShipLocation(move(v));
 }
 
+void battleship::Player::restore(const Fleet& fleet, Bitboard opponent_shots, const Grid& secondary_grid,
+                                 const std::vector<int>& pausing_ships)
+{
+    primary_grid_.restore(fleet, opponent_shots);
+    primary_grid_.pauseShips(pausing_ships);
+    secondary_grid_ = secondary_grid;
+    ranges_ = {};
+}
+
+void battleship::Player::restoreShots(const std::array<int, Ship::MAX_LENGTH>& shots)
+{
+    primary_grid_.restoreShots(shots);
+}
+
 void battleship::Player::pauseShips(const std::vector<int>& ships_lengths)
 {
     primary_grid_.pauseShips(ships_lengths);
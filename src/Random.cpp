@@ -0,0 +1,57 @@
+#include "Random.h"
+
+#include <random>
+
+using std::uint64_t;
+
+
+uint64_t battleship::Random::splitmix(uint64_t& x)
+{
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+battleship::Random::Random()
+    : Random(randomSeed())
+{ }
+
+battleship::Random::Random(uint64_t seed, unsigned stream)
+{
+    // splitmix never gives four zero words, which is the only invalid state
+    for (auto& s : state_)
+        s = splitmix(seed);
+    while (stream--)
+        jump();
+}
+
+uint64_t battleship::Random::randomSeed()
+{
+    std::random_device rd;
+    return ((uint64_t)rd() << 32) ^ rd();
+}
+
+uint64_t battleship::Random::deriveSeed(uint64_t seed, uint64_t index)
+{
+    uint64_t x = seed ^ (index * 0xd1b54a32d192ed03ull);
+    return splitmix(x);
+}
+
+void battleship::Random::jump()
+{
+    static const uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    for (auto j : JUMP)
+        for (int b = 0; b < 64; b++)
+        {
+            if (j & (uint64_t(1) << b))
+                for (int i = 0; i < 4; i++)
+                    s[i] ^= state_[i];
+            (*this)();
+        }
+
+    for (int i = 0; i < 4; i++)
+        state_[i] = s[i];
+}
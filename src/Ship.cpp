@@ -1,6 +1,8 @@
 #include "Ship.h"
 #include "exceptions.h"
 
+#include <algorithm>
+
 using std::vector;
 using std::pair;
 using std::unique_ptr;
@@ -32,6 +34,11 @@ int battleship::Ship::getHits() const
     return hits_counter_;
 }
 
+int battleship::Ship::getShots() const
+{
+    return shots_counter_;
+}
+
 bool battleship::Ship::canShoot() const
 {
     return occupied_squares_ && !(is_pausing_ || (shots_counter_ >= MAX_SHOTS[occupied_squares_->size()]) || isSunk());
@@ -53,6 +60,16 @@ unique_ptr<vector<pair<int, int>>> battleship::Ship::getOccupiedSquares() const
     return make_unique<vector<pair<int,int>>>(*occupied_squares_);
 }
 
+battleship::Bitboard battleship::Ship::getOccupiedMask() const
+{
+    return occupied_mask_;
+}
+
+battleship::Bitboard battleship::Ship::getRangeMask() const
+{
+    return range_mask_;
+}
+
 void battleship::Ship::nextRound()
 {
     if (!occupied_squares_)
@@ -80,6 +97,15 @@ void battleship::Ship::pause()
     is_pausing_ = true;
 }
 
+void battleship::Ship::restoreShots(int shots)
+{
+    if (!occupied_squares_)
+        throw BattleshipLogicError("Ship::restoreShots: cannot restore shots before setting location.");
+    if (shots < 0 || shots > MAX_SHOTS[occupied_squares_->size()])
+        throw BattleshipRuntimeError("Ship::restoreShots: wrong number of shots.");
+    shots_counter_ = shots;
+}
+
 void battleship::Ship::setOccupiedSquares(std::unique_ptr<const std::vector<std::pair<int, int>>> occupied_squares)
 {
     // check if passed squares are correct
@@ -88,4 +114,19 @@ void battleship::Ship::setOccupiedSquares(std::unique_ptr<const std::vector<std:
 
     // NOTE: it is ShipsGrid job to make sure that occupied_suqares are correct!
     occupied_squares_ = move(occupied_squares);
+
+    // ship is straight, so its range is the bounding box extended by range in each direction
+    occupied_mask_ = Bitboard();
+    pair<int, int> min_square = occupied_squares_->empty() ? make_pair(0, 0) : occupied_squares_->front();
+    pair<int, int> max_square = min_square;
+    for (auto p : *occupied_squares_)
+    {
+        occupied_mask_ |= Bitboard::rectangle(p.first, p.second, p.first, p.second);
+        min_square = { std::min(min_square.first, p.first), std::min(min_square.second, p.second) };
+        max_square = { std::max(max_square.first, p.first), std::max(max_square.second, p.second) };
+    }
+
+    const int range = getRange();
+    range_mask_ = occupied_squares_->empty() ? Bitboard() : Bitboard::rectangle(
+            min_square.first - range, min_square.second - range, max_square.first + range, max_square.second + range);
 }
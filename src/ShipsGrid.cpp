@@ -1,7 +1,6 @@
 #include "ShipsGrid.h"
 
 #include <algorithm>
-#include <cassert>
 
 using std::unique_ptr;
 using std::vector;
@@ -25,31 +24,31 @@ battleship::ShotResult battleship::ShipsGrid::takeShot(pair<int,int> square)
     if (square.first < 0 || square.second < 0 || square.first >= 10 || square.second >= 10)
         throw InvalidCoordinateError("ShipsGrid::takeShot: square out of allowed range.");
 
-    auto st = table_[square.first][square.second];
+    const int i = Bitboard::toIndex(square);
 
-    if (st == ST_HIT || st == ST_MISS || st == ST_SUNK)
+    if ((hit_plane_ | miss_plane_ | sunk_plane_).test(i))
         throw BattleshipRuntimeError("ShipsGrid::takeShot: already shot at this position.");
 
-    if (st == ST_EMPTY)
+    Ship* s = nullptr;
+    for (int l = 0; l < Ship::MAX_LENGTH; l++)
+        if (ships_planes_[l].test(i))
+            s = &ships_[l];
+
+    if (!s)
     {
-        table_[square.first][square.second] = ST_MISS;
+        miss_plane_.set(i);
         return SR_MISS;
     }
 
-    Ship* s = nullptr;
-    if (st == ST_SINGLE) s = &ships_[0];
-    else if (st == ST_DOUBLE) s = &ships_[1];
-    else if (st == ST_TRIPLE) s = &ships_[2];
-    else assert(false); // s is nullptr;
-
     s->takeShot();
-    table_[square.first][square.second] = ST_HIT;
+    ships_planes_[s->getLength() - 1].reset(i);
+    hit_plane_.set(i);
 
     if (s->isSunk())
     {
-        auto t = *s->getOccupiedSquares();
-        for (auto p : t)
-            table_[p.first][p.second] = ST_SUNK;
+        auto m = s->getOccupiedMask();
+        hit_plane_ &= ~m;
+        sunk_plane_ |= m;
     }
 
     return s->isSunk() ? SR_SUNK : SR_HIT;
@@ -67,54 +66,120 @@ void battleship::ShipsGrid::setShipLocation(unique_ptr<vector<pair<int,int>>> oc
         throw BattleshipRuntimeError("ShipsGrid::setShipLocation:: wrong ship length.");
 
     // sort input
-    std::sort(occupied_squares->begin(), occupied_squares->end(), [](auto& l, auto& r) {
-        return (l.first == r.first) ? (l.second < r.second) : (l.first < r.first);
-    });
+    std::sort(occupied_squares->begin(), occupied_squares->end());
 
-    // check range
-    if (occupied_squares->front().first < 0 || occupied_squares->front().second < 0
-            || occupied_squares->back().first >= 10 || occupied_squares->back().second >= 10)
+    Bitboard mask;
+    switch (checkSortedPlacement(occupied_squares->data(), length, mask))
+    {
+    case PS_OK:
+        break;
+    case PS_WRONG_LENGTH:
+        throw BattleshipRuntimeError("ShipsGrid::setShipLocation:: wrong ship length.");
+    case PS_OUT_OF_RANGE:
         throw InvalidCoordinateError("ShipsGrid::setShipLocation:: square coordinates out of allowed range.");
+    case PS_WRONG_SHAPE:
+        throw InvalidShipLocationError("ShipsGrid::setShipLocation: wrong ship's location shape.");
+    case PS_TOO_CLOSE:
+        throw InvalidShipLocationError("ShipsGrid::setShipLocation: Ship too close to another one.");
+    }
+
+    place(move(occupied_squares), mask);
+}
+
+battleship::PlacementStatus battleship::ShipsGrid::checkPlacement(ShipSquares squares, int length) const
+{
+    if (length <= 0 || length > Ship::MAX_LENGTH)
+        return PS_WRONG_LENGTH;
+
+    std::sort(squares.begin(), squares.begin() + length);
+    Bitboard mask;
+    return checkSortedPlacement(squares.data(), length, mask);
+}
+
+battleship::PlacementStatus battleship::ShipsGrid::tryPlace(ShipSquares squares, int length)
+{
+    if (length <= 0 || length > Ship::MAX_LENGTH)
+        return PS_WRONG_LENGTH;
+
+    std::sort(squares.begin(), squares.begin() + length);
+    Bitboard mask;
+    auto status = checkSortedPlacement(squares.data(), length, mask);
+    if (status == PS_OK)
+        place(std::make_unique<vector<pair<int,int>>>(squares.begin(), squares.begin() + length), mask);
+    return status;
+}
+
+battleship::PlacementStatus battleship::ShipsGrid::checkSortedPlacement(const pair<int,int>* squares, int length,
+                                                                        Bitboard& mask) const
+{
+    const auto& front = squares[0];
+    const auto& back = squares[length - 1];
+
+    // check range
+    if (front.first < 0 || front.second < 0 || back.first >= 10 || back.second >= 10)
+        return PS_OUT_OF_RANGE;
 
     // check if are connected and if shape is correct
-    auto fst = occupied_squares->back().first - occupied_squares->front().first;
-    auto snd = occupied_squares->back().second - occupied_squares->front().second;
-    if ( ((size_t)fst + 1 != length || snd != 0) && (fst != 0 || (size_t)snd + 1 != length) )
-        throw InvalidShipLocationError("ShipsGrid::setShipLocation: wrong ship's location shape.");
+    for (int i = 1; i < length; i++)
+        if (squares[i] == squares[i - 1])
+            return PS_WRONG_SHAPE;
+    auto fst = back.first - front.first;
+    auto snd = back.second - front.second;
+    if ((fst + 1 != length || snd != 0) && (fst != 0 || snd + 1 != length))
+        return PS_WRONG_SHAPE;
+
+    mask = Bitboard();
+    for (int i = 0; i < length; i++)
+        mask.set(squares[i]);
+
+    // check if not too close ot another ship, ship with the same length is going to be moved
+    auto occupied = ~getPlane(ST_EMPTY) & ~ships_planes_[length - 1];
+    if (!(mask.dilate() & occupied).empty())
+        return PS_TOO_CLOSE;
+
+    return PS_OK;
+}
 
-    SquareType st;
-    if (length == 1) st = ST_SINGLE;
-    else if (length == 2) st = ST_DOUBLE;
-    else if (length == 3) st = ST_TRIPLE;
-    else assert(false); // unsuported length of ship
-
-    // check if not too close ot another ship
-    for (auto p : *occupied_squares)
-        for (int a = -1; a <= 1; a++)
-            for (int b = -1; b <= 1; b++)
-            {
-                int x = p.first + a;
-                int y = p.second + b;
-                // make sure x and y don't exceed table_ range
-                x = (x < 0) ? 0 : (x >= 10 ? 9 : x);
-                y = (y < 0) ? 0 : (y >= 10 ? 9 : y);
-
-                if (table_[x][y] != ST_EMPTY && table_[x][y] != st)
-                    throw InvalidShipLocationError("ShipsGrid::setShipLocation: Ship too close to another one.");
-            }
-
-    // clear previous ship's position from table_ if there exists
-    if (ships_[length - 1].getLength() > 0)
+void battleship::ShipsGrid::place(unique_ptr<vector<pair<int,int>>> occupied_squares, Bitboard mask)
+{
+    // clear previous ship's position and set the new one
+    const auto length = occupied_squares->size();
+    ships_planes_[length - 1] = mask;
+    ships_[length - 1].setOccupiedSquares(move(occupied_squares));
+}
+
+void battleship::ShipsGrid::restore(const Fleet& fleet, Bitboard shots)
+{
+    for (auto& s : ships_)
+        if (s.getLength() != 0)
+            throw BattleshipLogicError("ShipsGrid::restore: ships can be restored only on the empty grid.");
+
+    Bitboard all_ships;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
     {
-        auto v = ships_[length - 1].getOccupiedSquares();
-        for (auto x : *v) table_[x.first][x.second] = ST_EMPTY;
+        auto v = std::make_unique<vector<pair<int,int>>>();
+        for (Bitboard m = fleet[l - 1]; !m.empty(); )
+            v->push_back(Bitboard::toSquare(m.popLowest()));
+        if ((int)v->size() != l)
+            throw BattleshipRuntimeError("ShipsGrid::restore: wrong ship length.");
+        setShipLocation(move(v));
+        all_ships |= fleet[l - 1];
     }
 
-    // set position in table_
-    for (auto p : *occupied_squares)
-        table_[p.first][p.second] = st;
-
-    ships_[length - 1].setOccupiedSquares(move(occupied_squares));
+    for (auto& s : ships_)
+    {
+        const auto mask = s.getOccupiedMask();
+        const auto hit = mask & shots;
+        for (int i = hit.count(); i > 0; i--)
+            s.takeShot();
+
+        ships_planes_[s.getLength() - 1] &= ~hit;
+        if (s.isSunk())
+            sunk_plane_ |= mask;
+        else
+            hit_plane_ |= hit;
+    }
+    miss_plane_ = shots & ~all_ships;
 }
 
 void battleship::ShipsGrid::shoot(int ship_length)
@@ -135,6 +200,12 @@ void battleship::ShipsGrid::nextRound()
         x.nextRound();
 }
 
+void battleship::ShipsGrid::restoreShots(const std::array<int, Ship::MAX_LENGTH>& shots)
+{
+    for (int i = 0; i < Ship::MAX_LENGTH; i++)
+        ships_[i].restoreShots(shots[i]);
+}
+
 void battleship::ShipsGrid::pauseShips(const std::vector<int>& ships_lengths)
 {
     if (ships_lengths.size() > ships_.size())
@@ -0,0 +1,28 @@
+#include "ShootStrategy.h"
+
+using std::unique_ptr;
+using std::vector;
+using std::pair;
+using std::unordered_set;
+using std::make_unique;
+
+
+int battleship::ShootStrategy::chooseShip(const ShipsLengths& ships_lengths)
+{
+    return chooseShip(make_unique<vector<int>>(ships_lengths.begin(), ships_lengths.end()));
+}
+
+pair<int,int> battleship::ShootStrategy::chooseSquare(const SquareSet& squares)
+{
+    return chooseSquare(make_unique<unordered_set<pair<int,int>, SquareHash>>(squares.begin(), squares.end()));
+}
+
+int battleship::ShootStrategy::chooseShip(const ShipsLengths& ships_lengths, const Player&)
+{
+    return chooseShip(ships_lengths);
+}
+
+pair<int,int> battleship::ShootStrategy::chooseSquare(const SquareSet& squares, const Player&)
+{
+    return chooseSquare(squares);
+}
@@ -0,0 +1,263 @@
+#include "ShotBatch.h"
+#include "Bitboard.h"
+#include "exceptions.h"
+
+// the AVX2 version is compiled with a target attribute, so the rest of the program does not require AVX2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATTLESHIP_AVX2_BATCH
+#include <immintrin.h>
+#endif
+
+using std::size_t;
+using std::uint64_t;
+
+namespace
+{
+    // decision of a single game, the same calls of the generator as RandomStrategy and GreedyStrategy make
+    void scalarShot(battleship::ShotBatch& b, size_t g, battleship::BatchShipChoice choice)
+    {
+        const auto ships = b.ships[g];
+        if (ships == 0)
+        {
+            b.ship_length[g] = 0;
+            b.square[g] = 0;
+            return;
+        }
+
+        auto rng = b.getRandom(g);
+        int length = 0;
+        if (choice == battleship::BSC_RANDOM)
+        {
+            int lengths[battleship::Ship::MAX_LENGTH];
+            int n = 0;
+            for (int l = 1; l <= battleship::Ship::MAX_LENGTH; l++)
+                if (ships & (1 << (l - 1)))
+                    lengths[n++] = l;
+            length = lengths[rng.below(n)];
+        }
+        else
+            for (int l = 1; l <= battleship::Ship::MAX_LENGTH; l++)
+                if (ships & (1 << (l - 1)))
+                    length = l;
+
+        const battleship::Bitboard untargeted(b.untargeted_low[length - 1][g], b.untargeted_high[length - 1][g]);
+        b.square[g] = untargeted.nth(rng.below(untargeted.count()));
+        b.ship_length[g] = length;
+        b.setRandom(g, rng);
+    }
+
+#ifdef BATTLESHIP_AVX2_BATCH
+    // four games in the lanes of 256-bit registers
+
+    __attribute__((target("avx2")))
+    inline __m256i popcount(__m256i v)
+    {
+        // counts of nibbles from a table, bytes are summed in every lane
+        const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        const __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+        const __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi64(v, 4), nibble));
+        return _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+    }
+
+    template<int K>
+    __attribute__((target("avx2")))
+    inline __m256i rotl(__m256i x)
+    {
+        return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K));
+    }
+
+    // Random::operator() of four generators
+    __attribute__((target("avx2")))
+    inline __m256i next(__m256i s[4])
+    {
+        const __m256i times5 = _mm256_add_epi64(_mm256_slli_epi64(s[1], 2), s[1]);
+        const __m256i rotated = rotl<7>(times5);
+        const __m256i result = _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated);
+        const __m256i t = _mm256_slli_epi64(s[1], 17);
+
+        s[2] = _mm256_xor_si256(s[2], s[0]);
+        s[3] = _mm256_xor_si256(s[3], s[1]);
+        s[1] = _mm256_xor_si256(s[1], s[2]);
+        s[0] = _mm256_xor_si256(s[0], s[3]);
+        s[2] = _mm256_xor_si256(s[2], t);
+        s[3] = rotl<45>(s[3]);
+        return result;
+    }
+
+    // Random::below without the rare second draw, lanes which need it are marked in rejected
+    __attribute__((target("avx2")))
+    inline __m256i below(__m256i s[4], __m256i bound, __m256i& rejected)
+    {
+        const __m256i m = _mm256_mul_epu32(_mm256_srli_epi64(next(s), 32), bound);
+        const __m256i low = _mm256_and_si256(m, _mm256_set1_epi64x(0xffffffff));
+        rejected = _mm256_or_si256(rejected, _mm256_cmpgt_epi64(bound, low));
+        return _mm256_srli_epi64(m, 32);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i greaterOrEqual(__m256i a, __m256i b)
+    {
+        return _mm256_xor_si256(_mm256_cmpgt_epi64(b, a), _mm256_set1_epi64x(-1));
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i load(const std::vector<uint64_t>& v, size_t g)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.data() + g));
+    }
+
+    __attribute__((target("avx2")))
+    inline void store(std::vector<uint64_t>& v, size_t g, __m256i x)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(v.data() + g), x);
+    }
+
+    // games [g, g + 4), false when some game needs the second draw and has to be decided by scalarShot
+    __attribute__((target("avx2")))
+    bool avx2Shots(battleship::ShotBatch& b, size_t g, battleship::BatchShipChoice choice)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi64x(1);
+        const __m256i ships = load(b.ships, g);
+        const __m256i active = _mm256_xor_si256(_mm256_cmpeq_epi64(ships, zero), _mm256_set1_epi64x(-1));
+
+        __m256i s[4];
+        for (int i = 0; i < 4; i++)
+            s[i] = load(b.rng[i], g);
+        __m256i rejected = zero;
+
+        // lengths are 1, 2 or 3, comparisons give -1 for true
+        __m256i length;
+        if (choice == battleship::BSC_RANDOM)
+        {
+            // the idx-th ship which can shoot
+            const __m256i n = _mm256_add_epi64(_mm256_and_si256(ships, one),
+                    _mm256_add_epi64(_mm256_and_si256(_mm256_srli_epi64(ships, 1), one),
+                                     _mm256_and_si256(_mm256_srli_epi64(ships, 2), one)));
+            const __m256i idx = below(s, n, rejected);
+            __m256i mask = ships;
+            for (int k = 0; k < battleship::Ship::MAX_LENGTH - 1; k++)
+            {
+                const __m256i skip = _mm256_cmpgt_epi64(idx, _mm256_set1_epi64x(k));
+                mask = _mm256_blendv_epi8(mask, _mm256_and_si256(mask, _mm256_sub_epi64(mask, one)), skip);
+            }
+            const __m256i bit = _mm256_and_si256(mask, _mm256_sub_epi64(zero, mask));
+            length = _mm256_sub_epi64(_mm256_sub_epi64(one, _mm256_cmpgt_epi64(bit, one)),
+                                      _mm256_cmpgt_epi64(bit, _mm256_set1_epi64x(2)));
+        }
+        else
+            length = _mm256_sub_epi64(_mm256_sub_epi64(one, _mm256_cmpgt_epi64(ships, one)),
+                                      _mm256_cmpgt_epi64(ships, _mm256_set1_epi64x(3)));
+
+        const __m256i is1 = _mm256_cmpeq_epi64(length, one);
+        const __m256i is2 = _mm256_cmpeq_epi64(length, _mm256_set1_epi64x(2));
+        const __m256i low = _mm256_blendv_epi8(_mm256_blendv_epi8(load(b.untargeted_low[2], g),
+                                                                  load(b.untargeted_low[1], g), is2),
+                                               load(b.untargeted_low[0], g), is1);
+        const __m256i high = _mm256_blendv_epi8(_mm256_blendv_epi8(load(b.untargeted_high[2], g),
+                                                                   load(b.untargeted_high[1], g), is2),
+                                                load(b.untargeted_high[0], g), is1);
+
+        // the r-th untargeted square: the word first and then halves of the word
+        const __m256i low_count = popcount(low);
+        __m256i r = below(s, _mm256_add_epi64(low_count, popcount(high)), rejected);
+        const __m256i in_high = greaterOrEqual(r, low_count);
+        __m256i word = _mm256_blendv_epi8(low, high, in_high);
+        r = _mm256_sub_epi64(r, _mm256_and_si256(low_count, in_high));
+        __m256i square = _mm256_and_si256(_mm256_set1_epi64x(64), in_high);
+        for (int shift = 32; shift > 0; shift /= 2)
+        {
+            const __m256i count = popcount(_mm256_and_si256(word, _mm256_set1_epi64x((uint64_t(1) << shift) - 1)));
+            const __m256i up = greaterOrEqual(r, count);
+            r = _mm256_sub_epi64(r, _mm256_and_si256(count, up));
+            word = _mm256_blendv_epi8(word, _mm256_srlv_epi64(word, _mm256_set1_epi64x(shift)), up);
+            square = _mm256_add_epi64(square, _mm256_and_si256(_mm256_set1_epi64x(shift), up));
+        }
+
+        if (!_mm256_testz_si256(rejected, active))
+            return false;
+
+        // skipped games keep their generators
+        for (int i = 0; i < 4; i++)
+            store(b.rng[i], g, _mm256_blendv_epi8(load(b.rng[i], g), s[i], active));
+        alignas(32) uint64_t lengths[4];
+        alignas(32) uint64_t squares[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lengths), _mm256_and_si256(length, active));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(squares), _mm256_and_si256(square, active));
+        for (int i = 0; i < 4; i++)
+        {
+            b.ship_length[g + i] = lengths[i];
+            b.square[g + i] = squares[i];
+        }
+        return true;
+    }
+#endif
+}
+
+
+battleship::ShotBatch::ShotBatch(size_t games)
+{
+    resize(games);
+}
+
+size_t battleship::ShotBatch::size() const
+{
+    return ships.size();
+}
+
+void battleship::ShotBatch::resize(size_t games)
+{
+    ships.resize(games);
+    for (int l = 0; l < Ship::MAX_LENGTH; l++)
+    {
+        untargeted_low[l].resize(games);
+        untargeted_high[l].resize(games);
+    }
+    for (auto& words : rng)
+        words.resize(games);
+    ship_length.resize(games);
+    square.resize(games);
+}
+
+battleship::Random battleship::ShotBatch::getRandom(size_t game) const
+{
+    Random r(0);
+    r.setState({{ rng[0][game], rng[1][game], rng[2][game], rng[3][game] }});
+    return r;
+}
+
+void battleship::ShotBatch::setRandom(size_t game, const Random& random)
+{
+    const auto state = random.getState();
+    for (int i = 0; i < 4; i++)
+        rng[i][game] = state[i];
+}
+
+bool battleship::ShotBatch::hasAvx2()
+{
+#ifdef BATTLESHIP_AVX2_BATCH
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+void battleship::ShotBatch::chooseRandomShots(BatchShipChoice choice, BatchIsa isa)
+{
+    if (isa == BI_AVX2 && !hasAvx2())
+        throw BattleshipRuntimeError("ShotBatch::chooseRandomShots: AVX2 is not available.");
+
+    size_t g = 0;
+#ifdef BATTLESHIP_AVX2_BATCH
+    if (isa != BI_SCALAR && hasAvx2())
+        for (; g + 4 <= size(); g += 4)
+            if (!avx2Shots(*this, g, choice))
+                for (size_t i = g; i < g + 4; i++)
+                    scalarShot(*this, i, choice);
+#endif
+    for (; g < size(); g++)
+        scalarShot(*this, g, choice);
+}
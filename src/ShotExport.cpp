@@ -0,0 +1,209 @@
+#include "ShotExport.h"
+#include "Bitboard.h"
+#include "exceptions.h"
+
+using std::uint64_t;
+using std::size_t;
+using std::string;
+
+const std::uint32_t battleship::ShotExport::MAGIC;
+const std::uint32_t battleship::ShotExport::VERSION;
+const std::uint32_t battleship::ShotExport::COLUMNS;
+const std::size_t battleship::ShotExport::BLOCK_ROWS;
+
+namespace
+{
+    // columns in order of the file
+    template<typename Columns, typename F>
+    void forEachColumn(Columns& c, F f)
+    {
+        f(c.game);
+        f(c.round);
+        f(c.player);
+        f(c.ship);
+        f(c.square);
+        f(c.result);
+        f(c.range);
+    }
+
+    const char* resultName(int result)
+    {
+        switch (result)
+        {
+        case battleship::SR_HIT: return "hit";
+        case battleship::SR_SUNK: return "sunk";
+        default: return "miss";
+        }
+    }
+}
+
+
+size_t battleship::ShotColumns::size() const
+{
+    return game.size();
+}
+
+void battleship::ShotColumns::clear()
+{
+    forEachColumn(*this, [](auto& v) { v.clear(); });
+}
+
+void battleship::ShotColumns::resize(std::size_t rows)
+{
+    forEachColumn(*this, [rows](auto& v) { v.resize(rows); });
+}
+
+void battleship::ShotExport::writeCsv(const std::string& path, std::ostream& out)
+{
+    ShotExportReader reader(path);
+    ShotColumns block;
+    out << "game,round,player,ship,square,result,range\n";
+    while (reader.next(block))
+        for (size_t i = 0; i < block.size(); i++)
+            out << block.game[i] << ',' << int(block.round[i]) << ',' << int(block.player[i]) << ','
+                << int(block.ship[i]) << ',' << int(block.square[i]) << ',' << resultName(block.result[i]) << ','
+                << int(block.range[i]) << '\n';
+}
+
+battleship::ShotExportWriter::ShotExportWriter(const std::string& path, std::uint64_t seed)
+    : path_(path)
+{
+    ShotExport::Header h {};
+    h.magic = ShotExport::MAGIC;
+    h.version = ShotExport::VERSION;
+    h.columns = ShotExport::COLUMNS;
+    h.seed = seed;
+
+    file_.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    try
+    {
+        file_.open(path, std::ios_base::binary | std::ios_base::trunc);
+        file_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("ShotExportWriter: cannot write file '" + path + "'.");
+    }
+}
+
+void battleship::ShotExportWriter::writeBlock(const ShotColumns& block)
+{
+    if (block.size() == 0)
+        return;
+    if (block.size() > ShotExport::BLOCK_ROWS)
+        throw BattleshipLogicError("ShotExportWriter::writeBlock: block has more than BLOCK_ROWS rows.");
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    try
+    {
+        const uint64_t rows = block.size();
+        file_.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+        forEachColumn(block, [this](const auto& v)
+        {
+            file_.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(v[0]));
+        });
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("ShotExportWriter: cannot write file '" + path_ + "'.");
+    }
+}
+
+void battleship::ShotExportWriter::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    try
+    {
+        file_.flush();
+    }
+    catch (const std::ios_base::failure&)
+    {
+        throw BattleshipRuntimeError("ShotExportWriter: cannot write file '" + path_ + "'.");
+    }
+}
+
+battleship::ShotExportBuffer::ShotExportBuffer(ShotExportWriter& writer)
+    : writer_(writer)
+{
+    columns_.resize(ShotExport::BLOCK_ROWS);
+}
+
+battleship::ShotExportBuffer::~ShotExportBuffer()
+{
+    try
+    {
+        flush();
+    }
+    catch (const BattleshipRuntimeError&) { }
+}
+
+void battleship::ShotExportBuffer::setGame(std::uint64_t game)
+{
+    game_ = game;
+}
+
+void battleship::ShotExportBuffer::shot(int player, int round, const Player& shooter, int ship,
+                                        std::pair<int, int> square, ShotResult result)
+{
+    if (ship < 1 || ship > Ship::MAX_LENGTH)
+        throw BattleshipLogicError("ShotExportBuffer::shot: ship length out of range.");
+
+    // columns are allocated for the whole block, so a shot is only stored
+    columns_.game[rows_] = game_;
+    columns_.round[rows_] = round;
+    columns_.player[rows_] = player;
+    columns_.ship[rows_] = ship;
+    columns_.square[rows_] = Bitboard::toIndex(square);
+    columns_.result[rows_] = result;
+    columns_.range[rows_] = shooter.getUntargetedMask(shooter.getPrimaryGird().getShip(ship)).count();
+
+    if (++rows_ == ShotExport::BLOCK_ROWS)
+        flush();
+}
+
+void battleship::ShotExportBuffer::flush()
+{
+    // shrinking and growing back keeps the memory of the columns
+    columns_.resize(rows_);
+    rows_ = 0;
+    writer_.writeBlock(columns_);
+    columns_.resize(ShotExport::BLOCK_ROWS);
+}
+
+battleship::ShotExportReader::ShotExportReader(const std::string& path)
+    : path_(path)
+    , file_(path, std::ios_base::binary)
+    , header_()
+{
+    file_.read(reinterpret_cast<char*>(&header_), sizeof(header_));
+    if (!file_ || header_.magic != ShotExport::MAGIC)
+        throw BattleshipRuntimeError("ShotExportReader: file '" + path + "' is not a shot export.");
+    if (header_.version != ShotExport::VERSION || header_.columns != ShotExport::COLUMNS)
+        throw BattleshipRuntimeError("ShotExportReader: unsupported shot export version in file '" + path + "'.");
+}
+
+const battleship::ShotExport::Header& battleship::ShotExportReader::header() const
+{
+    return header_;
+}
+
+bool battleship::ShotExportReader::next(ShotColumns& block)
+{
+    uint64_t rows = 0;
+    file_.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    if (file_.gcount() == 0 && file_.eof())
+        return false;
+    if (!file_ || rows > ShotExport::BLOCK_ROWS)
+        throw BattleshipRuntimeError("ShotExportReader: file '" + path_ + "' is truncated.");
+
+    bool ok = true;
+    forEachColumn(block, [&](auto& v)
+    {
+        v.resize(rows);
+        file_.read(reinterpret_cast<char*>(v.data()), rows * sizeof(v[0]));
+        ok = ok && file_;
+    });
+    if (!ok)
+        throw BattleshipRuntimeError("ShotExportReader: file '" + path_ + "' is truncated.");
+    return true;
+}
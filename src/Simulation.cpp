@@ -0,0 +1,36 @@
+#include "Simulation.h"
+
+void battleship::SimulationStats::add(const GameResult& result)
+{
+    if (result.outcome == GO_WIN) wins++;
+    else if (result.outcome == GO_DRAW) draws++;
+    else losses++;
+    rounds += result.rounds;
+}
+
+void battleship::SimulationStats::merge(const SimulationStats& other)
+{
+    wins += other.wins;
+    draws += other.draws;
+    losses += other.losses;
+    rounds += other.rounds;
+}
+
+long battleship::SimulationStats::games() const
+{
+    return wins + draws + losses;
+}
+
+double battleship::SimulationStats::averageRounds() const
+{
+    return games() ? (double)rounds / games() : 0.0;
+}
+
+battleship::Simulation::Simulation(int max_rounds)
+    : max_rounds_(max_rounds)
+{ }
+
+battleship::GameResult battleship::Simulation::playGame(Player& main, Player& opponent) const
+{
+    return playStaticGame(main, opponent);
+}
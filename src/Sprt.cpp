@@ -0,0 +1,141 @@
+#include "Sprt.h"
+#include "exceptions.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    // score of the first strategy in a game
+    int halfPoints(battleship::GameOutcome outcome)
+    {
+        return outcome == battleship::GO_WIN ? 2 : (outcome == battleship::GO_DRAW ? 1 : 0);
+    }
+
+    // scores 0 and 1 have infinite Elo, the interval stays finite
+    const double MAX_ELO = 1000;
+}
+
+
+battleship::Sprt::Sprt(double elo0, double elo1, double alpha, double beta)
+    : elo0_(elo0)
+    , elo1_(elo1)
+    , alpha_(alpha)
+    , beta_(beta)
+{
+    if (!(elo0 < elo1))
+        throw BattleshipLogicError("Sprt: elo0 must be lower than elo1.");
+    if (!(alpha > 0 && alpha < 1) || !(beta > 0 && beta < 1))
+        throw BattleshipLogicError("Sprt: error rates must be between 0 and 1.");
+}
+
+void battleship::Sprt::addPair(GameOutcome first, GameOutcome second)
+{
+    pentanomial_[halfPoints(first) + halfPoints(second)]++;
+}
+
+void battleship::Sprt::merge(const Sprt& other)
+{
+    for (int i = 0; i < 5; i++)
+        pentanomial_[i] += other.pentanomial_[i];
+}
+
+long battleship::Sprt::pairs() const
+{
+    long n = 0;
+    for (auto c : pentanomial_)
+        n += c;
+    return n;
+}
+
+const std::array<long, 5>& battleship::Sprt::getPentanomial() const
+{
+    return pentanomial_;
+}
+
+double battleship::Sprt::score() const
+{
+    const long n = pairs();
+    if (n == 0)
+        return 0.5;
+    double sum = 0;
+    for (int i = 0; i < 5; i++)
+        sum += pentanomial_[i] * i / 4.0;
+    return sum / n;
+}
+
+double battleship::Sprt::scoreVariance() const
+{
+    // one virtual pair with the lowest and one with the highest score keep the variance of the first
+    // pairs from being zero, pairs of equal strategies often all score 1/2
+    const long n = pairs();
+    if (n == 0)
+        return 0;
+    auto counts = pentanomial_;
+    counts[0]++;
+    counts[4]++;
+    double mean = 0;
+    for (int i = 0; i < 5; i++)
+        mean += counts[i] * i / 4.0;
+    mean /= n + 2;
+    double sum = 0;
+    for (int i = 0; i < 5; i++)
+        sum += counts[i] * (i / 4.0 - mean) * (i / 4.0 - mean);
+    return sum / (n + 2) / n;
+}
+
+double battleship::Sprt::elo() const
+{
+    return scoreToElo(score());
+}
+
+std::pair<double, double> battleship::Sprt::eloInterval() const
+{
+    const double margin = 1.959964 * std::sqrt(scoreVariance());
+    return { scoreToElo(score() - margin), scoreToElo(score() + margin) };
+}
+
+double battleship::Sprt::llr() const
+{
+    // normal approximation: N (s1 - s0) (2 mean - s0 - s1) / (2 variance of a pair)
+    const double variance = scoreVariance();
+    if (variance <= 0)
+        return 0;
+    const double s0 = eloToScore(elo0_);
+    const double s1 = eloToScore(elo1_);
+    return (s1 - s0) * (2 * score() - s0 - s1) / (2 * variance);
+}
+
+double battleship::Sprt::lowerBound() const
+{
+    return std::log(beta_ / (1 - alpha_));
+}
+
+double battleship::Sprt::upperBound() const
+{
+    return std::log((1 - beta_) / alpha_);
+}
+
+battleship::SprtDecision battleship::Sprt::decision() const
+{
+    const double l = llr();
+    if (l >= upperBound())
+        return SD_ACCEPT_H1;
+    if (l <= lowerBound())
+        return SD_ACCEPT_H0;
+    return SD_CONTINUE;
+}
+
+double battleship::Sprt::eloToScore(double elo)
+{
+    return 1 / (1 + std::pow(10.0, -elo / 400));
+}
+
+double battleship::Sprt::scoreToElo(double score)
+{
+    if (score <= 0)
+        return -MAX_ELO;
+    if (score >= 1)
+        return MAX_ELO;
+    return std::max(-MAX_ELO, std::min(MAX_ELO, -400 * std::log10(1 / score - 1)));
+}
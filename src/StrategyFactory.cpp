@@ -0,0 +1,61 @@
+#include "StrategyFactory.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+#include "DensityStrategy.h"
+#include "MonteCarloStrategy.h"
+#include "OpeningBookStrategy.h"
+#include "GameLogic.h"
+#include "exceptions.h"
+
+using std::string;
+using std::unique_ptr;
+using std::make_unique;
+
+
+bool battleship::StrategyFactory::isStrategyName(const string& name)
+{
+    return name.compare(RANDOM) == 0 || name.compare(GREEDY) == 0 || name.compare(DENSITY) == 0
+            || name.compare(MONTE_CARLO) == 0;
+}
+
+unique_ptr<battleship::ShootStrategy> battleship::StrategyFactory::create(const string& name)
+{
+    return create(name, Random());
+}
+
+unique_ptr<battleship::ShootStrategy> battleship::StrategyFactory::create(const string& name, Random rng)
+{
+    return create(name, rng, StrategyOptions());
+}
+
+unique_ptr<battleship::ShootStrategy> battleship::StrategyFactory::create(const string& name, Random rng,
+                                                                          const StrategyOptions& options)
+{
+    if (options.opening_book)
+    {
+        auto without_book = options;
+        without_book.opening_book.reset();
+        return make_unique<OpeningBookStrategy>(options.opening_book, create(name, rng, without_book));
+    }
+
+    if (name.compare(RANDOM) == 0)
+        return make_unique<RandomStrategy>(rng);
+    if (name.compare(GREEDY) == 0)
+        return make_unique<GreedyStrategy>(rng);
+    if (name.compare(DENSITY) == 0)
+        return make_unique<DensityStrategy>(rng);
+    if (name.compare(MONTE_CARLO) == 0)
+        return make_unique<MonteCarloStrategy>(rng, options);
+    throw ArgumentsError("unknown strategy: '" + name + "'.");
+}
+
+battleship::BatchPolicy battleship::StrategyFactory::batchPolicy(const string& name)
+{
+    if (name.compare(RANDOM) == 0)
+        return &RandomStrategy::chooseShots;
+    if (name.compare(GREEDY) == 0)
+        return &GreedyStrategy::chooseShots;
+    if (!isStrategyName(name))
+        throw ArgumentsError("unknown strategy: '" + name + "'.");
+    return nullptr;
+}
@@ -0,0 +1,360 @@
+#include "Tournament.h"
+#include "GameLogic.h"
+#include "AIPlayer.h"
+#include "StaticAIPlayer.h"
+#include "LockstepSimulation.h"
+#include "Sprt.h"
+#include "StrategyFactory.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+#include "DensityStrategy.h"
+#include "MonteCarloStrategy.h"
+#include "exceptions.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace po = boost::program_options;
+using std::string;
+using std::vector;
+
+namespace
+{
+    // calls f with a null pointer to the strategy with given name, so f can be instantiated for its type
+    template<typename F>
+    battleship::GameResult withStrategyType(const string& name, F f)
+    {
+        if (name.compare(RANDOM) == 0)
+            return f(static_cast<battleship::RandomStrategy*>(nullptr));
+        if (name.compare(GREEDY) == 0)
+            return f(static_cast<battleship::GreedyStrategy*>(nullptr));
+        if (name.compare(DENSITY) == 0)
+            return f(static_cast<battleship::DensityStrategy*>(nullptr));
+        if (name.compare(MONTE_CARLO) == 0)
+            return f(static_cast<battleship::MonteCarloStrategy*>(nullptr));
+        throw battleship::ArgumentsError("unknown strategy: '" + name + "'.");
+    }
+
+    // result of the same game from the other player's point of view
+    battleship::GameOutcome reversed(battleship::GameOutcome outcome)
+    {
+        return outcome == battleship::GO_WIN ? battleship::GO_LOSS
+                                             : (outcome == battleship::GO_LOSS ? battleship::GO_WIN : battleship::GO_DRAW);
+    }
+}
+
+
+battleship::Tournament::Tournament(int argc, char** argv)
+    : description_("Allowed options")
+{
+    description_.add_options()
+            (HELP ",h", "produce help message")
+            (TOURNAMENT_GAMES ",g", po::value<int>(&games_)->default_value(100000), "number of games to play")
+            (ROUNDS ",r", po::value<int>(&max_rounds_)->default_value(20), "set max rounds number, (>0), (<=20)")
+            (PLAYER ",p", po::value<string>(&player_)->default_value(GREEDY), "set player type: 'greedy', 'random', 'density',"\
+                     " 'montecarlo'")
+            (OPPONENT ",o", po::value<string>(&opponent_)->default_value(RANDOM), "set opponent type: 'greedy', 'random', 'density',"\
+                     " 'montecarlo'")
+            (TOURNAMENT_THREADS ",t", po::value<int>(&threads_)->default_value(0), "number of threads, 0 means all cores")
+            (THINK_MS, po::value<int>(&think_ms_)->default_value(100), "time in milliseconds for a single decision of"\
+                     " 'montecarlo' player, its search runs on the thread of the game")
+            (ENDGAME_SQUARES, po::value<int>(&endgame_squares_)->default_value(12), "'montecarlo' player solves the game"\
+                     " exactly when at most this many squares in range of ships are left, 0 turns it off")
+            (OPENING_BOOK, po::value<string>(), "file made by battleship_opening_book, both players take their first"\
+                     " turn from it")
+            (PLACEMENT, po::value<string>(), "file made by battleship_placement_trainer, the main player places its"\
+                     " ships from it")
+            (SEED, po::value<std::uint64_t>(&seed_), "base seed, by default a random one is used")
+            (TOURNAMENT_SCALING, "play the games with 1, 2, 4, ... threads and print the scaling report")
+            (TOURNAMENT_REPLAY, po::value<long>(), "play only the game with given index and print its result")
+            (TOURNAMENT_SPRT, "play pairs of games with swapped colours until the sequential probability ratio test"\
+                     " decides whether player is better than opponent, '--" TOURNAMENT_GAMES "' is the most games played")
+            (TOURNAMENT_ELO0, po::value<double>(&elo0_)->default_value(0), "Elo difference of the null hypothesis")
+            (TOURNAMENT_ELO1, po::value<double>(&elo1_)->default_value(5), "Elo difference of the alternative"\
+                     " hypothesis, it must be greater than '--" TOURNAMENT_ELO0 "'")
+            (TOURNAMENT_ALPHA, po::value<double>(&alpha_)->default_value(0.05), "probability of accepting the"\
+                     " alternative hypothesis when the null one holds")
+            (TOURNAMENT_BETA, po::value<double>(&beta_)->default_value(0.05), "probability of accepting the null"\
+                     " hypothesis when the alternative one holds")
+    ;
+
+    po::store(po::parse_command_line(argc, argv, description_), used_options_);
+    po::notify(used_options_);
+
+    if (!used_options_.count(SEED))
+        seed_ = Random::randomSeed();
+
+    if (!used_options_.count(HELP))
+        validateOptions();
+    if (used_options_.count(OPENING_BOOK))
+        opening_book_ = std::make_shared<MappedOpeningBook>(used_options_[OPENING_BOOK].as<string>());
+    if (used_options_.count(PLACEMENT))
+        placement_ = std::make_shared<PlacementDistribution>(PlacementDistribution::load(used_options_[PLACEMENT].as<string>()));
+}
+
+void battleship::Tournament::validateOptions()
+{
+    if (games_ <= 0)
+        throw ArgumentsError("the argument ('" + std::to_string(games_) + "') for option '--" TOURNAMENT_GAMES "' is invalid.");
+    if (max_rounds_ <= 0 || max_rounds_ > 20)
+        throw ArgumentsError("the argument ('" + std::to_string(max_rounds_) + "') for option '--" ROUNDS "' is invalid.");
+    if (!StrategyFactory::isStrategyName(player_))
+        throw ArgumentsError("the argument ('" + player_ + "') for option '--" PLAYER "' is invalid.");
+    if (!StrategyFactory::isStrategyName(opponent_))
+        throw ArgumentsError("the argument ('" + opponent_ + "') for option '--" OPPONENT "' is invalid.");
+    if (threads_ < 0)
+        throw ArgumentsError("the argument ('" + std::to_string(threads_) + "') for option '--" TOURNAMENT_THREADS "' is invalid.");
+    if (think_ms_ <= 0)
+        throw ArgumentsError("the argument ('" + std::to_string(think_ms_) + "') for option '--" THINK_MS "' is invalid.");
+    if (endgame_squares_ < 0)
+        throw ArgumentsError("the argument ('" + std::to_string(endgame_squares_) + "') for option '--" ENDGAME_SQUARES "' is invalid.");
+    if (used_options_.count(TOURNAMENT_REPLAY) && used_options_[TOURNAMENT_REPLAY].as<long>() < 0)
+        throw ArgumentsError("the argument for option '--" TOURNAMENT_REPLAY "' is invalid.");
+    if (!(elo0_ < elo1_))
+        throw ArgumentsError("the argument for option '--" TOURNAMENT_ELO1 "' must be greater than '--" TOURNAMENT_ELO0 "'.");
+    if (!(alpha_ > 0 && alpha_ < 1))
+        throw ArgumentsError("the argument for option '--" TOURNAMENT_ALPHA "' is invalid.");
+    if (!(beta_ > 0 && beta_ < 1))
+        throw ArgumentsError("the argument for option '--" TOURNAMENT_BETA "' is invalid.");
+    if (used_options_.count(TOURNAMENT_SPRT) && games_ < 2)
+        throw ArgumentsError("option '--" TOURNAMENT_SPRT "' needs at least two games.");
+}
+
+battleship::GameResult battleship::Tournament::playGame(long index) const
+{
+    return playGame(index, player_, opponent_, false);
+}
+
+battleship::GameResult battleship::Tournament::playSwappedGame(long index) const
+{
+    return playGame(index, opponent_, player_, true);
+}
+
+battleship::GameResult battleship::Tournament::playGame(long index, const string& main_type, const string& opponent_type,
+                                                        bool swapped) const
+{
+    const auto seed = Random::deriveSeed(seed_, index);
+    // games already run on all threads, so searching players do not start threads of their own
+    StrategyOptions options;
+    options.think_ms = think_ms_;
+    options.endgame_squares = endgame_squares_;
+    options.opening_book = opening_book_;
+    options.threads = 1;
+    options.max_rounds = max_rounds_;
+
+    // the book wraps strategies at run time, other games are played without virtual calls
+    // static players place ships uniformly
+    if (!opening_book_ && !placement_)
+        return withStrategyType(main_type, [&](auto* m)
+        {
+            return withStrategyType(opponent_type, [&](auto* o)
+            {
+                StaticAIPlayer<std::remove_pointer_t<decltype(m)>> main(Random(seed, 1), options, Random(seed, 0));
+                auto opponent_options = options;
+                opponent_options.moves_first = false;
+                StaticAIPlayer<std::remove_pointer_t<decltype(o)>> opponent(Random(seed, 3), opponent_options,
+                                                                            Random(seed, 2));
+                main.setUpShips();
+                opponent.setUpShips();
+                return Simulation(max_rounds_).playStaticGame(main, opponent);
+            });
+        });
+
+    // the trained placement belongs to the player
+    AIPlayer main(StrategyFactory::create(main_type, Random(seed, 1), options), Random(seed, 0),
+                  swapped ? nullptr : placement_);
+    options.moves_first = false;
+    AIPlayer opponent(StrategyFactory::create(opponent_type, Random(seed, 3), options), Random(seed, 2),
+                      swapped ? placement_ : nullptr);
+    main.setUpShips();
+    opponent.setUpShips();
+    return Simulation(max_rounds_).playGame(main, opponent);
+}
+
+battleship::SimulationStats battleship::Tournament::playGames(WorkStealingPool& pool, double& seconds) const
+{
+    // padding keeps statistics of different workers in separate cache lines
+    struct WorkerStats
+    {
+        SimulationStats stats;
+        char padding[64];
+    };
+    vector<WorkerStats> workers(pool.size());
+
+    // strategies with batched versions play thousands of games in lockstep, results are the same as of playGame
+    const bool uniform = !opening_book_ && !placement_;
+    const auto main_policy = uniform ? StrategyFactory::batchPolicy(player_) : nullptr;
+    const auto opponent_policy = uniform ? StrategyFactory::batchPolicy(opponent_) : nullptr;
+
+    auto start = std::chrono::steady_clock::now();
+    if (main_policy && opponent_policy)
+    {
+        const LockstepSimulation lockstep(max_rounds_, main_policy, opponent_policy);
+        pool.parallelFor(games_, LOCKSTEP_GAMES, [&](int worker, long begin, long end) {
+            auto& stats = workers[worker].stats;
+            for (const auto& result : lockstep.playGames(seed_, begin, end))
+                stats.add(result);
+        });
+    }
+    else
+        pool.parallelFor(games_, 256, [&](int worker, long begin, long end) {
+            auto& stats = workers[worker].stats;
+            for (long i = begin; i < end; i++)
+                stats.add(playGame(i));
+        });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    seconds = elapsed.count();
+
+    // all workers are idle now, so statistics can be merged without synchronization
+    SimulationStats total;
+    for (auto& w : workers)
+        total.merge(w.stats);
+    return total;
+}
+
+void battleship::Tournament::printScaling() const
+{
+    const int max_threads = threads_ > 0 ? threads_ : std::max(1u, std::thread::hardware_concurrency());
+    vector<int> counts;
+    for (int t = 1; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max_threads);
+
+    std::cout << "\nthreads   games/s   speedup   efficiency\n" << std::fixed;
+    double base = 0;
+    for (int t : counts)
+    {
+        WorkStealingPool pool(t);
+        double seconds;
+        playGames(pool, seconds);
+        const double rate = seconds > 0 ? games_ / seconds : 0.0;
+        if (t == 1)
+            base = rate;
+        const double speedup = base > 0 ? rate / base : 0.0;
+        std::cout << std::setw(7) << t << std::setw(10) << std::setprecision(0) << rate
+                  << std::setw(10) << std::setprecision(2) << speedup << std::setw(13) << speedup / t << '\n';
+    }
+    std::cout << std::defaultfloat;
+}
+
+void battleship::Tournament::runSprt(WorkStealingPool& pool) const
+{
+    const Sprt empty(elo0_, elo1_, alpha_, beta_);
+    Sprt total = empty;
+
+    // both games of a pair are played in lockstep when the strategies have batched versions
+    const bool uniform = !opening_book_ && !placement_;
+    const auto main_policy = uniform ? StrategyFactory::batchPolicy(player_) : nullptr;
+    const auto opponent_policy = uniform ? StrategyFactory::batchPolicy(opponent_) : nullptr;
+    const bool lockstep = main_policy && opponent_policy;
+    const long grain = lockstep ? SPRT_LOCKSTEP_PAIRS : SPRT_PAIRS;
+
+    std::cout << "sprt (" << player_ << " vs " << opponent_ << "), elo0: " << elo0_ << ", elo1: " << elo1_
+              << ", alpha: " << alpha_ << ", beta: " << beta_ << ", threads: " << pool.size() << ", seed: " << seed_
+              << '\n';
+    const auto report = [&]() {
+        const auto interval = total.eloInterval();
+        std::cout << "pairs: " << total.pairs() << ", elo: " << std::fixed << std::setprecision(1) << total.elo()
+                  << " [" << interval.first << ", " << interval.second << "], llr: " << std::setprecision(2)
+                  << total.llr() << " (" << total.lowerBound() << ", " << total.upperBound() << ")"
+                  << std::defaultfloat << std::endl;
+    };
+
+    // outcomes of the batch by pair index, the test takes them in order and stops at the first pair which
+    // decides it, so its result does not depend on the number of threads
+    const long max_pairs = games_ / 2;
+    vector<std::pair<GameOutcome, GameOutcome>> outcomes(SPRT_BATCH_PAIRS);
+    const auto start = std::chrono::steady_clock::now();
+    auto last_report = start;
+    for (long next = 0; next < max_pairs && total.decision() == SD_CONTINUE; )
+    {
+        const long count = std::min(long(SPRT_BATCH_PAIRS), max_pairs - next);
+        pool.parallelFor(count, grain, [&](int, long begin, long end) {
+            if (lockstep)
+            {
+                const auto first = LockstepSimulation(max_rounds_, main_policy, opponent_policy)
+                        .playGames(seed_, next + begin, next + end);
+                const auto second = LockstepSimulation(max_rounds_, opponent_policy, main_policy)
+                        .playGames(seed_, next + begin, next + end);
+                for (std::size_t i = 0; i < first.size(); i++)
+                    outcomes[begin + i] = { first[i].outcome, reversed(second[i].outcome) };
+            }
+            else
+                for (long i = begin; i < end; i++)
+                    outcomes[i] = { playGame(next + i).outcome, reversed(playSwappedGame(next + i).outcome) };
+        });
+
+        for (long i = 0; i < count && total.decision() == SD_CONTINUE; i++)
+            total.addPair(outcomes[i].first, outcomes[i].second);
+        next += count;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_report >= std::chrono::seconds(1))
+        {
+            report();
+            last_report = now;
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    report();
+    const auto& p = total.getPentanomial();
+    std::cout << "pair scores 0 / 0.5 / 1 / 1.5 / 2: " << p[0] << " / " << p[1] << " / " << p[2] << " / " << p[3]
+              << " / " << p[4] << '\n'
+              << "games per second: " << (elapsed.count() > 0 ? 2 * total.pairs() / elapsed.count() : 0.0) << '\n';
+    switch (total.decision())
+    {
+        case SD_ACCEPT_H1:
+            std::cout << "H1 accepted: " << player_ << " is stronger than " << opponent_ << " (elo1: " << elo1_
+                      << ")" << std::endl;
+            break;
+        case SD_ACCEPT_H0:
+            std::cout << "H0 accepted: " << player_ << " is not stronger than " << opponent_ << " (elo0: " << elo0_
+                      << ")" << std::endl;
+            break;
+        default:
+            std::cout << "no decision after " << 2 * total.pairs() << " games" << std::endl;
+    }
+}
+
+void battleship::Tournament::run()
+{
+    if (used_options_.count(HELP))
+    {
+        std::cout << description_ << std::endl;
+        return;
+    }
+
+    if (used_options_.count(TOURNAMENT_REPLAY))
+    {
+        const long index = used_options_[TOURNAMENT_REPLAY].as<long>();
+        const auto result = playGame(index);
+        const char* outcomes[] = { "win", "draw", "loss" };
+        std::cout << "game " << index << " (" << player_ << " vs " << opponent_ << "), seed: " << seed_ << '\n'
+                  << "result: " << outcomes[result.outcome] << " after " << result.rounds << " rounds" << std::endl;
+        return;
+    }
+
+    WorkStealingPool pool(threads_);
+    if (used_options_.count(TOURNAMENT_SPRT))
+    {
+        runSprt(pool);
+        return;
+    }
+
+    double seconds;
+    auto stats = playGames(pool, seconds);
+
+    std::cout << "games: " << stats.games() << " (" << player_ << " vs " << opponent_ << "), threads: "
+              << pool.size() << ", seed: " << seed_ << '\n'
+              << "wins / draws / losses: " << stats.wins << " / " << stats.draws << " / " << stats.losses << '\n'
+              << "average rounds: " << stats.averageRounds() << '\n'
+              << "games per second: " << (seconds > 0 ? stats.games() / seconds : 0.0) << std::endl;
+
+    if (used_options_.count(TOURNAMENT_SCALING))
+        printScaling();
+}
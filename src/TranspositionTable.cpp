@@ -0,0 +1,54 @@
+#include "TranspositionTable.h"
+#include "exceptions.h"
+
+#include <cstring>
+
+
+battleship::TranspositionTable::TranspositionTable(std::size_t entries)
+{
+    if (entries == 0)
+        throw BattleshipRuntimeError("TranspositionTable: table cannot be empty.");
+
+    std::size_t size = 1;
+    while (size * 2 <= entries)
+        size *= 2;
+    entries_.reset(new Entry[size]);
+    mask_ = size - 1;
+    clear();
+}
+
+std::size_t battleship::TranspositionTable::size() const
+{
+    return mask_ + 1;
+}
+
+bool battleship::TranspositionTable::probe(std::uint64_t hash, double& value) const
+{
+    const auto& e = entries_[hash & mask_];
+    const auto data = e.data.load(std::memory_order_relaxed);
+    if ((e.check.load(std::memory_order_relaxed) ^ data) != hash)
+        return false;
+    std::memcpy(&value, &data, sizeof(value));
+    return true;
+}
+
+void battleship::TranspositionTable::store(std::uint64_t hash, double value)
+{
+    static_assert(sizeof(double) == sizeof(std::uint64_t), "value is stored in a single word");
+
+    std::uint64_t data;
+    std::memcpy(&data, &value, sizeof(data));
+    auto& e = entries_[hash & mask_];
+    e.check.store(hash ^ data, std::memory_order_relaxed);
+    e.data.store(data, std::memory_order_relaxed);
+}
+
+void battleship::TranspositionTable::clear()
+{
+    // empty entry matches only the hash with all bits set
+    for (std::size_t i = 0; i <= mask_; i++)
+    {
+        entries_[i].check.store(~std::uint64_t(0), std::memory_order_relaxed);
+        entries_[i].data.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,114 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::pair;
+
+
+battleship::WorkStealingPool::WorkStealingPool(int threads)
+{
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 0; i < threads; i++)
+        queues_.push_back(std::make_unique<Queue>());
+    for (int i = 0; i < threads; i++)
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+battleship::WorkStealingPool::~WorkStealingPool()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_)
+        t.join();
+}
+
+int battleship::WorkStealingPool::size() const
+{
+    return threads_.size();
+}
+
+void battleship::WorkStealingPool::parallelFor(long count, long grain, const Body& body)
+{
+    if (count <= 0)
+        return;
+    grain = std::max(1L, grain);
+
+    // consecutive chunks go to the same worker, so without stealing each one works on a contiguous block
+    const long chunks = (count + grain - 1) / grain;
+    for (long c = 0; c < chunks; c++)
+    {
+        auto& q = *queues_[c * queues_.size() / chunks];
+        lock_guard<mutex> lock(q.mutex);
+        q.chunks.emplace_back(c * grain, std::min(count, (c + 1) * grain));
+    }
+
+    unique_lock<mutex> lock(mutex_);
+    body_ = &body;
+    active_ = threads_.size();
+    generation_++;
+    wake_.notify_all();
+    done_.wait(lock, [this] { return active_ == 0; });
+    body_ = nullptr;
+}
+
+void battleship::WorkStealingPool::workerLoop(int worker)
+{
+    long seen_generation = 0;
+    while (true)
+    {
+        const Body* body;
+        {
+            unique_lock<mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_)
+                return;
+            seen_generation = generation_;
+            body = body_;
+        }
+
+        // no chunks are added while running, so when all queues are empty the work is done
+        pair<long, long> chunk;
+        while (popOrSteal(worker, chunk))
+            (*body)(worker, chunk.first, chunk.second);
+
+        lock_guard<mutex> lock(mutex_);
+        if (--active_ == 0)
+            done_.notify_all();
+    }
+}
+
+bool battleship::WorkStealingPool::popOrSteal(int worker, pair<long, long>& chunk)
+{
+    {
+        auto& own = *queues_[worker];
+        lock_guard<mutex> lock(own.mutex);
+        if (!own.chunks.empty())
+        {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+
+    const int n = queues_.size();
+    for (int i = 1; i < n; i++)
+    {
+        auto& victim = *queues_[(worker + i) % n];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.chunks.empty())
+        {
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
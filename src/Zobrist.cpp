@@ -0,0 +1,95 @@
+#include "Zobrist.h"
+#include "Random.h"
+
+
+const battleship::Zobrist& battleship::Zobrist::instance()
+{
+    static const Zobrist zobrist;
+    return zobrist;
+}
+
+battleship::Zobrist::Zobrist()
+{
+    // keys are the same in every run, so hashes can be compared between runs
+    Random rng(0x5a0b41e7);
+    for (auto& side : targeted_)
+        for (auto& k : side)
+            k = rng();
+    for (auto& side : fleet_)
+        for (auto& ship : side)
+            for (auto& k : ship)
+                k = rng();
+    for (auto& side : shots_)
+        for (auto& ship : side)
+            for (auto& k : ship)
+                k = rng();
+    for (auto& side : pausing_)
+        for (auto& k : side)
+            k = rng();
+    for (auto& k : round_)
+        k = rng();
+    for (auto& k : max_rounds_)
+        k = rng();
+    for (auto& k : turn_)
+        k = rng();
+    for (auto& k : side_)
+        k = rng();
+}
+
+std::uint64_t battleship::Zobrist::hash(const GameState& s) const
+{
+    std::uint64_t h = round_[s.round] ^ max_rounds_[s.max_rounds] ^ turn_[s.turn];
+    for (int side = 0; side < 2; side++)
+    {
+        const auto& d = s.sides[side];
+        for (auto b = s.getTargeted(side); !b.empty(); )
+            h ^= targeted_[side][b.popLowest()];
+        for (int i = 0; i < Ship::MAX_LENGTH; i++)
+        {
+            h ^= fleet_[side][i][d.fleet[i]] ^ shots_[side][i][d.shots[i]];
+            if (d.pausing & (1 << i))
+                h ^= pausing_[side][i];
+        }
+    }
+    return h;
+}
+
+std::uint64_t battleship::Zobrist::afterShot(std::uint64_t hash, const GameState& s, Shot shot) const
+{
+    const int side = s.turn;
+    const int i = shot.ship_length - 1;
+    const auto& d = s.sides[side];
+    hash ^= targeted_[side][shot.square] ^ shots_[side][i][d.shots[i]] ^ shots_[side][i][d.shots[i] + 1];
+
+    // other ships pause, the shooting one keeps its flag
+    for (int j = 0; j < Ship::MAX_LENGTH; j++)
+        if (j != i && !(d.pausing & (1 << j)))
+            hash ^= pausing_[side][j];
+    return hash;
+}
+
+std::uint64_t battleship::Zobrist::afterEndTurn(std::uint64_t hash, const GameState& s) const
+{
+    return hash ^ turn_[s.turn] ^ turn_[1];
+}
+
+std::uint64_t battleship::Zobrist::afterNextRound(std::uint64_t hash, const GameState& s) const
+{
+    for (int side = 0; side < 2; side++)
+    {
+        const auto& d = s.sides[side];
+        for (int i = 0; i < Ship::MAX_LENGTH; i++)
+        {
+            hash ^= shots_[side][i][d.shots[i]] ^ shots_[side][i][0];
+            const bool was_pausing = d.pausing & (1 << i);
+            if (was_pausing != (d.shots[i] >= Ship::PAUSING_AFTER_SHOTS))
+                hash ^= pausing_[side][i];
+        }
+    }
+    return hash ^ round_[s.round] ^ round_[(s.round + 1) & 0xff] ^ turn_[s.turn] ^ turn_[0];
+}
+
+std::uint64_t battleship::Zobrist::side(int side) const
+{
+    return side_[side];
+}
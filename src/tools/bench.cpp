@@ -0,0 +1,586 @@
+#include "Grid.h"
+#include "AIPlayer.h"
+#include "StaticAIPlayer.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+#include "Simulation.h"
+#include "LockstepSimulation.h"
+#include "DensityStrategy.h"
+#include "MonteCarloStrategy.h"
+#include "EndgameSolver.h"
+#include "FleetLayouts.h"
+#include "OpeningBook.h"
+#include "GameSnapshot.h"
+#include "GameLogic.h"
+#include "AutosaveWriter.h"
+#include "UI.h"
+#include "exceptions.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace battleship;
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+using std::pair;
+using std::string;
+using std::vector;
+using std::make_unique;
+
+namespace
+{
+    struct Result
+    {
+        string name;
+        long ops;
+        double real_ns;
+        double cpu_ns;
+    };
+
+    // Runs bodies of benchmarks which match the filter, prints their results and keeps them for the JSON report.
+    class Harness
+    {
+    public:
+        Harness(string filter, std::chrono::milliseconds min_time)
+            : filter_(std::move(filter))
+            , min_time_(min_time)
+        { }
+
+        // benchmarks with names containing the filter run, the rest is skipped with its set up
+        bool enabled(const string& name) const
+        {
+            return name.find(filter_) != string::npos;
+        }
+
+        // Runs body until at least min_time passed and prints average time of a single operation.
+        // Body returns number of operations it performed.
+        template<typename Body>
+        void measure(const string& name, Body body)
+        {
+            if (!enabled(name))
+                return;
+
+            using clock = std::chrono::steady_clock;
+
+            // batches grow, so the clock is read rarely for fast operations and slow ones stop early
+            long ops = 0;
+            const auto start = clock::now();
+            const auto cpu_start = std::clock();
+            auto elapsed = clock::duration::zero();
+            for (long batch = 1; elapsed < min_time_; batch *= 2)
+            {
+                for (long i = 0; i < batch; i++)
+                    ops += body();
+                elapsed = clock::now() - start;
+            }
+            const double cpu_ns = double(std::clock() - cpu_start) / CLOCKS_PER_SEC * 1e9 / ops;
+
+            const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+            std::cout << std::left << std::setw(40) << name
+                      << std::right << std::setw(12) << std::fixed << std::setprecision(1) << ns << " ns/op"
+                      << std::setw(14) << ops << " ops"
+                      << std::setw(14) << std::setprecision(0) << 1e9 / ns << " ops/s" << std::endl;
+            results_.push_back({ name, ops, ns, cpu_ns });
+        }
+
+        // results in the format of Google Benchmark, so its tools can compare two runs
+        void writeJson(const string& path, const string& executable) const
+        {
+            std::ofstream file;
+            file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+            try
+            {
+                file.open(path, std::ios_base::trunc);
+                const auto now = std::time(nullptr);
+                char date[32];
+                std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+                file << "{\n  \"context\": {\n"
+                     << "    \"date\": \"" << date << "\",\n"
+                     << "    \"executable\": \"" << escape(executable) << "\",\n"
+                     << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+                     << "    \"library_build_type\": \"release\",\n"
+#else
+                     << "    \"library_build_type\": \"debug\",\n"
+#endif
+                     << "    \"compiler\": \"" << escape(__VERSION__) << "\"\n"
+                     << "  },\n  \"benchmarks\": [";
+                file << std::setprecision(6);
+                for (std::size_t i = 0; i < results_.size(); i++)
+                {
+                    const auto& r = results_[i];
+                    file << (i > 0 ? "," : "") << "\n    {\n"
+                         << "      \"name\": \"" << escape(r.name) << "\",\n"
+                         << "      \"run_name\": \"" << escape(r.name) << "\",\n"
+                         << "      \"run_type\": \"iteration\",\n"
+                         << "      \"iterations\": " << r.ops << ",\n"
+                         << "      \"real_time\": " << r.real_ns << ",\n"
+                         << "      \"cpu_time\": " << r.cpu_ns << ",\n"
+                         << "      \"time_unit\": \"ns\",\n"
+                         << "      \"items_per_second\": " << 1e9 / r.real_ns << "\n    }";
+                }
+                file << "\n  ]\n}\n";
+                file.close();
+            }
+            catch (const std::ios_base::failure&)
+            {
+                throw BattleshipRuntimeError("cannot write file '" + path + "'.");
+            }
+        }
+
+    private:
+        string filter_;
+        std::chrono::milliseconds min_time_;
+        vector<Result> results_;
+
+        static string escape(const string& s)
+        {
+            string e;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    e += '\\';
+                e += c;
+            }
+            return e;
+        }
+    };
+
+    // ui which ignores everything, so saved games can be loaded without a terminal
+    class NullUI : public UI
+    {
+    public:
+        void create() override { }
+        void destroy() override { }
+        void displayPlayer(const Player&) override { }
+        void displayPlayers(const Player&, const Player&) override { }
+        void displayMessage(const string&) override { }
+        void cleanScreen() override { }
+        int chooseShip() override { return 0; }
+        pair<int, int> chooseSquare() override { return { 0, 0 }; }
+        bool askQuestion(const string&) override { return false; }
+    };
+
+    // GameLogic with given command line
+    std::unique_ptr<GameLogic> gameLogic(vector<string> args)
+    {
+        args.insert(args.begin(), "battleship");
+        vector<char*> argv;
+        for (auto& a : args)
+            argv.push_back(&a[0]);
+        argv.push_back(nullptr);
+        return make_unique<GameLogic>(argv.size() - 1, argv.data(), std::make_shared<NullUI>());
+    }
+
+    // both players take shots of given number of rounds
+    void playRounds(Player& main, Player& opponent, int rounds)
+    {
+        for (int r = 0; r < rounds; r++)
+        {
+            while (main.canShoot())
+            {
+                const auto p = main.shoot();
+                main.update(p, opponent.takeShot(p));
+            }
+            while (opponent.canShoot())
+            {
+                const auto p = opponent.shoot();
+                opponent.update(p, main.takeShot(p));
+            }
+            main.nextRound();
+            opponent.nextRound();
+        }
+    }
+
+    // ship and square chosen for the player like AIPlayer::shoot does, without firing the shot
+    long decide(ShootStrategy& strategy, const Player& player)
+    {
+        ShipsLengths lengths;
+        for (auto& s : player.getPrimaryGird().getAllShips())
+            if (!s.isSunk() && !player.getUntargetedMask(s).empty())
+                lengths.push_back(s.getLength());
+        const int length = strategy.chooseShip(lengths, player);
+        strategy.chooseSquare(SquareSet(player.getUntargetedMask(player.getPrimaryGird().getShip(length))), player);
+        return 1;
+    }
+
+    // state in the middle of the game where both sides lost their double and triple ships and have
+    // given number of squares left in range of their single ships
+    GameState endgameState(const GameState& start, Random& rng, int squares)
+    {
+        GameState s = start;
+        s.round = 10;
+        for (int side = 0; side < 2; side++)
+        {
+            const int other = 1 - side;
+            auto left = s.getUntargeted(side, 1) & ~s.getShip(other, 1);
+            Bitboard keep = s.getShip(other, 1) & s.getUntargeted(side, 1);
+            while (keep.count() < squares / 2 && !left.empty())
+            {
+                const int q = left.nth(rng.below(left.count()));
+                keep.set(q);
+                left.reset(q);
+            }
+            const auto targeted = s.getShip(other, 2) | s.getShip(other, 3) | (s.getUntargeted(side, 1) & ~keep);
+            s.sides[side].targeted[0] = targeted.low();
+            s.sides[side].targeted[1] = targeted.high();
+        }
+        return s;
+    }
+
+    // results of opponent's ships (2,2), (6,3)(6,4), (3,8)(4,8)(5,8) with some misses around them
+    const vector<pair<pair<int,int>, ShotResult>> UPDATES = {
+        { {0,0}, SR_MISS }, { {4,8}, SR_HIT }, { {9,9}, SR_MISS }, { {6,4}, SR_HIT },
+        { {3,8}, SR_HIT }, { {1,5}, SR_MISS }, { {6,3}, SR_SUNK }, { {5,8}, SR_SUNK },
+        { {7,1}, SR_MISS }, { {2,2}, SR_SUNK }
+    };
+}
+
+
+int main(int argc, char** argv)
+{
+    string filter;
+    string json;
+    int min_ms;
+    po::options_description description("Allowed options");
+    description.add_options()
+            ("help,h", "produce help message")
+            ("filter,f", po::value<string>(&filter)->default_value(""), "run only benchmarks whose names contain it")
+            ("min-ms", po::value<int>(&min_ms)->default_value(500), "minimal time of a single benchmark in milliseconds")
+            ("json", po::value<string>(&json), "write results to the file in the JSON format of Google Benchmark")
+    ;
+    try
+    {
+        po::variables_map options;
+        po::store(po::parse_command_line(argc, argv, description), options);
+        po::notify(options);
+        if (options.count("help"))
+        {
+            std::cout << description << std::endl;
+            return 0;
+        }
+        if (min_ms <= 0)
+            throw ArgumentsError("the argument ('" + std::to_string(min_ms) + "') for option '--min-ms' is invalid.");
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    Harness bench(filter, std::chrono::milliseconds(min_ms));
+    const auto& layouts = FleetLayouts::instance();
+    Random rng(1);
+
+    // every operation is a single Grid::update call
+    bench.measure("Grid::update", []()
+    {
+        Grid g;
+        for (auto& u : UPDATES)
+            g.update(u.first, u.second);
+        return (long)UPDATES.size();
+    });
+
+    // every operation collects untargeted squares in range of a ship, the set or the bitboard
+    ShipsGrid fleet;
+    const auto fleet_layout = layouts.sample(rng);
+    for (int l = Ship::MAX_LENGTH; l > 0; l--)
+        fleet.tryPlace(layouts.getPlacements(l)[fleet_layout[l - 1]].squares, l);
+    Grid middle;
+    for (int i = 0; i < 6; i++)
+        middle.update(UPDATES[i].first, UPDATES[i].second);
+    bench.measure("Grid::getAvailableRange", [&]()
+    {
+        return (long)!middle.getAvailableRange(fleet.getShip(3))->empty();
+    });
+    bench.measure("Grid::getAvailableMask", [&]()
+    {
+        return (long)!middle.getAvailableMask(fleet.getShip(3)).empty();
+    });
+
+    // every operation is a single shot at the fleet, the fleet is placed again and all squares are shot at
+    bench.measure("ShipsGrid::takeShot", [&]()
+    {
+        ShipsGrid g;
+        for (int l = Ship::MAX_LENGTH; l > 0; l--)
+            g.tryPlace(layouts.getPlacements(l)[fleet_layout[l - 1]].squares, l);
+        for (int q = 0; q < Bitboard::SQUARES; q++)
+            g.takeShot(Bitboard::toSquare(q));
+        return (long)Bitboard::SQUARES;
+    });
+
+    // every operation places a single ship on the empty grid
+    vector<vector<pair<int, int>>> ships;
+    for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+    {
+        const auto& squares = layouts.getPlacements(l)[fleet_layout[l - 1]].squares;
+        ships.emplace_back(squares.begin(), squares.begin() + l);
+    }
+    bench.measure("ShipsGrid::setShipLocation", [&]()
+    {
+        ShipsGrid g;
+        for (auto& squares : ships)
+            g.setShipLocation(make_unique<vector<pair<int, int>>>(squares));
+        return (long)ships.size();
+    });
+
+    // every operation places the whole fleet of a new player
+    std::uint64_t seed = 0;
+    bench.measure("AIPlayer::setUpShips", [&]()
+    {
+        seed++;
+        AIPlayer p(make_unique<RandomStrategy>(Random(seed, 1)), Random(seed, 0));
+        p.setUpShips();
+        return 1L;
+    });
+
+    // players after a few rounds of greedy shots, decisions below are made for the first one
+    AIPlayer player(make_unique<GreedyStrategy>(Random(7, 1)), Random(7, 0));
+    AIPlayer other(make_unique<GreedyStrategy>(Random(7, 3)), Random(7, 2));
+    player.setUpShips();
+    other.setUpShips();
+    playRounds(player, other, 5);
+
+    // every operation is a single call
+    long can_shoot = 0;
+    bench.measure("Player::canShoot", [&]()
+    {
+        can_shoot += player.canShoot();
+        return 1L;
+    });
+
+    // every operation chooses a ship and a square in its range
+    RandomStrategy random_strategy(Random(1));
+    bench.measure("RandomStrategy::decision", [&]() { return decide(random_strategy, player); });
+    GreedyStrategy greedy_strategy(Random(1));
+    bench.measure("GreedyStrategy::decision", [&]() { return decide(greedy_strategy, player); });
+    DensityStrategy density_strategy(Random(1));
+    bench.measure("DensityStrategy::decision", [&]() { return decide(density_strategy, player); });
+    StrategyOptions search_options;
+    search_options.think_ms = 10;
+    search_options.threads = 1;
+    MonteCarloStrategy monte_carlo_strategy(Random(1), search_options);
+    bench.measure("MonteCarloStrategy::decision/10ms", [&]() { return decide(monte_carlo_strategy, player); });
+
+    // every operation counts all layouts consistent with the grid
+    Grid empty;
+    bench.measure("DensityStrategy::countLayouts/0", [&]()
+    {
+        return (long)(DensityStrategy::countLayouts(empty).layouts > 0);
+    });
+
+    Grid first;
+    first.update(UPDATES[0].first, UPDATES[0].second);
+    bench.measure("DensityStrategy::countLayouts/1", [&]()
+    {
+        return (long)(DensityStrategy::countLayouts(first).layouts > 0);
+    });
+
+    bench.measure("DensityStrategy::countLayouts/6", [&]()
+    {
+        return (long)(DensityStrategy::countLayouts(middle).layouts > 0);
+    });
+
+    // every operation is a whole game of random shots from a fresh state, fleets are sampled once
+    GameState start {};
+    start.max_rounds = 20;
+    for (auto& side : start.sides)
+    {
+        const auto layout = layouts.sample(rng);
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            side.fleet[l - 1] = layout[l - 1];
+    }
+    bench.measure("MonteCarloStrategy::rollout", [&]()
+    {
+        MonteCarloStrategy::rollout(start, rng);
+        return 1L;
+    });
+
+    // every operation is a node of the search, the table is cleared before every solve
+    TranspositionTable table(1 << 16);
+    for (int squares : { 8, 12, 16, 20 })
+    {
+        const auto endgame = endgameState(start, rng, squares);
+        bench.measure("EndgameSolver::solve/" + std::to_string(squares), [&]()
+        {
+            table.clear();
+            EndgameSolver solver(table, endgame.turn);
+            solver.solve(endgame);
+            return solver.getNodes();
+        });
+    }
+
+    // every operation saves or loads the game of the players above, loading creates the whole GameLogic
+    const auto temp = [] { return (fs::temp_directory_path() / fs::unique_path()).string(); };
+    const string snapshot_path = temp(), binary_path = temp(), text_path = temp();
+    auto snapshot = GameSnapshot::make();
+    snapshot.round_number = 5;
+    snapshot.max_rounds = 20;
+    snapshot.seed = 7;
+    snapshot.setPlayer(0, player, GREEDY);
+    snapshot.setPlayer(1, other, GREEDY);
+    snapshot.write(snapshot_path);
+    {
+        const auto to_binary = gameLogic({ "--load", snapshot_path, "--save", binary_path, "--save-format", BINARY_FORMAT });
+        const auto to_text = gameLogic({ "--load", snapshot_path, "--save", text_path, "--save-format", TEXT_FORMAT });
+        bench.measure("GameLogic::saveGameToFile/binary", [&]()
+        {
+            to_binary->saveGameToFile();
+            return 1L;
+        });
+        bench.measure("GameLogic::saveGameToFile/text", [&]()
+        {
+            to_text->saveGameToFile();
+            return 1L;
+        });
+        to_binary->saveGameToFile();
+        to_text->saveGameToFile();
+    }
+    // the synced write the autosave thread does for every save
+    const string content(sizeof(GameSnapshot), 'x');
+    bench.measure("AutosaveWriter::writeFile", [&]()
+    {
+        AutosaveWriter::writeFile(snapshot_path, content);
+        return 1L;
+    });
+    snapshot.write(snapshot_path);
+    bench.measure("GameLogic::loadGameFromFile/binary", [&]()
+    {
+        gameLogic({ "--load", binary_path, "--save", snapshot_path });
+        return 1L;
+    });
+    bench.measure("GameLogic::loadGameFromFile/text", [&]()
+    {
+        gameLogic({ "--load", text_path, "--save", snapshot_path });
+        return 1L;
+    });
+    for (auto& path : { snapshot_path, binary_path, text_path })
+        fs::remove(path);
+
+    // every operation is a whole game, players call strategies through virtual functions or directly
+    const Simulation simulation(20);
+    bench.measure("Simulation::playGame/random", [&]()
+    {
+        seed++;
+        AIPlayer main(make_unique<RandomStrategy>(Random(seed, 1)), Random(seed, 0));
+        AIPlayer opponent(make_unique<RandomStrategy>(Random(seed, 3)), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+        simulation.playGame(main, opponent);
+        return 1L;
+    });
+    bench.measure("Simulation::playStaticGame/random", [&]()
+    {
+        seed++;
+        StaticAIPlayer<RandomStrategy> main(Random(seed, 1), StrategyOptions(), Random(seed, 0));
+        StaticAIPlayer<RandomStrategy> opponent(Random(seed, 3), StrategyOptions(), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+        simulation.playStaticGame(main, opponent);
+        return 1L;
+    });
+    bench.measure("Simulation::playGame/greedy", [&]()
+    {
+        seed++;
+        AIPlayer main(make_unique<GreedyStrategy>(Random(seed, 1)), Random(seed, 0));
+        AIPlayer opponent(make_unique<GreedyStrategy>(Random(seed, 3)), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+        simulation.playGame(main, opponent);
+        return 1L;
+    });
+    bench.measure("Simulation::playStaticGame/greedy", [&]()
+    {
+        seed++;
+        StaticAIPlayer<GreedyStrategy> main(Random(seed, 1), StrategyOptions(), Random(seed, 0));
+        StaticAIPlayer<GreedyStrategy> opponent(Random(seed, 3), StrategyOptions(), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+        simulation.playStaticGame(main, opponent);
+        return 1L;
+    });
+    bench.measure("Simulation::playGame/density", [&]()
+    {
+        seed++;
+        AIPlayer main(make_unique<DensityStrategy>(Random(seed, 1)), Random(seed, 0));
+        AIPlayer opponent(make_unique<GreedyStrategy>(Random(seed, 3)), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+        simulation.playGame(main, opponent);
+        return 1L;
+    });
+
+    // every operation is a single decision of a game in the batch
+    ShotBatch batch(4096);
+    for (std::size_t g = 0; g < batch.size(); g++)
+    {
+        // all ships and about half of the board untargeted
+        batch.ships[g] = 7;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            batch.untargeted_low[l - 1][g] = rng() | 1;
+            batch.untargeted_high[l - 1][g] = rng() & Bitboard::full().high();
+        }
+        batch.setRandom(g, Random(rng()));
+    }
+    bench.measure("ShotBatch::chooseRandomShots/scalar", [&]()
+    {
+        batch.chooseRandomShots(BSC_RANDOM, BI_SCALAR);
+        return long(batch.size());
+    });
+    if (ShotBatch::hasAvx2())
+        bench.measure("ShotBatch::chooseRandomShots/avx2", [&]()
+        {
+            batch.chooseRandomShots(BSC_RANDOM, BI_AVX2);
+            return long(batch.size());
+        });
+
+    // every operation is a whole game of the batch, compare with Simulation::playStaticGame
+    const LockstepSimulation lockstep(20, &RandomStrategy::chooseShots, &RandomStrategy::chooseShots);
+    bench.measure("LockstepSimulation/random", [&]()
+    {
+        seed += 4096;
+        lockstep.playGames(seed, 0, 4096);
+        return 4096L;
+    });
+
+    // every operation is a lookup of the first turn of a random fleet in the mapped book
+    if (bench.enabled("MappedOpeningBook::find"))
+    {
+        const auto book_path = temp();
+        OpeningBook::write(book_path, OpeningBook::generate());
+        {
+            MappedOpeningBook book(book_path);
+            long found = 0;
+            bench.measure("MappedOpeningBook::find", [&]()
+            {
+                found += book.find(layouts.sample(rng)) != nullptr;
+                return 1L;
+            });
+        }
+        fs::remove(book_path);
+    }
+
+    if (!json.empty())
+    {
+        try
+        {
+            bench.writeJson(json, argv[0]);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#include "OpeningBook.h"
+
+#include <iostream>
+#include <chrono>
+
+using namespace battleship;
+
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <output file>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto entries = OpeningBook::generate();
+        OpeningBook::write(argv[1], entries);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "layouts: " << entries.size() << ", bytes: "
+                  << sizeof(OpeningBook::Header) + entries.size() * sizeof(OpeningBook::Entry)
+                  << ", seconds: " << elapsed.count() << std::endl;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,25 @@
+#include "PlacementTrainer.h"
+
+#include <iostream>
+
+using namespace battleship;
+
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        PlacementTrainer t(argc, argv);
+        t.run();
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    catch(...)
+    {
+        std::cerr << "unknown error." << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,23 @@
+#include "Tournament.h"
+
+#include <iostream>
+
+using namespace battleship;
+
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Tournament t(argc, argv);
+        t.run();
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch(...)
+    {
+        std::cerr << "unknown error." << std::endl;
+    }
+}
@@ -21,3 +21,35 @@ TEST_F(AIPlayerTest, logic_errors)
 {
     EXPECT_THROW(p.shoot(), BattleshipLogicError) << "cannot shoot before setting ships location.";
 }
+
+TEST_F(AIPlayerTest, seeded_ships_placement)
+{
+    for (std::uint64_t seed = 0; seed < 20; seed++)
+    {
+        AIPlayer a(std::make_unique<MockShootStrategy>(), Random(seed));
+        AIPlayer b(std::make_unique<MockShootStrategy>(), Random(seed));
+        a.setUpShips();
+        b.setUpShips();
+        for (int l = 1; l <= 3; l++)
+            EXPECT_EQ(a.getPrimaryGird().getShip(l).getOccupiedMask(), b.getPrimaryGird().getShip(l).getOccupiedMask())
+                    << "the same seed should give the same ships";
+    }
+}
+
+TEST_F(AIPlayerTest, trained_ships_placement)
+{
+    // all weight on a single layout
+    const auto& layouts = FleetLayouts::instance();
+    std::vector<double> weights(layouts.size(), 0.0);
+    weights[12345] = 1;
+    const auto placement = std::make_shared<PlacementDistribution>(weights);
+
+    for (std::uint64_t seed = 0; seed < 5; seed++)
+    {
+        AIPlayer a(std::make_unique<MockShootStrategy>(), Random(seed), placement);
+        a.setUpShips();
+        const auto layout = layouts.at(12345);
+        for (int l = 1; l <= 3; l++)
+            EXPECT_EQ(a.getPrimaryGird().getShip(l).getOccupiedMask(), layouts.getPlacements(l)[layout[l - 1]].mask);
+    }
+}
@@ -0,0 +1,107 @@
+#include "AutosaveWriter.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace battleship;
+using std::string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    string readFile(const string& path)
+    {
+        std::ifstream f(path, std::ios_base::binary);
+        std::stringstream ss;
+        ss << f.rdbuf();
+        return ss.str();
+    }
+}
+
+
+TEST(AutosaveWriterTest, write_file)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+
+    AutosaveWriter::writeFile(path, "first");
+    EXPECT_EQ(readFile(path), "first");
+    AutosaveWriter::writeFile(path, string("second\0binary", 13));
+    EXPECT_EQ(readFile(path), string("second\0binary", 13));
+    EXPECT_FALSE(fs::exists(path + ".tmp"));
+
+    // the previous save stays when the new one cannot be written
+    const string missing = (fs::temp_directory_path() / fs::unique_path() / "save").string();
+    EXPECT_THROW(AutosaveWriter::writeFile(missing, "x"), BattleshipRuntimeError);
+
+    fs::remove(path);
+}
+
+TEST(AutosaveWriterTest, latest_save_is_written)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    {
+        AutosaveWriter writer;
+        for (int i = 0; i < 100; i++)
+            writer.submit(path, "round " + std::to_string(i));
+        writer.flush();
+        EXPECT_EQ(readFile(path), "round 99");
+
+        const auto stats = writer.getStats();
+        EXPECT_EQ(stats.submitted, 100);
+        EXPECT_EQ(stats.written + stats.coalesced, 100);
+        EXPECT_EQ(stats.waited, 0);
+        EXPECT_EQ(stats.failed, 0);
+
+        // waiting saves are written by the destructor
+        writer.submit(path, "last");
+    }
+    EXPECT_EQ(readFile(path), "last");
+    fs::remove(path);
+}
+
+TEST(AutosaveWriterTest, bounded_queue)
+{
+    vector<string> paths;
+    for (int i = 0; i < 20; i++)
+        paths.push_back((fs::temp_directory_path() / fs::unique_path()).string());
+
+    AutosaveWriter writer(2);
+    for (const auto& p : paths)
+        writer.submit(p, p);
+    writer.submit((fs::temp_directory_path() / fs::unique_path() / "save").string(), "x");
+    writer.flush();
+
+    // saves of different files wait for space in the full queue, none of them is lost
+    const auto stats = writer.getStats();
+    EXPECT_EQ(stats.submitted, 21);
+    EXPECT_EQ(stats.written + stats.failed, 21);
+    EXPECT_EQ(stats.failed, 1);
+    for (const auto& p : paths)
+    {
+        EXPECT_EQ(readFile(p), p);
+        fs::remove(p);
+    }
+}
+
+TEST(AutosaveWriterTest, shared_writer)
+{
+    EXPECT_EQ(AutosaveWriter::shared(), AutosaveWriter::shared());
+
+    const string first = (fs::temp_directory_path() / fs::unique_path()).string();
+    const string second = (fs::temp_directory_path() / fs::unique_path()).string();
+    AutosaveWriter writer;
+    writer.submit(first, "first");
+    writer.submit(second, "second");
+    writer.flush(first);
+    EXPECT_EQ(readFile(first), "first");
+    writer.flush();
+    EXPECT_EQ(readFile(second), "second");
+    fs::remove(first);
+    fs::remove(second);
+}
@@ -0,0 +1,109 @@
+#include "Bitboard.h"
+
+#include "gtest/gtest.h"
+#include <utility>
+#include <set>
+
+using namespace battleship;
+using std::pair;
+using std::make_pair;
+using std::set;
+
+
+TEST(BitboardTest, dummy)
+{
+    (void)Bitboard();
+}
+
+TEST(BitboardTest, initial_state)
+{
+    Bitboard b;
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(b.count(), 0);
+    for (int i = 0; i < Bitboard::SQUARES; i++)
+        EXPECT_FALSE(b.test(i));
+
+    EXPECT_EQ(Bitboard::full().count(), 100) << "full bitboard should have exactly 100 squares";
+    EXPECT_EQ(~Bitboard(), Bitboard::full()) << "complement cannot set bits outside the grid";
+}
+
+TEST(BitboardTest, index_conversion)
+{
+    for (int a = 0; a < 10; ++a)
+        for (int b = 0; b < 10; ++b)
+            EXPECT_EQ(Bitboard::toSquare(Bitboard::toIndex({a,b})), make_pair(a,b));
+}
+
+TEST(BitboardTest, set_and_reset)
+{
+    Bitboard b;
+    for (int a = 0; a < 10; ++a)
+        for (int c = 0; c < 10; ++c)
+        {
+            b.set({a,c});
+            EXPECT_TRUE(b.test({a,c}));
+            EXPECT_EQ(b.count(), a * 10 + c + 1);
+        }
+    EXPECT_EQ(b, Bitboard::full());
+
+    b.reset({6,4});
+    EXPECT_FALSE(b.test({6,4})) << "square in the high word not reset";
+    b.reset({0,3});
+    EXPECT_FALSE(b.test({0,3})) << "square in the low word not reset";
+    EXPECT_EQ(b.count(), 98);
+}
+
+TEST(BitboardTest, iteration)
+{
+    Bitboard b;
+    set<int> s({ 0, 5, 63, 64, 65, 99 });
+    for (auto i : s)
+        b.set(i);
+
+    set<int> r;
+    while (!b.empty())
+        r.insert(b.popLowest());
+    EXPECT_EQ(r, s);
+}
+
+TEST(BitboardTest, shifts_do_not_wrap)
+{
+    // squares on the borders should disappear when moved out of the grid
+    for (int a = 0; a < 10; ++a)
+    {
+        EXPECT_TRUE(Bitboard::fromSquare({a,0}).shiftSecondDown().empty());
+        EXPECT_TRUE(Bitboard::fromSquare({a,9}).shiftSecondUp().empty());
+        EXPECT_TRUE(Bitboard::fromSquare({0,a}).shiftFirstDown().empty());
+        EXPECT_TRUE(Bitboard::fromSquare({9,a}).shiftFirstUp().empty());
+    }
+
+    // square crossing the boundary between words
+    EXPECT_EQ(Bitboard::fromSquare({6,3}).shiftSecondUp(), Bitboard::fromSquare({6,4}));
+    EXPECT_EQ(Bitboard::fromSquare({6,4}).shiftSecondDown(), Bitboard::fromSquare({6,3}));
+    EXPECT_EQ(Bitboard::fromSquare({5,8}).shiftFirstUp(), Bitboard::fromSquare({6,8}));
+    EXPECT_EQ(Bitboard::fromSquare({6,8}).shiftFirstDown(), Bitboard::fromSquare({5,8}));
+}
+
+TEST(BitboardTest, dilate)
+{
+    auto b = Bitboard::fromSquare({0,0}).dilate();
+    EXPECT_EQ(b, Bitboard::rectangle(0, 0, 1, 1));
+
+    b = Bitboard::fromSquare({5,9}).dilate();
+    EXPECT_EQ(b, Bitboard::rectangle(4, 8, 6, 9));
+
+    b = (Bitboard::fromSquare({3,4}) | Bitboard::fromSquare({4,4})).dilate();
+    EXPECT_EQ(b, Bitboard::rectangle(2, 3, 5, 5));
+}
+
+TEST(BitboardTest, rectangle)
+{
+    auto b = Bitboard::rectangle(1, 2, 5, 6);
+    EXPECT_EQ(b.count(), 25);
+    for (int a = 0; a < 10; ++a)
+        for (int c = 0; c < 10; ++c)
+            EXPECT_EQ(b.test({a,c}), a >= 1 && a <= 5 && c >= 2 && c <= 6);
+
+    EXPECT_EQ(Bitboard::rectangle(-4, -4, 13, 13), Bitboard::full()) << "rectangle should be clamped to grid";
+    EXPECT_TRUE(Bitboard::rectangle(5, 5, 4, 4).empty());
+}
@@ -0,0 +1,154 @@
+#include "DensityStrategy.h"
+#include "FleetLayouts.h"
+#include "AIPlayer.h"
+#include "GreedyStrategy.h"
+#include "test/Player_mock.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+#include <utility>
+#include <cstdlib>
+
+using namespace battleship;
+using battleship_test::MockPlayer;
+using std::make_pair;
+using std::make_unique;
+
+namespace
+{
+    // count layouts which give the same grid after taking all its shots, one by one
+    DensityStrategy::Density countByDefinition(const Grid& g)
+    {
+        DensityStrategy::Density d;
+        d.counts.fill(0);
+        d.layouts = 0;
+
+        const auto& layouts = FleetLayouts::instance();
+        const auto shots = ~g.getPlane(ST_EMPTY);
+        for (std::size_t i = 0; i < layouts.size(); i++)
+        {
+            const auto layout = layouts.at(i);
+            Bitboard ships;
+            Bitboard sunk;
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            {
+                const auto m = layouts.getPlacements(l)[layout[l - 1]].mask;
+                ships |= m;
+                if ((m & ~shots).empty())
+                    sunk |= m;
+            }
+
+            if (sunk != g.getPlane(ST_SUNK) || (shots & ships & ~sunk) != g.getPlane(ST_HIT)
+                    || (shots & ~ships) != g.getPlane(ST_MISS))
+                continue;
+
+            d.layouts++;
+            for (auto b = ships & ~shots; !b.empty(); )
+                d.counts[b.popLowest()]++;
+        }
+        return d;
+    }
+
+    void expectSameDensity(const Grid& g)
+    {
+        auto expected = countByDefinition(g);
+        auto d = DensityStrategy::countLayouts(g);
+        EXPECT_EQ(d.layouts, expected.layouts);
+        EXPECT_EQ(d.counts, expected.counts);
+    }
+}
+
+
+TEST(DensityStrategyTest, dummy)
+{
+    (void)DensityStrategy();
+}
+
+TEST(DensityStrategyTest, empty_grid)
+{
+    Grid g;
+    auto d = DensityStrategy::countLayouts(g);
+    EXPECT_EQ(d.layouts, FleetLayouts::instance().size()) << "all layouts agree with the empty grid";
+    expectSameDensity(g);
+}
+
+TEST(DensityStrategyTest, count_layouts)
+{
+    // ships: (2,2),  (6,3)(6,4),  (3,8)(4,8)(5,8)
+    Grid g;
+    g.update({0,0}, SR_MISS);
+    g.update({4,8}, SR_HIT);
+    g.update({8,8}, SR_MISS);
+    expectSameDensity(g);
+
+    g.update({6,4}, SR_HIT);
+    g.update({2,2}, SR_SUNK);
+    g.update({5,5}, SR_MISS);
+    expectSameDensity(g);
+
+    g.update({6,3}, SR_SUNK);
+    g.update({3,8}, SR_HIT);
+    expectSameDensity(g);
+
+    // three hits in a row would be reported as sunk triple ship
+    Grid wrong;
+    wrong.update({0,0}, SR_SUNK);
+    wrong.update({5,5}, SR_HIT);
+    wrong.update({5,6}, SR_SUNK);
+    wrong.update({2,0}, SR_HIT);
+    wrong.update({2,1}, SR_HIT);
+    wrong.update({2,2}, SR_HIT);
+    EXPECT_EQ(DensityStrategy::countLayouts(wrong).layouts, 0u);
+}
+
+TEST(DensityStrategyTest, shoot_next_to_hit)
+{
+    MockPlayer p;
+    p.mockSetUpShips();
+    // triple ship hit in the middle of the grid, the rest of it is next to the hit
+    p.update({5,5}, SR_HIT);
+
+    DensityStrategy s(Random(1));
+    ShipsLengths l;
+    l.push_back(1);
+    l.push_back(2);
+    l.push_back(3);
+    const int length = s.chooseShip(l, p);
+    auto square = s.chooseSquare(SquareSet(p.getUntargetedMask(p.getPrimaryGird().getShip(length))), p);
+    EXPECT_EQ(std::abs(square.first - 5) + std::abs(square.second - 5), 1);
+
+    EXPECT_THROW(s.chooseShip(ShipsLengths(), p), BattleshipRuntimeError);
+    EXPECT_THROW(s.chooseSquare(SquareSet(), p), BattleshipRuntimeError);
+}
+
+TEST(DensityStrategyTest, beats_greedy)
+{
+    // density strategy should sink ships faster than shooting at random squares in range
+    int density_hits = 0;
+    int greedy_hits = 0;
+    for (int seed = 0; seed < 20; seed++)
+    {
+        AIPlayer density(make_unique<DensityStrategy>(Random(seed, 1)), Random(seed, 2));
+        AIPlayer greedy(make_unique<GreedyStrategy>(Random(seed, 1)), Random(seed, 2));
+        density.setUpShips();
+        greedy.setUpShips();
+
+        for (auto* p : { (Player*)&density, (Player*)&greedy })
+        {
+            AIPlayer t(make_unique<GreedyStrategy>(), Random(seed, 0));
+            t.setUpShips();
+            for (int round = 0; round < 5; round++)
+            {
+                while (p->canShoot())
+                {
+                    auto s = p->shoot();
+                    p->update(s, t.takeShot(s));
+                }
+                p->nextRound();
+                t.nextRound();
+            }
+            (p == &density ? density_hits : greedy_hits) += t.getHits();
+        }
+    }
+    EXPECT_GT(density_hits, greedy_hits);
+}
@@ -0,0 +1,183 @@
+#include "EndgameSolver.h"
+#include "FleetLayouts.h"
+#include "Simulation.h"
+#include "Random.h"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace battleship;
+
+namespace
+{
+    // both sides lost their double and triple ships and have given number of squares left
+    // in range of their single ships
+    GameState endgameState(Random& rng, int squares)
+    {
+        GameState s {};
+        s.max_rounds = 20;
+        s.round = 10;
+        for (int side = 0; side < 2; side++)
+        {
+            const auto layout = FleetLayouts::instance().sample(rng);
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                s.sides[side].fleet[l - 1] = layout[l - 1];
+        }
+        for (int side = 0; side < 2; side++)
+        {
+            const int other = 1 - side;
+            auto left = s.getUntargeted(side, 1) & ~s.getShip(other, 1);
+            Bitboard keep = s.getShip(other, 1) & s.getUntargeted(side, 1);
+            while (keep.count() < squares / 2 && !left.empty())
+            {
+                const int q = left.nth(rng.below(left.count()));
+                keep.set(q);
+                left.reset(q);
+            }
+            const auto targeted = s.getShip(other, 2) | s.getShip(other, 3) | (s.getUntargeted(side, 1) & ~keep);
+            s.sides[side].targeted[0] = targeted.low();
+            s.sides[side].targeted[1] = targeted.high();
+        }
+        return s;
+    }
+
+    // expectimax without the table, values are for the given side
+    double bruteForce(GameState s, int side)
+    {
+        const auto result = [&](GameOutcome outcome)
+        {
+            const double value = (outcome == GO_WIN ? 1.0 : (outcome == GO_DRAW ? 0.5 : 0.0))
+                                 + 0.01 * (s.getHits(1) - s.getHits(0));
+            return side == 0 ? value : 1.0 - value;
+        };
+        while (!s.canShoot(s.turn))
+        {
+            if (s.turn == 0)
+            {
+                s.endTurn();
+                if (!s.canShoot(1) && !s.mayShootNextRounds(1))
+                    return result(GO_WIN);
+            }
+            else
+            {
+                s.nextRound();
+                if (s.round >= s.max_rounds)
+                {
+                    const int h0 = s.getHits(0);
+                    const int h1 = s.getHits(1);
+                    return result(h0 == h1 ? GO_DRAW : (h0 < h1 ? GO_WIN : GO_LOSS));
+                }
+                if (!s.canShoot(0) && !s.mayShootNextRounds(0))
+                    return result(GO_LOSS);
+            }
+        }
+
+        double best = -1.0;
+        double average = 0.0;
+        int ships = 0;
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            if (s.canShoot(s.turn, l))
+            {
+                const auto squares = s.getUntargeted(s.turn, l);
+                double sum = 0.0;
+                for (auto b = squares; !b.empty(); )
+                {
+                    GameState c = s;
+                    c.apply({ l, b.popLowest() });
+                    const double v = bruteForce(c, side);
+                    best = std::max(best, v);
+                    sum += v;
+                }
+                average += sum / squares.count();
+                ships++;
+            }
+        return s.turn == side ? best : average / ships;
+    }
+}
+
+
+TEST(EndgameSolverTest, dummy)
+{
+    TranspositionTable table(16);
+    (void)EndgameSolver(table, 0);
+}
+
+TEST(EndgameSolverTest, remaining_squares)
+{
+    Random rng(3);
+    for (int squares : { 2, 4, 8, 12 })
+    {
+        const auto s = endgameState(rng, squares);
+        EXPECT_LE(EndgameSolver::remainingSquares(s), squares);
+    }
+}
+
+TEST(EndgameSolverTest, same_as_brute_force)
+{
+    Random rng(7);
+    TranspositionTable table(1 << 12);
+    for (int i = 0; i < 20; i++)
+    {
+        const auto s = endgameState(rng, 6);
+        EndgameSolver main(table, 0);
+        EXPECT_NEAR(main.solve(s), bruteForce(s, 0), 1e-9);
+        EXPECT_GT(main.getNodes(), 0);
+
+        // the same table is used for the other side, its entries must not be mixed up
+        GameState t = s;
+        t.turn = 1;
+        EndgameSolver opponent(table, 1);
+        EXPECT_NEAR(opponent.solve(t), bruteForce(t, 1), 1e-9);
+    }
+}
+
+TEST(EndgameSolverTest, shared_table)
+{
+    // solvers sharing the table on different threads give the same values as a solver with its own table
+    Random rng(11);
+    std::vector<GameState> states;
+    std::vector<double> values;
+    for (int i = 0; i < 8; i++)
+    {
+        states.push_back(endgameState(rng, 8));
+        TranspositionTable own(1 << 14);
+        values.push_back(EndgameSolver(own, 0).solve(states.back()));
+    }
+
+    TranspositionTable shared(1 << 10);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<double>> results(4, std::vector<double>(states.size()));
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([&, t]()
+        {
+            EndgameSolver solver(shared, 0);
+            for (std::size_t i = 0; i < states.size(); i++)
+                results[t][i] = solver.solve(states[(i + t) % states.size()]);
+        });
+    for (auto& t : threads)
+        t.join();
+
+    for (int t = 0; t < 4; t++)
+        for (std::size_t i = 0; i < states.size(); i++)
+            EXPECT_NEAR(results[t][i], values[(i + t) % states.size()], 1e-9);
+}
+
+TEST(EndgameSolverTest, deadline)
+{
+    Random rng(5);
+    TranspositionTable table(1 << 12);
+    const auto s = endgameState(rng, 6);
+    EndgameSolver solver(table, 0);
+    EXPECT_FALSE(solver.isAborted());
+
+    // values of the aborted search are not kept in the table
+    solver.setDeadline(std::chrono::steady_clock::now());
+    solver.solve(s);
+    EXPECT_TRUE(solver.isAborted());
+    solver.setDeadline(std::chrono::steady_clock::time_point::max());
+    EXPECT_NEAR(solver.solve(s), bruteForce(s, 0), 1e-9);
+    EXPECT_FALSE(solver.isAborted());
+}
@@ -0,0 +1,96 @@
+#include "FleetLayouts.h"
+#include "ShipsGrid.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+#include <set>
+
+using namespace battleship;
+using std::vector;
+
+
+TEST(FleetLayoutsTest, dummy)
+{
+    (void)FleetLayouts::instance();
+}
+
+TEST(FleetLayoutsTest, placements)
+{
+    auto& l = FleetLayouts::instance();
+    EXPECT_EQ(l.getPlacements(1).size(), 100u);
+    EXPECT_EQ(l.getPlacements(2).size(), 180u);
+    EXPECT_EQ(l.getPlacements(3).size(), 160u);
+
+    for (int length = 1; length <= 3; length++)
+    {
+        std::set<std::pair<std::uint64_t, std::uint64_t>> masks;
+        for (int i = 0; i < (int)l.getPlacements(length).size(); i++)
+        {
+            auto& p = l.getPlacements(length)[i];
+            ShipsGrid g;
+            EXPECT_EQ(g.tryPlace(p.squares, length), PS_OK);
+            EXPECT_EQ(p.mask.count(), length);
+            EXPECT_EQ(p.range, g.getShip(length).getRangeMask());
+            EXPECT_EQ(l.placementIndex(length, p.mask), i);
+            masks.insert({ p.mask.low(), p.mask.high() });
+        }
+        EXPECT_EQ(masks.size(), l.getPlacements(length).size()) << "placements should be unique";
+    }
+
+    EXPECT_EQ(l.placementIndex(2, Bitboard::fromSquare({0,0})), -1);
+    EXPECT_THROW(l.getPlacements(0), BattleshipRuntimeError);
+    EXPECT_THROW(l.getPlacements(4), BattleshipRuntimeError);
+}
+
+TEST(FleetLayoutsTest, layouts_are_legal)
+{
+    auto& l = FleetLayouts::instance();
+    ASSERT_GT(l.size(), 0u);
+
+    for (std::size_t i = 0; i < l.size(); i += l.size() / 997)
+    {
+        auto layout = l.at(i);
+        ShipsGrid g;
+        for (int length = 3; length >= 1; length--)
+            EXPECT_EQ(g.tryPlace(l.getPlacements(length)[layout[length - 1]].squares, length), PS_OK);
+        EXPECT_EQ(l.getMask(layout), ~g.getPlane(ST_EMPTY));
+        EXPECT_EQ(l.indexOf(layout), (long)i);
+    }
+}
+
+TEST(FleetLayoutsTest, all_layouts_enumerated)
+{
+    // count layouts with the first triple placement by trying every double and single ship on the grid
+    auto& l = FleetLayouts::instance();
+    long expected = 0;
+    for (int d = 0; d < 180; d++)
+        for (int s = 0; s < 100; s++)
+        {
+            ShipsGrid g;
+            g.tryPlace(l.getPlacements(3)[0].squares, 3);
+            if (g.tryPlace(l.getPlacements(2)[d].squares, 2) == PS_OK
+                    && g.tryPlace(l.getPlacements(1)[s].squares, 1) == PS_OK)
+            {
+                expected++;
+                EXPECT_GE(l.indexOf({{ s, d, 0 }}), 0);
+            }
+            else
+                EXPECT_EQ(l.indexOf({{ s, d, 0 }}), -1);
+        }
+
+    long found = 0;
+    for (std::size_t i = 0; i < l.size() && l.at(i)[2] == 0; i++)
+        found++;
+    EXPECT_EQ(found, expected);
+}
+
+TEST(FleetLayoutsTest, sample)
+{
+    auto& l = FleetLayouts::instance();
+    Random r(3);
+    for (int i = 0; i < 100; i++)
+        EXPECT_GE(l.indexOf(l.sample(r)), 0);
+
+    EXPECT_EQ(l.indexOf({{ 100, 0, 0 }}), -1);
+    EXPECT_EQ(l.indexOf({{ -1, 0, 0 }}), -1);
+}
@@ -0,0 +1,223 @@
+#include "GameJournal.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace battleship;
+using std::make_unique;
+using std::string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    void shootAll(Player& a, Player& b, int player, int round, GameJournalWriter& journal)
+    {
+        while (a.canShoot())
+        {
+            int before[Ship::MAX_LENGTH];
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                before[l - 1] = a.getPrimaryGird().getShip(l).getShots();
+            auto p = a.shoot();
+            auto sr = b.takeShot(p);
+            a.update(p, sr);
+
+            int length = 0;
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                if (a.getPrimaryGird().getShip(l).getShots() != before[l - 1])
+                    length = l;
+            journal.shot(player, { length, Bitboard::toIndex(p) }, sr, round);
+        }
+    }
+
+    // rounds of random game written to the journal, states after every round are added to states
+    void playRounds(Player& a, Player& b, int rounds, GameJournalWriter& journal, vector<GameState>& states)
+    {
+        for (int r = 0; r < rounds; r++)
+        {
+            const int round = a.getFinishedRounds() + 1;
+            shootAll(a, b, 0, round, journal);
+            shootAll(b, a, 1, round, journal);
+            a.nextRound();
+            b.nextRound();
+            journal.endRound(round);
+            states.push_back(GameState::fromPlayers(a, b, 20));
+        }
+    }
+
+    string tempPath()
+    {
+        return (fs::temp_directory_path() / fs::unique_path()).string();
+    }
+}
+
+
+TEST(GameJournalTest, replay_rounds)
+{
+    const string path = tempPath();
+    AIPlayer a(make_unique<RandomStrategy>(Random(1, 1)), Random(1, 0));
+    AIPlayer b(make_unique<RandomStrategy>(Random(1, 3)), Random(1, 2));
+    a.setUpShips();
+    b.setUpShips();
+
+    vector<GameState> states = { GameState::fromPlayers(a, b, 20) };
+    {
+        GameJournalWriter journal(path, GameJournal::makeHeader(20, 7, "random", "greedy"), states.front());
+        playRounds(a, b, 8, journal, states);
+    }
+
+    MappedGameJournal m(path);
+    EXPECT_TRUE(GameJournal::isJournalFile(path));
+    EXPECT_EQ(m.header().seed, 7u);
+    EXPECT_EQ(m.getType(0), "random");
+    EXPECT_EQ(m.getType(1), "greedy");
+    EXPECT_EQ(m.firstRound(), 0);
+    EXPECT_EQ(m.lastRound(), 8);
+    EXPECT_EQ(m.finishedSize(), fs::file_size(path));
+    for (int r = 0; r <= 8; r++)
+        EXPECT_EQ(m.stateAt(r), states[r]) << "round " << r;
+    EXPECT_EQ(m.replay(m.size()), states.back());
+    EXPECT_THROW(m.stateAt(9), BattleshipRuntimeError);
+
+    // every shot is a record
+    int shots = 0;
+    for (std::size_t i = 0; i < m.size(); i++)
+        shots += m.at(i).type == GameJournal::JR_SHOT;
+    EXPECT_EQ(shots, states.back().getTargeted(0).count() + states.back().getTargeted(1).count());
+
+    fs::remove(path);
+}
+
+TEST(GameJournalTest, continue_after_crash)
+{
+    const string path = tempPath();
+    AIPlayer a(make_unique<RandomStrategy>(Random(2, 1)), Random(2, 0));
+    AIPlayer b(make_unique<RandomStrategy>(Random(2, 3)), Random(2, 2));
+    a.setUpShips();
+    b.setUpShips();
+
+    vector<GameState> states = { GameState::fromPlayers(a, b, 20) };
+    {
+        GameJournalWriter journal(path, GameJournal::makeHeader(20, 0, "random", "random"), states.front());
+        playRounds(a, b, 3, journal, states);
+    }
+
+    // the round in progress and a torn record at the end are not part of any round
+    const auto finished = fs::file_size(path);
+    {
+        std::ofstream f(path, std::ios_base::binary | std::ios_base::app);
+        GameJournal::Record r {};
+        r.type = GameJournal::JR_SHOT;
+        r.ship = 1;
+        r.round = 4;
+        f.write(reinterpret_cast<const char*>(&r), sizeof(r));
+        f.write(reinterpret_cast<const char*>(&r), sizeof(r) / 2);
+    }
+    {
+        MappedGameJournal m(path);
+        EXPECT_EQ(m.lastRound(), 3);
+        EXPECT_EQ(m.finishedSize(), finished);
+        EXPECT_EQ(m.stateAt(3), states.back());
+    }
+
+    // the game goes on from restored players
+    AIPlayer ra(make_unique<RandomStrategy>(Random(3, 1)), Random(3, 0));
+    AIPlayer rb(make_unique<RandomStrategy>(Random(3, 3)), Random(3, 2));
+    MappedGameJournal(path).stateAt(3).toPlayers(ra, rb);
+    {
+        GameJournalWriter journal(path);
+        EXPECT_EQ(fs::file_size(path), finished);
+        playRounds(ra, rb, 2, journal, states);
+    }
+
+    MappedGameJournal m(path);
+    EXPECT_EQ(m.lastRound(), 5);
+    for (int r = 0; r <= 5; r++)
+        EXPECT_EQ(m.stateAt(r), states[r]) << "round " << r;
+
+    fs::remove(path);
+}
+
+TEST(GameJournalTest, start_from_loaded_state)
+{
+    const string path = tempPath();
+    AIPlayer a(make_unique<RandomStrategy>(Random(4, 1)), Random(4, 0));
+    AIPlayer b(make_unique<RandomStrategy>(Random(4, 3)), Random(4, 2));
+    a.setUpShips();
+    b.setUpShips();
+
+    // history of the first rounds is not known, the journal starts from their state
+    vector<GameState> states;
+    {
+        const string skipped = tempPath();
+        GameJournalWriter journal(skipped, GameJournal::makeHeader(20, 0, "random", "random"),
+                                  GameState::fromPlayers(a, b, 20));
+        playRounds(a, b, 4, journal, states);
+        fs::remove(skipped);
+    }
+    states = { states.back() };
+    {
+        GameJournalWriter journal(path, GameJournal::makeHeader(20, 0, "random", "random"), states.front());
+        playRounds(a, b, 2, journal, states);
+    }
+
+    MappedGameJournal m(path);
+    EXPECT_EQ(m.firstRound(), 4);
+    EXPECT_EQ(m.lastRound(), 6);
+    for (int r = 4; r <= 6; r++)
+        EXPECT_EQ(m.stateAt(r), states[r - 4]) << "round " << r;
+    EXPECT_THROW(m.stateAt(3), BattleshipRuntimeError);
+
+    fs::remove(path);
+}
+
+TEST(GameJournalTest, broken_journal)
+{
+    const string path = tempPath();
+    AIPlayer a(make_unique<RandomStrategy>(Random(5, 1)), Random(5, 0));
+    AIPlayer b(make_unique<RandomStrategy>(Random(5, 3)), Random(5, 2));
+    a.setUpShips();
+    b.setUpShips();
+
+    vector<GameState> states;
+    {
+        GameJournalWriter journal(path, GameJournal::makeHeader(20, 0, "random", "random"),
+                                  GameState::fromPlayers(a, b, 20));
+        playRounds(a, b, 2, journal, states);
+    }
+
+    // result of the first shot is changed
+    {
+        MappedGameJournal m(path);
+        std::size_t first = m.roundEnd(0);
+        auto r = m.at(first);
+        r.result = r.result == SR_MISS ? SR_HIT : SR_MISS;
+        std::fstream f(path, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+        f.seekp(sizeof(GameJournal::Header) + first * sizeof(GameJournal::Record));
+        f.write(reinterpret_cast<const char*>(&r), sizeof(r));
+    }
+    {
+        MappedGameJournal m(path);
+        EXPECT_NO_THROW(m.stateAt(0));
+        EXPECT_THROW(m.stateAt(1), BattleshipRuntimeError);
+    }
+
+    // not a journal
+    {
+        std::ofstream f(path, std::ios_base::trunc);
+        f << "rounds = 10\n";
+    }
+    EXPECT_FALSE(GameJournal::isJournalFile(path));
+    EXPECT_THROW(MappedGameJournal m(path), BattleshipRuntimeError);
+
+    fs::remove(path);
+    EXPECT_FALSE(GameJournal::isJournalFile(path));
+    EXPECT_THROW(MappedGameJournal m(path), BattleshipRuntimeError);
+}
@@ -2,12 +2,41 @@
 #include "test/UI_mock.h"
 
 #include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
 #include <memory>
 
 using namespace battleship;
 using battleship_test::MockUI;
 using std::vector;
 using std::string;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    void runGame(const vector<string>& v)
+    {
+        vector<char*> argv;
+        for (const auto& arg : v)
+            argv.push_back((char*)arg.data());
+        argv.push_back(nullptr);
+
+        GameLogic g(argv.size() - 1, argv.data(), std::make_shared<MockUI>());
+        g.run();
+    }
+
+    // file content without the first line with the time of saving
+    string readState(const string& path)
+    {
+        std::ifstream f(path);
+        std::stringstream ss;
+        string line;
+        std::getline(f, line);
+        ss << f.rdbuf();
+        return ss.str();
+    }
+}
 
 TEST(GameLogicTest, constructor_long_args_names)
 {
@@ -44,3 +73,159 @@ TEST(GameLogicTest, constructor_no_args_names)
 
     GameLogic g(argv.size() - 1, argv.data(), std::make_shared<MockUI>());
 }
+
+TEST(GameLogicTest, simulate_args)
+{
+    vector<string> v = { "app", "10", "greedy", "random", "--simulate", "5" };
+
+    vector<char*> argv;
+    for (const auto& arg : v)
+        argv.push_back((char*)arg.data());
+    argv.push_back(nullptr);
+
+    GameLogic g(argv.size() - 1, argv.data(), std::make_shared<MockUI>());
+
+    // simulation requires ai player on both sides
+    v = { "app", "10", "greedy", "--simulate", "5" };
+    argv.clear();
+    for (const auto& arg : v)
+        argv.push_back((char*)arg.data());
+    argv.push_back(nullptr);
+
+    EXPECT_THROW(GameLogic(argv.size() - 1, argv.data(), std::make_shared<MockUI>()), ArgumentsError);
+}
+
+TEST(GameLogicTest, convert_save)
+{
+    const string text = (fs::temp_directory_path() / fs::unique_path()).string();
+    const string binary = (fs::temp_directory_path() / fs::unique_path()).string();
+    const string converted = (fs::temp_directory_path() / fs::unique_path()).string();
+
+    // the same order of lines as in saved game
+    const string state =
+            "number-round = 3\nrounds = 10\nopponent = random\nplayer = greedy\n"
+            "ship-1-player = 2\nship-1-player = 2\n"
+            "ship-2-player = 6\nship-2-player = 3\nship-2-player = 6\nship-2-player = 4\n"
+            "ships-pausing-player = 2\n"
+            "ship-3-player = 3\nship-3-player = 8\nship-3-player = 4\nship-3-player = 8\n"
+            "ship-3-player = 5\nship-3-player = 8\n"
+            "ship-1-opponent = 0\nship-1-opponent = 0\n"
+            "ship-2-opponent = 9\nship-2-opponent = 0\nship-2-opponent = 9\nship-2-opponent = 1\n"
+            "ship-3-opponent = 0\nship-3-opponent = 9\nship-3-opponent = 1\nship-3-opponent = 9\n"
+            "ship-3-opponent = 2\nship-3-opponent = 9\n"
+            "ships-pausing-opponent = 3\n"
+            "htis-player = 0\nhtis-player = 0\nhtis-player = 5\nhtis-player = 5\n"
+            "htis-player = 9\nhtis-player = 0\n"
+            "htis-opponent = 2\nhtis-opponent = 2\nhtis-opponent = 4\nhtis-opponent = 8\n"
+            "htis-opponent = 7\nhtis-opponent = 7\n";
+    {
+        std::ofstream f(text);
+        f << "state-info = 2026-1-1_0:0:0\n" << state;
+    }
+
+    runGame({ "app", "--load", text, "--save", binary, "--save-format", "binary", "--convert" });
+    EXPECT_TRUE(fs::exists(binary));
+    runGame({ "app", "--load", binary, "--save", converted, "--save-format", "text", "--convert" });
+    EXPECT_EQ(readState(converted), state) << "game should not change after converting it twice";
+
+    runGame({ "app", "--load", text, "--save", binary, "--save-format", "journal", "--convert" });
+    runGame({ "app", "--load", binary, "--save", converted, "--save-format", "text", "--convert" });
+    EXPECT_EQ(readState(converted), state) << "journal should start from the loaded game";
+
+    // converting requires file to load
+    EXPECT_THROW(runGame({ "app", "10", "greedy", "random", "--convert" }), ArgumentsError);
+    EXPECT_THROW(runGame({ "app", "--load", text, "--save-format", "xml" }), ArgumentsError);
+
+    fs::remove(text);
+    fs::remove(binary);
+    fs::remove(converted);
+}
+
+TEST(GameLogicTest, load_text_state)
+{
+    const string text = (fs::temp_directory_path() / fs::unique_path()).string();
+    const string converted = (fs::temp_directory_path() / fs::unique_path()).string();
+
+    const string ships =
+            "ship-1-player = 2\nship-1-player = 2\n"
+            "ship-2-player = 6\nship-2-player = 3\nship-2-player = 6\nship-2-player = 4\n"
+            "ship-1-opponent = 0\nship-1-opponent = 0\n"
+            "ship-2-opponent = 9\nship-2-opponent = 0\nship-2-opponent = 9\nship-2-opponent = 1\n"
+            "ship-3-opponent = 0\nship-3-opponent = 9\nship-3-opponent = 1\nship-3-opponent = 9\n"
+            "ship-3-opponent = 2\nship-3-opponent = 9\n";
+    const string triple =
+            "ship-3-player = 3\nship-3-player = 8\nship-3-player = 4\nship-3-player = 8\n"
+            "ship-3-player = 5\nship-3-player = 8\n";
+    auto load = [&](const string& state)
+    {
+        std::ofstream f(text);
+        f << "state-info = 2026-1-1_0:0:0\n" << state;
+        f.close();
+        runGame({ "app", "--load", text, "--save", converted, "--convert" });
+    };
+    const string header = "number-round = 2\nrounds = 10\nopponent = random\nplayer = greedy\n";
+
+    // sunk ship and hits in any order
+    EXPECT_NO_THROW(load(header + ships + triple + "htis-player = 9\nhtis-player = 1\nhtis-player = 0\nhtis-player = 0\n"
+                         "htis-player = 9\nhtis-player = 0\nhtis-opponent = 4\nhtis-opponent = 8\n"));
+    EXPECT_NE(readState(converted).find("htis-player = 9\nhtis-player = 1\n"), string::npos);
+
+    // ship out of the grid
+    EXPECT_THROW(load(header + ships + "ship-3-player = 8\nship-3-player = 8\nship-3-player = 9\nship-3-player = 8\n"
+                      "ship-3-player = 10\nship-3-player = 8\n"), ArgumentsError);
+    // ship which is not straight
+    EXPECT_THROW(load(header + ships + "ship-3-player = 3\nship-3-player = 8\nship-3-player = 4\nship-3-player = 8\n"
+                      "ship-3-player = 4\nship-3-player = 9\n"), ArgumentsError);
+    // ships touch each other
+    EXPECT_THROW(load(header + ships + "ship-3-player = 7\nship-3-player = 3\nship-3-player = 8\nship-3-player = 3\n"
+                      "ship-3-player = 9\nship-3-player = 3\n"), ArgumentsError);
+    // shot out of the grid
+    EXPECT_THROW(load(header + ships + triple + "htis-player = 0\nhtis-player = -1\n"), ArgumentsError);
+    // wrong pausing ship
+    EXPECT_THROW(load(header + ships + triple + "ships-pausing-player = 4\n"), ArgumentsError);
+    // more rounds than the game has
+    EXPECT_THROW(load("number-round = 11\nrounds = 10\nopponent = random\nplayer = greedy\n" + ships + triple),
+                 ArgumentsError);
+
+    fs::remove(text);
+    fs::remove(converted);
+}
+
+TEST(GameLogicTest, step_game)
+{
+    const string save = (fs::temp_directory_path() / fs::unique_path()).string();
+    vector<string> v = { "app", "3", "random", "greedy", "--save", save };
+    vector<char*> argv;
+    for (const auto& arg : v)
+        argv.push_back((char*)arg.data());
+    argv.push_back(nullptr);
+
+    // ai players never wait for input and their delays are left to the caller
+    GameLogic g(argv.size() - 1, argv.data(), std::make_shared<MockUI>());
+    EXPECT_EQ(g.getStatus(), GS_RUNNING);
+    int steps = 0;
+    int delays = 0;
+    GameStep s { GS_RUNNING, 0 };
+    while (s.status != GS_OVER && steps < 1000)
+    {
+        s = g.step();
+        EXPECT_NE(s.status, GS_AWAITING_INPUT);
+        steps++;
+        if (s.delay_ms > 0)
+            delays++;
+    }
+    EXPECT_EQ(s.status, GS_OVER);
+    EXPECT_GT(delays, 0);
+    EXPECT_EQ(g.step().status, GS_OVER);
+
+    // human player places ships first
+    vector<string> h = { "app", "3", "random", "human", "--save", save };
+    argv.clear();
+    for (const auto& arg : h)
+        argv.push_back((char*)arg.data());
+    argv.push_back(nullptr);
+    GameLogic human(argv.size() - 1, argv.data(), std::make_shared<MockUI>());
+    EXPECT_EQ(human.getStatus(), GS_AWAITING_INPUT);
+
+    fs::remove(save);
+}
@@ -0,0 +1,127 @@
+#include "GameSnapshot.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace battleship;
+using std::make_unique;
+using std::string;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    // players after a few rounds of random game
+    void playRounds(Player& a, Player& b, int rounds)
+    {
+        for (int r = 0; r < rounds; r++)
+        {
+            while (a.canShoot())
+            {
+                auto p = a.shoot();
+                a.update(p, b.takeShot(p));
+            }
+            while (b.canShoot())
+            {
+                auto p = b.shoot();
+                b.update(p, a.takeShot(p));
+            }
+            a.nextRound();
+            b.nextRound();
+        }
+    }
+
+    void expectSamePlayers(const Player& p1, const Player& p2)
+    {
+        for (int a = 0; a < 10; a++)
+            for (int b = 0; b < 10; b++)
+            {
+                EXPECT_EQ(p1.getPrimaryGird().at({a,b}), p2.getPrimaryGird().at({a,b}));
+                EXPECT_EQ(p1.getSecondaryGrid().at({a,b}), p2.getSecondaryGrid().at({a,b}));
+            }
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            EXPECT_EQ(p1.getPrimaryGird().getShip(l).getHits(), p2.getPrimaryGird().getShip(l).getHits());
+            EXPECT_EQ(p1.getPrimaryGird().getShip(l).isPausing(), p2.getPrimaryGird().getShip(l).isPausing());
+        }
+        EXPECT_EQ(p1.canShoot(), p2.canShoot());
+    }
+}
+
+
+TEST(GameSnapshotTest, dummy)
+{
+    (void)GameSnapshot::make();
+}
+
+TEST(GameSnapshotTest, restore_players)
+{
+    for (int rounds = 0; rounds < 6; rounds++)
+    {
+        AIPlayer a(make_unique<RandomStrategy>(Random(rounds, 1)), Random(rounds, 0));
+        AIPlayer b(make_unique<RandomStrategy>(Random(rounds, 3)), Random(rounds, 2));
+        a.setUpShips();
+        b.setUpShips();
+        playRounds(a, b, rounds);
+
+        auto s = GameSnapshot::make();
+        s.setPlayer(0, a, "random");
+        s.setPlayer(1, b, "greedy");
+        EXPECT_EQ(s.getType(0), "random");
+        EXPECT_EQ(s.getType(1), "greedy");
+
+        AIPlayer ra(make_unique<RandomStrategy>());
+        AIPlayer rb(make_unique<RandomStrategy>());
+        s.restorePlayer(0, ra);
+        s.restorePlayer(1, rb);
+        expectSamePlayers(a, ra);
+        expectSamePlayers(b, rb);
+    }
+}
+
+TEST(GameSnapshotTest, file)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+
+    auto s = GameSnapshot::make();
+    s.round_number = 7;
+    s.max_rounds = 12;
+    s.seed = 42;
+    s.write(path);
+    {
+        MappedSnapshot m(path);
+        EXPECT_TRUE(GameSnapshot::isSnapshotFile(path));
+        EXPECT_EQ(m.get().round_number, 7);
+        EXPECT_EQ(m.get().max_rounds, 12);
+        EXPECT_EQ(m.get().seed, 42u);
+    }
+
+    // wrong version
+    s.version = GameSnapshot::VERSION + 1;
+    s.write(path);
+    EXPECT_THROW(MappedSnapshot m(path), BattleshipRuntimeError);
+
+    // truncated file
+    {
+        std::ofstream f(path, std::ios_base::binary | std::ios_base::trunc);
+        f.write(reinterpret_cast<const char*>(&s), sizeof(s) / 2);
+    }
+    EXPECT_THROW(MappedSnapshot m(path), BattleshipRuntimeError);
+
+    // text save
+    {
+        std::ofstream f(path, std::ios_base::trunc);
+        f << "rounds = 10\n";
+    }
+    EXPECT_FALSE(GameSnapshot::isSnapshotFile(path));
+    EXPECT_THROW(MappedSnapshot m(path), BattleshipRuntimeError);
+
+    fs::remove(path);
+    EXPECT_FALSE(GameSnapshot::isSnapshotFile(path));
+    EXPECT_THROW(MappedSnapshot m(path), BattleshipRuntimeError);
+}
@@ -0,0 +1,198 @@
+#include "GameState.h"
+#include "FleetLayouts.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+#include <type_traits>
+
+using namespace battleship;
+using std::make_unique;
+
+namespace
+{
+    void expectSameRules(const GameState& s, const Player& main, const Player& opponent)
+    {
+        EXPECT_EQ(s.canShoot(0), main.canShoot());
+        EXPECT_EQ(s.canShoot(1), opponent.canShoot());
+        EXPECT_EQ(s.mayShootNextRounds(0), main.mayShootNextRounds());
+        EXPECT_EQ(s.mayShootNextRounds(1), opponent.mayShootNextRounds());
+        EXPECT_EQ(s.getHits(0), main.getHits());
+        EXPECT_EQ(s.getHits(1), opponent.getHits());
+    }
+
+    void expectSamePlayers(const Player& p1, const Player& p2)
+    {
+        for (auto t : { ST_HIT, ST_MISS, ST_SUNK, ST_EMPTY })
+        {
+            EXPECT_EQ(p1.getPrimaryGird().getPlane(t), p2.getPrimaryGird().getPlane(t));
+            EXPECT_EQ(p1.getSecondaryGrid().getPlane(t), p2.getSecondaryGrid().getPlane(t));
+        }
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            const auto& s1 = p1.getPrimaryGird().getShip(l);
+            const auto& s2 = p2.getPrimaryGird().getShip(l);
+            EXPECT_EQ(s1.getOccupiedMask(), s2.getOccupiedMask());
+            EXPECT_EQ(s1.getHits(), s2.getHits());
+            EXPECT_EQ(s1.getShots(), s2.getShots());
+            EXPECT_EQ(s1.isPausing(), s2.isPausing());
+        }
+        EXPECT_EQ(p1.getFinishedRounds(), p2.getFinishedRounds());
+        EXPECT_EQ(p1.canShoot(), p2.canShoot());
+        EXPECT_EQ(p1.mayShootNextRounds(), p2.mayShootNextRounds());
+    }
+
+    // players restored from the state have to be the same as the original ones and give the same state back
+    void expectLosslessConversion(const Player& main, const Player& opponent, int turn)
+    {
+        const auto s = GameState::fromPlayers(main, opponent, 20, turn);
+        AIPlayer m(make_unique<RandomStrategy>());
+        AIPlayer o(make_unique<RandomStrategy>());
+        s.toPlayers(m, o);
+        expectSamePlayers(main, m);
+        expectSamePlayers(opponent, o);
+        EXPECT_EQ(GameState::fromPlayers(m, o, 20, turn), s);
+    }
+}
+
+
+TEST(GameStateTest, dummy)
+{
+    (void)GameState();
+}
+
+TEST(GameStateTest, plain_struct)
+{
+    EXPECT_TRUE(std::is_trivially_copyable<GameState>::value);
+    EXPECT_LT(sizeof(GameState), 128u);
+}
+
+TEST(GameStateTest, apply)
+{
+    // ships of the opponent: (0,0),  (2,0)(2,1),  (5,5)(5,6)(5,7)
+    GameState s {};
+    s.max_rounds = 20;
+    s.sides[1].fleet[0] = FleetLayouts::instance().placementIndex(1, Bitboard::fromSquare({0,0}));
+    s.sides[1].fleet[1] = FleetLayouts::instance().placementIndex(2, Bitboard::fromSquare({2,0}) | Bitboard::fromSquare({2,1}));
+    s.sides[1].fleet[2] = FleetLayouts::instance().placementIndex(
+            3, Bitboard::fromSquare({5,5}) | Bitboard::fromSquare({5,6}) | Bitboard::fromSquare({5,7}));
+
+    EXPECT_EQ(s.apply({ 3, Bitboard::toIndex({5,6}) }), SR_HIT);
+    EXPECT_FALSE(s.canShoot(0, 1)) << "other ships pause after the first shot";
+    EXPECT_FALSE(s.canShoot(0, 2));
+    EXPECT_EQ(s.apply({ 3, Bitboard::toIndex({9,9}) }), SR_MISS);
+    EXPECT_FALSE(s.canShoot(0, 3)) << "triple ship fires at most two shots in a round";
+    EXPECT_EQ(s.getHits(1), 1);
+
+    s.endTurn();
+    s.nextRound();
+    EXPECT_EQ(s.round, 1);
+    EXPECT_EQ(s.turn, 0);
+    EXPECT_FALSE(s.canShoot(0, 3)) << "ship which fired two shots pauses in the next round";
+    EXPECT_TRUE(s.canShoot(0, 1));
+    EXPECT_TRUE(s.mayShootNextRounds(0));
+    EXPECT_EQ(s.apply({ 1, Bitboard::toIndex({0,0}) }), SR_SUNK);
+    EXPECT_TRUE(s.isSunk(1, 1));
+}
+
+TEST(GameStateTest, same_rules_as_players)
+{
+    // shots of random players are replayed on the state, both have to agree all the time
+    for (int seed = 0; seed < 20; seed++)
+    {
+        AIPlayer main(make_unique<RandomStrategy>(Random(seed, 1)), Random(seed, 0));
+        AIPlayer opponent(make_unique<RandomStrategy>(Random(seed, 3)), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+        auto s = GameState::fromPlayers(main, opponent, 20);
+
+        for (int round = 0; round < 20; round++)
+        {
+            expectSameRules(s, main, opponent);
+            while (main.canShoot())
+            {
+                auto p = main.shoot();
+                int length = 0;
+                for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                    if (main.getPrimaryGird().getShip(l).getShots() > 0)
+                        length = l;
+                const auto r = opponent.takeShot(p);
+                main.update(p, r);
+                EXPECT_EQ(s.apply({ length, Bitboard::toIndex(p) }), r);
+            }
+            s.endTurn();
+            expectSameRules(s, main, opponent);
+            while (opponent.canShoot())
+            {
+                auto p = opponent.shoot();
+                int length = 0;
+                for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                    if (opponent.getPrimaryGird().getShip(l).getShots() > 0)
+                        length = l;
+                const auto r = main.takeShot(p);
+                opponent.update(p, r);
+                EXPECT_EQ(s.apply({ length, Bitboard::toIndex(p) }), r);
+            }
+            main.nextRound();
+            opponent.nextRound();
+            s.nextRound();
+        }
+        expectSameRules(s, main, opponent);
+    }
+}
+
+TEST(GameStateTest, convert_players)
+{
+    // conversion after every shot, also in the middle of a turn
+    for (int seed = 0; seed < 10; seed++)
+    {
+        AIPlayer main(make_unique<RandomStrategy>(Random(seed, 1)), Random(seed, 0));
+        AIPlayer opponent(make_unique<RandomStrategy>(Random(seed, 3)), Random(seed, 2));
+        main.setUpShips();
+        opponent.setUpShips();
+
+        for (int round = 0; round < 20; round++)
+        {
+            expectLosslessConversion(main, opponent, 0);
+            while (main.canShoot())
+            {
+                auto p = main.shoot();
+                main.update(p, opponent.takeShot(p));
+                expectLosslessConversion(main, opponent, 0);
+            }
+            while (opponent.canShoot())
+            {
+                auto p = opponent.shoot();
+                opponent.update(p, main.takeShot(p));
+                expectLosslessConversion(main, opponent, 1);
+            }
+            main.nextRound();
+            opponent.nextRound();
+        }
+    }
+}
+
+TEST(GameStateTest, convert_errors)
+{
+    AIPlayer main(make_unique<RandomStrategy>(Random(1)), Random(2));
+    AIPlayer opponent(make_unique<RandomStrategy>(Random(3)), Random(4));
+    main.setUpShips();
+    EXPECT_THROW(GameState::fromPlayers(main, opponent, 20), BattleshipLogicError) << "ships are not placed";
+
+    opponent.setUpShips();
+    const auto s = GameState::fromPlayers(main, opponent, 20);
+    EXPECT_THROW(s.toPlayers(main, opponent), BattleshipLogicError) << "ships are already placed";
+
+    // shot which the opponent did not take
+    main.update({0,0}, SR_MISS);
+    main.update({9,9}, SR_MISS);
+    if (opponent.getPrimaryGird().getPlane(ST_EMPTY).test(0) && opponent.getPrimaryGird().getPlane(ST_EMPTY).test(99))
+    {
+        EXPECT_THROW(GameState::fromPlayers(main, opponent, 20), BattleshipRuntimeError);
+    }
+
+    main.nextRound();
+    EXPECT_THROW(GameState::fromPlayers(main, opponent, 20), BattleshipRuntimeError) << "different rounds";
+}
@@ -2,10 +2,28 @@
 
 #include "gtest/gtest.h"
 
-using battleship::GreedyStrategy;
+using namespace battleship;
 
 TEST(GreedyStrategyTest, dummy)
 {
     (void)GreedyStrategy();
 }
 
+TEST(GreedyStrategyTest, choose_longest_ship)
+{
+    GreedyStrategy g;
+
+    ShipsLengths l;
+    l.push_back(2);
+    l.push_back(1);
+    EXPECT_EQ(g.chooseShip(l), 2);
+    l.push_back(3);
+    EXPECT_EQ(g.chooseShip(l), 3);
+
+    SquareSet s;
+    s.insert({4,4});
+    EXPECT_EQ(g.chooseSquare(s), std::make_pair(4,4));
+
+    EXPECT_THROW(g.chooseShip(ShipsLengths()), BattleshipRuntimeError);
+    EXPECT_THROW(g.chooseSquare(SquareSet()), BattleshipRuntimeError);
+}
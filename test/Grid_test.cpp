@@ -295,3 +295,71 @@ TEST(GridTest, errors_wrong_input_from_other_player)
     g.update({0, 8}, SR_HIT);
     EXPECT_THROW(g.update({0,7}, SR_SUNK), BattleshipRuntimeError) << "cannot sunk ship with the same length twice";
 }
+
+TEST(GridTest, hit_clusters)
+{
+    Grid g;
+
+    // squares touching diagonally belong to the same cluster, also across the words of planes
+    g.update({6, 3}, SR_HIT);
+    g.update({5, 4}, SR_HIT);
+    g.update({4, 5}, SR_HIT);
+    EXPECT_THROW(g.update({3, 6}, SR_HIT), BattleshipRuntimeError) << "ship too long";
+    EXPECT_EQ(g.at({3, 6}), ST_EMPTY) << "failed update should not change the grid";
+
+    // cluster separated by an empty square is independent
+    g.update({1, 1}, SR_HIT);
+    g.update({1, 0}, SR_SUNK);
+    EXPECT_EQ(g.getPlane(ST_SUNK), Bitboard::fromSquare({1, 0}) | Bitboard::fromSquare({1, 1}));
+    EXPECT_EQ(g.getPlane(ST_HIT).count(), 3);
+}
+
+TEST(GridTest, planes)
+{
+    Grid g;
+    EXPECT_EQ(g.getPlane(ST_EMPTY), Bitboard::full()) << "initially all squares should be empty";
+
+    g.update({ 2, 2 }, SR_MISS);
+    g.update({ 5, 5 }, SR_HIT);
+    g.update({ 7, 0 }, SR_SUNK);
+
+    EXPECT_EQ(g.getPlane(ST_MISS), Bitboard::fromSquare({ 2, 2 }));
+    EXPECT_EQ(g.getPlane(ST_HIT), Bitboard::fromSquare({ 5, 5 }));
+    EXPECT_EQ(g.getPlane(ST_SUNK), Bitboard::fromSquare({ 7, 0 }));
+    EXPECT_EQ(g.getPlane(ST_EMPTY).count(), 97);
+
+    g.update({ 5, 6 }, SR_SUNK);
+    EXPECT_TRUE(g.getPlane(ST_HIT).empty()) << "sunk ship's squares should be moved to sunk plane";
+    EXPECT_EQ(g.getPlane(ST_SUNK).count(), 3);
+
+    Ship s;
+    s.setOccupiedSquares(Ship::makeVectorPtr({ make_pair(3,4) }));
+    auto m = g.getAvailableMask(s);
+    EXPECT_EQ(m, Bitboard::rectangle(1, 2, 5, 6) & ~Bitboard::fromSquare({ 2, 2 }) & ~Bitboard::fromSquare({ 5, 5 })
+              & ~Bitboard::fromSquare({ 5, 6 }));
+}
+
+TEST(GridTest, restore)
+{
+    Grid played;
+    played.update({ 0, 0 }, SR_MISS);
+    played.update({ 4, 4 }, SR_HIT);
+    played.update({ 7, 7 }, SR_HIT);
+    played.update({ 7, 8 }, SR_SUNK);
+
+    Grid g;
+    g.restore(played.getPlane(ST_HIT), played.getPlane(ST_MISS), played.getPlane(ST_SUNK));
+    for (int a = 0; a < 10; ++a)
+        for (int b = 0; b < 10; ++b)
+            EXPECT_EQ(g.at({a,b}), played.at({a,b}));
+
+    // lengths of sunk ships are restored too
+    g.update({ 2, 0 }, SR_HIT);
+    EXPECT_THROW(g.update({ 2, 1 }, SR_SUNK), BattleshipRuntimeError) << "double ship was already sunk";
+    EXPECT_NO_THROW(g.update({ 9, 0 }, SR_SUNK));
+
+    EXPECT_THROW(g.restore(Bitboard::full(), Bitboard::full(), Bitboard()), BattleshipRuntimeError)
+            << "planes cannot overlap";
+    EXPECT_THROW(g.restore(Bitboard(), Bitboard(), Bitboard::rectangle(0, 0, 0, 1) | Bitboard::rectangle(5, 0, 5, 1)),
+                 BattleshipRuntimeError) << "two sunk ships with the same length";
+}
@@ -0,0 +1,77 @@
+#include "LockstepSimulation.h"
+#include "StaticAIPlayer.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+
+#include "gtest/gtest.h"
+
+using namespace battleship;
+
+namespace
+{
+    // games in lockstep have to end like games of players with the generators of Tournament::playGame
+    template<typename Main, typename Opponent>
+    void expectSameGames(int max_rounds, BatchIsa isa)
+    {
+        const std::uint64_t seed = 11;
+        const LockstepSimulation lockstep(max_rounds, &Main::chooseShots, &Opponent::chooseShots, isa);
+        const auto results = lockstep.playGames(seed, 100, 300);
+        ASSERT_EQ(200u, results.size());
+
+        for (long i = 100; i < 300; i++)
+        {
+            const auto game_seed = Random::deriveSeed(seed, i);
+            StrategyOptions options;
+            StaticAIPlayer<Main> main(Random(game_seed, 1), options, Random(game_seed, 0));
+            StaticAIPlayer<Opponent> opponent(Random(game_seed, 3), options, Random(game_seed, 2));
+            main.setUpShips();
+            opponent.setUpShips();
+            const auto expected = Simulation(max_rounds).playStaticGame(main, opponent);
+            EXPECT_EQ(expected.outcome, results[i - 100].outcome) << "game " << i;
+            EXPECT_EQ(expected.rounds, results[i - 100].rounds) << "game " << i;
+        }
+    }
+}
+
+
+TEST(LockstepSimulationTest, logic_errors)
+{
+    EXPECT_THROW(LockstepSimulation(20, nullptr, &RandomStrategy::chooseShots), BattleshipLogicError);
+    EXPECT_THROW(LockstepSimulation(20, &RandomStrategy::chooseShots, nullptr), BattleshipLogicError);
+}
+
+TEST(LockstepSimulationTest, no_games)
+{
+    EXPECT_TRUE(LockstepSimulation(20, &RandomStrategy::chooseShots, &RandomStrategy::chooseShots).playGames(1, 5, 5).empty());
+}
+
+TEST(LockstepSimulationTest, same_as_static_players)
+{
+    expectSameGames<RandomStrategy, RandomStrategy>(20, BI_AUTO);
+    expectSameGames<GreedyStrategy, RandomStrategy>(20, BI_AUTO);
+    expectSameGames<RandomStrategy, GreedyStrategy>(7, BI_SCALAR);
+    expectSameGames<GreedyStrategy, GreedyStrategy>(1, BI_AUTO);
+}
+
+TEST(LockstepSimulationTest, given_main_fleets)
+{
+    const auto& layouts = FleetLayouts::instance();
+    const LockstepSimulation lockstep(20, &GreedyStrategy::chooseShots, &RandomStrategy::chooseShots);
+    std::vector<FleetLayouts::Layout> fleets;
+    for (int i = 0; i < 50; i++)
+        fleets.push_back(layouts.at(i * 1000));
+    std::vector<GameState> states;
+    EXPECT_THROW(lockstep.playGames(3, 0, 10, fleets, states), BattleshipLogicError);
+
+    const auto results = lockstep.playGames(3, 0, 50, fleets, states);
+    ASSERT_EQ(50u, states.size());
+    for (int i = 0; i < 50; i++)
+    {
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            EXPECT_EQ(fleets[i][l - 1], states[i].sides[0].fleet[l - 1]);
+        if (results[i].outcome == GO_DRAW)
+        {
+            EXPECT_EQ(states[i].getHits(0), states[i].getHits(1));
+        }
+    }
+}
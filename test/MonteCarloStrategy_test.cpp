@@ -0,0 +1,176 @@
+#include "MonteCarloStrategy.h"
+#include "EndgameSolver.h"
+#include "FleetLayouts.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "Simulation.h"
+#include "test/Player_mock.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+#include <chrono>
+
+using namespace battleship;
+using battleship_test::MockPlayer;
+using std::make_unique;
+
+namespace
+{
+    StrategyOptions quickOptions(int threads)
+    {
+        StrategyOptions o;
+        o.think_ms = 5;
+        o.threads = threads;
+        return o;
+    }
+}
+
+
+TEST(MonteCarloStrategyTest, dummy)
+{
+    (void)MonteCarloStrategy(Random(1), quickOptions(1));
+}
+
+TEST(MonteCarloStrategyTest, rollout)
+{
+    Random rng(1);
+    for (int i = 0; i < 100; i++)
+    {
+        GameState s {};
+        s.max_rounds = 1 + i % 20;
+        for (auto& side : s.sides)
+        {
+            const auto layout = FleetLayouts::instance().sample(rng);
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                side.fleet[l - 1] = layout[l - 1];
+        }
+        const double v = MonteCarloStrategy::rollout(s, rng);
+        EXPECT_GE(v, -0.06);
+        EXPECT_LE(v, 1.06);
+    }
+}
+
+TEST(MonteCarloStrategyTest, choose_within_budget)
+{
+    for (int threads : { 1, 2 })
+    {
+        MockPlayer p;
+        p.mockSetUpShips();
+        p.update({5,5}, SR_HIT);
+        p.update({0,0}, SR_MISS);
+
+        MonteCarloStrategy s(Random(1), quickOptions(threads));
+        ShipsLengths l;
+        l.push_back(1);
+        l.push_back(2);
+        l.push_back(3);
+
+        const auto start = std::chrono::steady_clock::now();
+        const int length = s.chooseShip(l, p);
+        const auto squares = SquareSet(p.getUntargetedMask(p.getPrimaryGird().getShip(length)));
+        const auto square = s.chooseSquare(squares, p);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+        EXPECT_TRUE(squares.contains(square));
+        EXPECT_EQ(s.getStats().decisions, 1);
+        EXPECT_GT(s.getStats().rollouts, 0);
+
+        EXPECT_THROW(s.chooseShip(ShipsLengths(), p), BattleshipRuntimeError);
+        EXPECT_THROW(s.chooseSquare(SquareSet(), p), BattleshipRuntimeError);
+    }
+}
+
+TEST(MonteCarloStrategyTest, play_games)
+{
+    // both sides of the game, every shot has to be legal
+    for (int seed = 0; seed < 4; seed++)
+    {
+        auto options = quickOptions(1);
+        options.max_rounds = 3;
+        options.moves_first = seed % 2 == 0;
+        AIPlayer mc(make_unique<MonteCarloStrategy>(Random(seed, 1), options), Random(seed, 0));
+        AIPlayer random(make_unique<RandomStrategy>(Random(seed, 3)), Random(seed, 2));
+        mc.setUpShips();
+        random.setUpShips();
+
+        const auto r = options.moves_first ? Simulation(3).playGame(mc, random) : Simulation(3).playGame(random, mc);
+        EXPECT_LE(r.rounds, 3);
+        EXPECT_GT(static_cast<const MonteCarloStrategy&>(mc.getStrategy()).getStats().decisions, 0);
+    }
+}
+
+TEST(MonteCarloStrategyTest, endgame)
+{
+    // both players have only their single ships, the opponent shot at almost every square
+    Random rng(2);
+    GameState s {};
+    s.max_rounds = 20;
+    s.round = 10;
+    for (auto& side : s.sides)
+    {
+        const auto layout = FleetLayouts::instance().sample(rng);
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            side.fleet[l - 1] = layout[l - 1];
+    }
+    const auto mine = s.getShip(1, 2) | s.getShip(1, 3) | (s.getUntargeted(0, 1) & ~s.getShip(1, 1));
+    auto left = s.getUntargeted(0, 1) & ~s.getShip(1, 1);
+    Bitboard keep;
+    keep.set(left.popLowest());
+    keep.set(left.popLowest());
+    s.sides[0].targeted[0] = (mine & ~keep).low();
+    s.sides[0].targeted[1] = (mine & ~keep).high();
+    const auto theirs = ~s.getShip(0, 1);
+    s.sides[1].targeted[0] = theirs.low();
+    s.sides[1].targeted[1] = theirs.high();
+    ASSERT_TRUE(s.canShoot(0, 1));
+
+    AIPlayer main(make_unique<RandomStrategy>());
+    AIPlayer opponent(make_unique<RandomStrategy>());
+    s.toPlayers(main, opponent);
+
+    auto options = quickOptions(1);
+    for (int squares : { 0, 12 })
+    {
+        options.endgame_squares = squares;
+        MonteCarloStrategy strategy(Random(1), options);
+        ShipsLengths l;
+        l.push_back(1);
+        const int length = strategy.chooseShip(l, main);
+        EXPECT_EQ(length, 1);
+        const auto squares_set = SquareSet(main.getUntargetedMask(main.getPrimaryGird().getShip(1)));
+        EXPECT_TRUE(squares_set.contains(strategy.chooseSquare(squares_set, main)));
+
+        // the solver replaces rollouts when it is on
+        if (squares == 0)
+        {
+            EXPECT_GT(strategy.getStats().rollouts, 0);
+            EXPECT_EQ(strategy.getStats().nodes, 0);
+        }
+        else
+        {
+            EXPECT_EQ(strategy.getStats().rollouts, 0);
+            EXPECT_GT(strategy.getStats().nodes, 0);
+        }
+    }
+}
+
+TEST(MonteCarloStrategyTest, endgame_within_budget)
+{
+    // every fleet of the first turn passes the threshold, the solver has to stop at the deadline
+    MockPlayer p;
+    p.mockSetUpShips();
+
+    auto options = quickOptions(1);
+    options.endgame_squares = 2 * Bitboard::SQUARES;
+    MonteCarloStrategy s(Random(1), options);
+    ShipsLengths l;
+    l.push_back(1);
+    l.push_back(2);
+    l.push_back(3);
+
+    const auto start = std::chrono::steady_clock::now();
+    const int length = s.chooseShip(l, p);
+    const auto squares = SquareSet(p.getUntargetedMask(p.getPrimaryGird().getShip(length)));
+    EXPECT_TRUE(squares.contains(s.chooseSquare(squares, p)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    EXPECT_GT(s.getStats().aborted_solves, 0);
+}
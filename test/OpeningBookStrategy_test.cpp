@@ -0,0 +1,101 @@
+#include "OpeningBookStrategy.h"
+#include "AIPlayer.h"
+#include "FleetLayouts.h"
+#include "test/ShootStrategy_mock.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <memory>
+#include <string>
+
+using namespace battleship;
+using battleship_test::MockShootStrategy;
+using std::make_unique;
+using std::make_shared;
+using std::string;
+using ::testing::_;
+using ::testing::Return;
+namespace fs = boost::filesystem;
+
+struct OpeningBookStrategyTest : public ::testing::Test
+{
+    // the book knows only the layout of the player, it shoots with the double ship at its two first squares in range
+    string path;
+    FleetLayouts::Layout layout;
+    OpeningBook::Entry entry {};
+    std::shared_ptr<const MappedOpeningBook> book;
+
+    OpeningBookStrategyTest()
+        : path((fs::temp_directory_path() / fs::unique_path()).string())
+    {
+        Random rng(3);
+        layout = FleetLayouts::instance().sample(rng);
+        auto range = FleetLayouts::instance().getPlacements(2)[layout[1]].range;
+        entry.layout = FleetLayouts::pack(layout);
+        entry.ship = 2;
+        entry.squares[0] = range.popLowest();
+        entry.squares[1] = range.popLowest();
+        OpeningBook::write(path, { entry });
+        book = make_shared<MappedOpeningBook>(path);
+    }
+
+    ~OpeningBookStrategyTest()
+    {
+        book.reset();
+        fs::remove(path);
+    }
+
+    // player with the strategy and ships of the layout
+    std::unique_ptr<AIPlayer> makePlayer(std::unique_ptr<MockShootStrategy> fallback)
+    {
+        auto p = make_unique<AIPlayer>(make_unique<OpeningBookStrategy>(book, std::move(fallback)), Random(3));
+        p->setUpShips();
+        return p;
+    }
+};
+
+TEST_F(OpeningBookStrategyTest, dummy)
+{
+    EXPECT_THROW(OpeningBookStrategy(nullptr, make_unique<MockShootStrategy>()), BattleshipLogicError);
+    EXPECT_THROW(OpeningBookStrategy(book, nullptr), BattleshipLogicError);
+}
+
+TEST_F(OpeningBookStrategyTest, first_turn_from_book)
+{
+    auto fallback = make_unique<MockShootStrategy>();
+    EXPECT_CALL(*fallback, chooseShipProxy(_)).Times(0);
+    EXPECT_CALL(*fallback, chooseSquareProxy(_)).Times(0);
+    auto p = makePlayer(std::move(fallback));
+    ASSERT_EQ(p->getPrimaryGird().getShip(2).getOccupiedMask(), FleetLayouts::instance().getPlacements(2)[layout[1]].mask);
+
+    const auto first = p->shoot();
+    EXPECT_EQ(first, Bitboard::toSquare(entry.squares[0]));
+    p->update(first, SR_MISS);
+    const auto second = p->shoot();
+    EXPECT_EQ(second, Bitboard::toSquare(entry.squares[1]));
+}
+
+TEST_F(OpeningBookStrategyTest, fallback_after_hit)
+{
+    auto fallback = make_unique<MockShootStrategy>();
+    EXPECT_CALL(*fallback, chooseShipProxy(_)).WillOnce(Return(2));
+    EXPECT_CALL(*fallback, chooseSquareProxy(_)).WillOnce(Return(Bitboard::toSquare(entry.squares[1])));
+    auto p = makePlayer(std::move(fallback));
+
+    const auto first = p->shoot();
+    EXPECT_EQ(first, Bitboard::toSquare(entry.squares[0]));
+    p->update(first, SR_HIT);
+    p->shoot();
+}
+
+TEST_F(OpeningBookStrategyTest, fallback_for_unknown_layout)
+{
+    auto fallback = make_unique<MockShootStrategy>();
+    EXPECT_CALL(*fallback, chooseShipProxy(_)).WillOnce(Return(1));
+    EXPECT_CALL(*fallback, chooseSquareProxy(_)).WillOnce(Return(std::make_pair(0, 0)));
+    // another seed gives another layout
+    AIPlayer p(make_unique<OpeningBookStrategy>(book, std::move(fallback)), Random(4));
+    p.setUpShips();
+    ASSERT_NE(p.getPrimaryGird().getShip(1).getOccupiedMask(), FleetLayouts::instance().getPlacements(1)[layout[0]].mask);
+    p.shoot();
+}
@@ -0,0 +1,151 @@
+#include "OpeningBook.h"
+#include "DensityStrategy.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace battleship;
+using std::string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    // book is generated once for all tests
+    const vector<OpeningBook::Entry>& entries()
+    {
+        static const auto e = OpeningBook::generate();
+        return e;
+    }
+
+    std::uint64_t layoutsOf(const OpeningBook::Entry& e, const DensityStrategy::Density& density)
+    {
+        std::uint64_t n = 0;
+        for (auto q : e.squares)
+            if (q != OpeningBook::NO_SQUARE)
+                n += density.counts[q];
+        return n;
+    }
+}
+
+
+TEST(OpeningBookTest, dummy)
+{
+    (void)OpeningBook::Entry();
+}
+
+TEST(OpeningBookTest, generate)
+{
+    const auto& layouts = FleetLayouts::instance();
+    const auto& e = entries();
+    ASSERT_EQ(e.size(), layouts.size());
+
+    for (std::size_t i = 0; i < e.size(); i += 97)
+    {
+        EXPECT_EQ(e[i].layout, FleetLayouts::pack(layouts.at(i)));
+        if (i > 0)
+        {
+            EXPECT_LT(e[i - 1].layout, e[i].layout);
+        }
+
+        // planned squares are different squares in range of the chosen ship
+        const auto layout = layouts.at(i);
+        ASSERT_GE(e[i].ship, 1);
+        ASSERT_LE(e[i].ship, int(Ship::MAX_LENGTH));
+        const auto& p = layouts.getPlacements(e[i].ship)[layout[e[i].ship - 1]];
+        Bitboard planned;
+        for (int k = 0; k < Ship::MAX_SHOTS[e[i].ship]; k++)
+        {
+            ASSERT_NE(e[i].squares[k], OpeningBook::NO_SQUARE);
+            EXPECT_TRUE(p.range.test(e[i].squares[k]));
+            EXPECT_FALSE(planned.test(e[i].squares[k]));
+            planned.set(e[i].squares[k]);
+        }
+        for (int k = Ship::MAX_SHOTS[e[i].ship]; k < OpeningBook::TURN_SHOTS; k++)
+            EXPECT_EQ(e[i].squares[k], OpeningBook::NO_SQUARE);
+    }
+}
+
+TEST(OpeningBookTest, best_turn)
+{
+    // no ship of the layout can expect more hits than the chosen one
+    const auto& layouts = FleetLayouts::instance();
+    const auto density = DensityStrategy::countLayouts(Grid());
+    const auto& e = entries();
+    for (std::size_t i = 0; i < e.size(); i += 4999)
+    {
+        const auto layout = layouts.at(i);
+        const auto best = layoutsOf(e[i], density);
+        for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+        {
+            const auto range = layouts.getPlacements(l)[layout[l - 1]].range;
+            vector<std::uint32_t> counts;
+            for (auto b = range; !b.empty(); )
+                counts.push_back(density.counts[b.popLowest()]);
+            std::sort(counts.rbegin(), counts.rend());
+            std::uint64_t n = 0;
+            for (int k = 0; k < Ship::MAX_SHOTS[l] && k < (int)counts.size(); k++)
+                n += counts[k];
+            EXPECT_LE(n, best);
+        }
+    }
+}
+
+TEST(OpeningBookTest, write_and_map)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    OpeningBook::write(path, entries());
+    {
+        MappedOpeningBook book(path);
+        EXPECT_EQ(book.size(), entries().size());
+        const auto& layouts = FleetLayouts::instance();
+        for (std::size_t i = 0; i < layouts.size(); i += 1013)
+        {
+            const auto* e = book.find(layouts.at(i));
+            ASSERT_NE(e, nullptr);
+            EXPECT_EQ(e->layout, entries()[i].layout);
+            EXPECT_EQ(e->ship, entries()[i].ship);
+            EXPECT_EQ(e->squares[0], entries()[i].squares[0]);
+            EXPECT_EQ(e->squares[1], entries()[i].squares[1]);
+        }
+        // ships touching each other
+        EXPECT_EQ(book.find({{ 0, 0, 0 }}), nullptr);
+    }
+    fs::remove(path);
+}
+
+TEST(OpeningBookTest, bad_files)
+{
+    EXPECT_THROW(MappedOpeningBook("/nonexistent/dir/book"), BattleshipRuntimeError);
+    EXPECT_THROW(OpeningBook::write("/nonexistent/dir/book", entries()), BattleshipRuntimeError);
+
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    {
+        std::ofstream f(path, std::ios_base::binary);
+        f << "not a book, just some text";
+    }
+    EXPECT_THROW(MappedOpeningBook{path}, BattleshipRuntimeError);
+
+    // header promises more entries than the file has
+    vector<OpeningBook::Entry> some(entries().begin(), entries().begin() + 10);
+    OpeningBook::write(path, some);
+    fs::resize_file(path, fs::file_size(path) - sizeof(OpeningBook::Entry));
+    EXPECT_THROW(MappedOpeningBook{path}, BattleshipRuntimeError);
+
+    // size of the entries in bytes wraps around to the size of the file
+    OpeningBook::write(path, some);
+    {
+        std::fstream f(path, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+        OpeningBook::Header h;
+        f.read(reinterpret_cast<char*>(&h), sizeof(h));
+        h.entries += (std::uint64_t(1) << 63) / (sizeof(OpeningBook::Entry) / 2);
+        f.seekp(0);
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    }
+    EXPECT_THROW(MappedOpeningBook{path}, BattleshipRuntimeError);
+    fs::remove(path);
+}
@@ -0,0 +1,117 @@
+#include "PlacementDistribution.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace battleship;
+using std::string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    // layouts 0, 1 and 2 have weights 1, 2 and 5, the rest none
+    vector<double> fewLayouts()
+    {
+        vector<double> w(FleetLayouts::instance().size(), 0.0);
+        w[0] = 1;
+        w[1] = 2;
+        w[2] = 5;
+        return w;
+    }
+}
+
+
+TEST(PlacementDistributionTest, logic_errors)
+{
+    const auto n = FleetLayouts::instance().size();
+    EXPECT_THROW(PlacementDistribution(vector<double>(10, 1.0)), BattleshipLogicError);
+    EXPECT_THROW(PlacementDistribution(vector<double>(n, 0.0)), BattleshipLogicError);
+    auto w = fewLayouts();
+    w[7] = -1;
+    EXPECT_THROW(PlacementDistribution{w}, BattleshipLogicError);
+}
+
+TEST(PlacementDistributionTest, probability)
+{
+    const PlacementDistribution d(fewLayouts());
+    EXPECT_EQ(d.size(), FleetLayouts::instance().size());
+    EXPECT_NEAR(d.probability(0), 0.125, 1e-6);
+    EXPECT_NEAR(d.probability(1), 0.25, 1e-6);
+    EXPECT_NEAR(d.probability(2), 0.625, 1e-6);
+    EXPECT_EQ(d.probability(3), 0);
+}
+
+TEST(PlacementDistributionTest, sample)
+{
+    const auto& layouts = FleetLayouts::instance();
+    const PlacementDistribution d(fewLayouts());
+    Random rng(3);
+    const int n = 80000;
+    int counts[3] = { 0, 0, 0 };
+    for (int i = 0; i < n; i++)
+    {
+        const long index = layouts.indexOf(d.sample(rng));
+        ASSERT_GE(index, 0);
+        ASSERT_LT(index, 3) << "layouts without weight are never sampled";
+        counts[index]++;
+    }
+    EXPECT_NEAR(counts[0] / double(n), 0.125, 0.01);
+    EXPECT_NEAR(counts[1] / double(n), 0.25, 0.01);
+    EXPECT_NEAR(counts[2] / double(n), 0.625, 0.01);
+}
+
+TEST(PlacementDistributionTest, uniform)
+{
+    // every layout is its own column of the alias table
+    const auto& layouts = FleetLayouts::instance();
+    const PlacementDistribution d(vector<double>(layouts.size(), 1.0));
+    Random a(9), b(9);
+    for (int i = 0; i < 100; i++)
+    {
+        const auto column = b.below(layouts.size());
+        b();
+        EXPECT_EQ(d.sample(a), layouts.at(column));
+    }
+}
+
+TEST(PlacementDistributionTest, write_and_load)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    PlacementDistribution::write(path, fewLayouts());
+    const auto d = PlacementDistribution::load(path);
+    EXPECT_NEAR(d.probability(2), 0.625, 1e-6);
+    EXPECT_EQ(d.probability(5), 0);
+    fs::remove(path);
+}
+
+TEST(PlacementDistributionTest, bad_files)
+{
+    EXPECT_THROW(PlacementDistribution::load("/nonexistent/dir/placement"), BattleshipRuntimeError);
+    EXPECT_THROW(PlacementDistribution::write("/nonexistent/dir/placement", fewLayouts()), BattleshipRuntimeError);
+
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    {
+        std::ofstream f(path, std::ios_base::binary);
+        f << "not a placement, just some text";
+    }
+    EXPECT_THROW(PlacementDistribution::load(path), BattleshipRuntimeError);
+
+    // weights of a different table
+    PlacementDistribution::write(path, vector<double>(10, 1.0));
+    EXPECT_THROW(PlacementDistribution::load(path), BattleshipRuntimeError);
+
+    // the last weight is missing
+    PlacementDistribution::write(path, fewLayouts());
+    fs::resize_file(path, fs::file_size(path) - sizeof(float));
+    EXPECT_THROW(PlacementDistribution::load(path), BattleshipRuntimeError);
+
+    // all weights are zero
+    PlacementDistribution::write(path, vector<double>(FleetLayouts::instance().size(), 0.0));
+    EXPECT_THROW(PlacementDistribution::load(path), BattleshipRuntimeError);
+    fs::remove(path);
+}
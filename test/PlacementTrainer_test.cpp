@@ -0,0 +1,69 @@
+#include "PlacementTrainer.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+#include <cmath>
+
+using namespace battleship;
+using std::vector;
+
+namespace
+{
+    void trainer(vector<const char*> args)
+    {
+        args.insert(args.begin(), "battleship_placement_trainer");
+        PlacementTrainer t(args.size(), const_cast<char**>(args.data()));
+    }
+}
+
+
+TEST(PlacementTrainerTest, arguments_errors)
+{
+    EXPECT_THROW(trainer({ }), ArgumentsError) << "output file is required";
+    EXPECT_THROW(trainer({ "out", "-o", "density" }), ArgumentsError) << "strategy without batched decisions";
+    EXPECT_THROW(trainer({ "out", "-p", "nobody" }), ArgumentsError);
+    EXPECT_THROW(trainer({ "out", "-g", "0" }), ArgumentsError);
+    EXPECT_THROW(trainer({ "out", "-r", "21" }), ArgumentsError);
+    EXPECT_THROW(trainer({ "out", "--temperature", "0" }), ArgumentsError);
+    EXPECT_NO_THROW(trainer({ "out", "-o", "random", "-g", "2" }));
+}
+
+TEST(PlacementTrainerTest, evaluate)
+{
+    const LockstepSimulation simulation(20, &GreedyStrategy::chooseShots, &GreedyStrategy::chooseShots);
+    const auto stats = PlacementTrainer::evaluate(simulation, 5, 4, 1000, 1030);
+    ASSERT_EQ(stats.size(), 30u);
+    for (auto& s : stats)
+    {
+        EXPECT_GE(s.survival, 0);
+        EXPECT_LE(s.survival, 1);
+        EXPECT_GE(s.conceded, 0);
+        EXPECT_LE(s.conceded, 6) << "the fleet has six squares";
+    }
+
+    // every part of the range is played with the same games
+    const auto part = PlacementTrainer::evaluate(simulation, 5, 4, 1010, 1020);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(part[i].survival, stats[10 + i].survival);
+        EXPECT_EQ(part[i].conceded, stats[10 + i].conceded);
+    }
+}
+
+TEST(PlacementTrainerTest, weights)
+{
+    vector<PlacementTrainer::LayoutStats> stats(3);
+    stats[0].conceded = 2;
+    stats[1].conceded = 1;
+    stats[2].conceded = 3;
+    const auto w = PlacementTrainer::weights(stats, 0.5);
+    ASSERT_EQ(w.size(), 3u);
+    EXPECT_DOUBLE_EQ(w[1], 1.0);
+    EXPECT_GT(w[1], w[0]);
+    EXPECT_GT(w[0], w[2]);
+    EXPECT_NEAR(w[0] / w[1], std::exp(-2.0), 1e-12);
+    EXPECT_TRUE(PlacementTrainer::weights({}, 1.0).empty());
+}
@@ -168,6 +168,33 @@ TEST_F(PlayerTest, secondary_grid)
     EXPECT_FALSE(p.canShoot()) << "no available range any more";
 }
 
+TEST_F(PlayerTest, untargeted_mask)
+{
+    auto& sg = p.getSecondaryGrid();
+    auto expect_ranges = [&]()
+    {
+        for (auto& s : p.getPrimaryGird().getAllShips())
+            EXPECT_EQ(p.getUntargetedMask(s), sg.getAvailableMask(s));
+    };
+
+    expect_ranges();
+
+    // cached ranges should follow every update, also the ones out of ships ranges
+    p.update({2,3}, SR_MISS);
+    expect_ranges();
+    p.update({5,4}, SR_HIT);
+    expect_ranges();
+    p.update({9,0}, SR_MISS);
+    expect_ranges();
+
+    // failed update does not change anything
+    EXPECT_THROW(p.update({2,3}, SR_HIT), BattleshipRuntimeError);
+    expect_ranges();
+
+    p.update({5,5}, SR_SUNK);
+    expect_ranges();
+}
+
 TEST_F(PlayerTest, set_up_errors)
 {
     MockPlayer mp;
@@ -3,10 +3,33 @@
 #include "gtest/gtest.h"
 #include <memory>
 
-using battleship::RandomStrategy;
+using namespace battleship;
 
 TEST(RandomStrategyTest, dummy)
 {
     (void)RandomStrategy();
 }
 
+TEST(RandomStrategyTest, choose_from_passed_values)
+{
+    RandomStrategy r;
+
+    ShipsLengths l;
+    l.push_back(1);
+    l.push_back(3);
+    for (int i = 0; i < 20; i++)
+    {
+        auto x = r.chooseShip(l);
+        EXPECT_TRUE(x == 1 || x == 3) << "chosen ship not from the passed list";
+    }
+
+    SquareSet s;
+    s.insert({0,0});
+    s.insert({5,7});
+    s.insert({9,2});
+    for (int i = 0; i < 20; i++)
+        EXPECT_TRUE(s.contains(r.chooseSquare(s))) << "chosen square not from the passed set";
+
+    EXPECT_THROW(r.chooseShip(ShipsLengths()), BattleshipRuntimeError);
+    EXPECT_THROW(r.chooseSquare(SquareSet()), BattleshipRuntimeError);
+}
@@ -0,0 +1,72 @@
+#include "Random.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+using namespace battleship;
+using std::vector;
+
+
+TEST(RandomTest, dummy)
+{
+    (void)Random();
+}
+
+TEST(RandomTest, same_seed_same_sequence)
+{
+    Random a(42);
+    Random b(42);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(a(), b());
+
+    Random c(43);
+    Random d(42);
+    int equal = 0;
+    for (int i = 0; i < 100; i++)
+        equal += c() == d();
+    EXPECT_LT(equal, 5) << "different seeds should give different sequences";
+}
+
+TEST(RandomTest, streams)
+{
+    Random a(7, 0);
+    Random b(7, 1);
+    int equal = 0;
+    for (int i = 0; i < 100; i++)
+        equal += a() == b();
+    EXPECT_LT(equal, 5) << "different streams should give different sequences";
+
+    // stream n is the base generator jumped n times
+    Random c(7, 0);
+    c.jump();
+    Random d(7, 1);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(c(), d());
+}
+
+TEST(RandomTest, below)
+{
+    Random r(1);
+    vector<int> counts(10, 0);
+    for (int i = 0; i < 10000; i++)
+    {
+        auto x = r.below(10);
+        ASSERT_LT(x, 10u);
+        counts[x]++;
+    }
+    for (auto c : counts)
+    {
+        EXPECT_GT(c, 800) << "values should be spread uniformly";
+        EXPECT_LT(c, 1200) << "values should be spread uniformly";
+    }
+
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(r.below(1), 0u);
+}
+
+TEST(RandomTest, derive_seed)
+{
+    EXPECT_EQ(Random::deriveSeed(5, 3), Random::deriveSeed(5, 3));
+    EXPECT_NE(Random::deriveSeed(5, 3), Random::deriveSeed(5, 4));
+    EXPECT_NE(Random::deriveSeed(5, 3), Random::deriveSeed(6, 3));
+}
@@ -342,3 +342,71 @@ TEST(ShipsGridTest, incorrect_take_shot)
 
 
 
+
+TEST(ShipsGridTest, try_place)
+{
+    ShipsGrid g;
+
+    EXPECT_EQ(g.tryPlace({{ {0,0} }}, 0), PS_WRONG_LENGTH);
+    EXPECT_EQ(g.tryPlace({{ {0,0} }}, 4), PS_WRONG_LENGTH);
+    EXPECT_EQ(g.tryPlace({{ {-1,0} }}, 1), PS_OUT_OF_RANGE);
+    EXPECT_EQ(g.tryPlace({{ {9,8}, {9,9}, {9,10} }}, 3), PS_OUT_OF_RANGE);
+    EXPECT_EQ(g.tryPlace({{ {3,3}, {4,4} }}, 2), PS_WRONG_SHAPE);
+    EXPECT_EQ(g.tryPlace({{ {3,3}, {3,5}, {3,4} }}, 3), PS_OK) << "squares do not have to be sorted";
+    EXPECT_EQ(g.at({3,4}), ST_TRIPLE);
+    EXPECT_EQ(g.getShip(3).getOccupiedSquares()->front(), make_pair(3,3));
+
+    // failed attempts do not change the grid
+    EXPECT_EQ(g.checkPlacement({{ {4,6} }}, 1), PS_TOO_CLOSE);
+    EXPECT_EQ(g.tryPlace({{ {4,6} }}, 1), PS_TOO_CLOSE);
+    EXPECT_EQ(g.tryPlace({{ {2,2}, {2,2} }}, 2), PS_WRONG_SHAPE);
+    EXPECT_EQ(g.getShip(1).getLength(), 0);
+    EXPECT_EQ(g.getPlane(ST_EMPTY).count(), 97);
+
+    EXPECT_EQ(g.checkPlacement({{ {5,6} }}, 1), PS_OK);
+    EXPECT_EQ(g.at({5,6}), ST_EMPTY) << "checkPlacement cannot place the ship";
+    EXPECT_EQ(g.tryPlace({{ {5,6} }}, 1), PS_OK);
+    EXPECT_EQ(g.at({5,6}), ST_SINGLE);
+
+    // ship with the same length can be moved next to its previous location
+    EXPECT_EQ(g.tryPlace({{ {3,2}, {3,3}, {3,4} }}, 3), PS_OK);
+    EXPECT_EQ(g.at({3,5}), ST_EMPTY);
+    EXPECT_EQ(g.at({3,2}), ST_TRIPLE);
+}
+
+TEST(ShipsGridTest, restore)
+{
+    Fleet fleet = {{ Bitboard::fromSquare({2,2}),
+                     Bitboard::rectangle(6, 3, 6, 4),
+                     Bitboard::rectangle(3, 8, 5, 8) }};
+    vector<pair<int,int>> shots = { {0,0}, {2,2}, {6,4}, {3,8}, {4,8}, {5,8}, {9,9} };
+
+    // restored grid should be the same as the one which took all shots one by one
+    ShipsGrid played;
+    played.setShipLocation(Ship::makeVectorPtr({ {2,2} }));
+    played.setShipLocation(Ship::makeVectorPtr({ {6,3}, {6,4} }));
+    played.setShipLocation(Ship::makeVectorPtr({ {3,8}, {4,8}, {5,8} }));
+    Bitboard shots_mask;
+    for (auto p : shots)
+    {
+        played.takeShot(p);
+        shots_mask.set(p);
+    }
+
+    ShipsGrid restored;
+    restored.restore(fleet, shots_mask);
+    for (int a = 0; a < 10; ++a)
+        for (int b = 0; b < 10; ++b)
+            EXPECT_EQ(restored.at({a,b}), played.at({a,b}));
+    for (int l = 1; l <= 3; ++l)
+    {
+        EXPECT_EQ(restored.getShip(l).getHits(), played.getShip(l).getHits());
+        EXPECT_EQ(restored.getShip(l).isSunk(), played.getShip(l).isSunk());
+    }
+
+    EXPECT_THROW(restored.restore(fleet, shots_mask), BattleshipLogicError) << "ships are already placed";
+
+    ShipsGrid g;
+    fleet[1] = Bitboard::rectangle(6, 3, 6, 5);
+    EXPECT_THROW(g.restore(fleet, Bitboard()), BattleshipRuntimeError) << "wrong ship length";
+}
@@ -0,0 +1,113 @@
+#include "ShotBatch.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+
+#include "gtest/gtest.h"
+
+using namespace battleship;
+
+namespace
+{
+    // games with random ships and untargeted squares, some of them skipped and some with a single square
+    ShotBatch randomBatch(std::size_t games, Random& rng)
+    {
+        ShotBatch batch(games);
+        for (std::size_t g = 0; g < games; g++)
+        {
+            batch.ships[g] = rng.below(8);
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+            {
+                Bitboard untargeted(rng(), rng() & Bitboard::full().high());
+                if (rng.below(4) == 0)
+                    untargeted = Bitboard::fromIndex(rng.below(Bitboard::SQUARES));
+                batch.untargeted_low[l - 1][g] = untargeted.low();
+                batch.untargeted_high[l - 1][g] = untargeted.high();
+            }
+            batch.setRandom(g, Random(rng()));
+        }
+        return batch;
+    }
+
+    // the batched decision of every game has to be the same as the strategy's one with the same generator
+    template<typename Strategy>
+    void expectSameAsStrategy(BatchIsa isa)
+    {
+        Random rng(7);
+        auto batch = randomBatch(1003, rng);
+        const auto before = batch;
+        Strategy::chooseShots(batch, isa);
+
+        for (std::size_t g = 0; g < batch.size(); g++)
+        {
+            if (before.ships[g] == 0)
+            {
+                EXPECT_EQ(0, batch.ship_length[g]);
+                EXPECT_EQ(0, batch.square[g]);
+                EXPECT_EQ(before.getRandom(g).getState(), batch.getRandom(g).getState()) << "skipped game draws nothing.";
+                continue;
+            }
+
+            Strategy strategy(before.getRandom(g));
+            ShipsLengths lengths;
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                if (before.ships[g] & (1 << (l - 1)))
+                    lengths.push_back(l);
+            const int length = strategy.chooseShip(lengths);
+            const Bitboard untargeted(before.untargeted_low[length - 1][g], before.untargeted_high[length - 1][g]);
+            const auto square = strategy.chooseSquare(SquareSet(untargeted));
+
+            ASSERT_EQ(length, batch.ship_length[g]) << "game " << g;
+            ASSERT_EQ(Bitboard::toIndex(square), batch.square[g]) << "game " << g;
+
+            // the generators have to stay in step for the next decisions
+            Strategy next(batch.getRandom(g));
+            EXPECT_EQ(strategy.chooseSquare(SquareSet(untargeted)), next.chooseSquare(SquareSet(untargeted)));
+        }
+    }
+}
+
+
+TEST(ShotBatchTest, resize)
+{
+    ShotBatch batch;
+    EXPECT_EQ(0u, batch.size());
+    batch.resize(10);
+    EXPECT_EQ(10u, batch.size());
+    EXPECT_EQ(10u, batch.untargeted_high[Ship::MAX_LENGTH - 1].size());
+    EXPECT_EQ(10u, batch.rng[3].size());
+    EXPECT_EQ(10u, batch.square.size());
+}
+
+TEST(ShotBatchTest, random_state)
+{
+    ShotBatch batch(3);
+    Random r(5, 2);
+    batch.setRandom(1, r);
+    auto copy = batch.getRandom(1);
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(r(), copy());
+}
+
+TEST(ShotBatchTest, scalar_same_as_strategies)
+{
+    expectSameAsStrategy<RandomStrategy>(BI_SCALAR);
+    expectSameAsStrategy<GreedyStrategy>(BI_SCALAR);
+}
+
+TEST(ShotBatchTest, avx2_same_as_strategies)
+{
+    if (!ShotBatch::hasAvx2())
+    {
+        ShotBatch batch(1);
+        EXPECT_THROW(batch.chooseRandomShots(BSC_RANDOM, BI_AVX2), BattleshipRuntimeError);
+        return;
+    }
+    expectSameAsStrategy<RandomStrategy>(BI_AVX2);
+    expectSameAsStrategy<GreedyStrategy>(BI_AVX2);
+}
+
+TEST(ShotBatchTest, auto_same_as_strategies)
+{
+    expectSameAsStrategy<RandomStrategy>(BI_AUTO);
+    expectSameAsStrategy<GreedyStrategy>(BI_AUTO);
+}
@@ -0,0 +1,187 @@
+#include "ShotExport.h"
+#include "Simulation.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace battleship;
+using std::make_unique;
+using std::string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+namespace
+{
+    // games [begin, end) exported by the buffer, returns the number of shots
+    long playGames(ShotExportBuffer& buffer, int begin, int end)
+    {
+        const Simulation simulation(20);
+        long shots = 0;
+        for (int g = begin; g < end; g++)
+        {
+            AIPlayer main(make_unique<GreedyStrategy>(Random(g, 1)), Random(g, 0));
+            AIPlayer opponent(make_unique<RandomStrategy>(Random(g, 3)), Random(g, 2));
+            main.setUpShips();
+            opponent.setUpShips();
+            buffer.setGame(g);
+            simulation.playStaticGame(main, opponent, buffer);
+            for (const Player* p : { &main, &opponent })
+                shots += (~p->getSecondaryGrid().getPlane(ST_EMPTY)).count();
+        }
+        return shots;
+    }
+
+    ShotColumns readAll(const string& path)
+    {
+        ShotExportReader reader(path);
+        ShotColumns all, block;
+        while (reader.next(block))
+            for (size_t i = 0; i < block.size(); i++)
+            {
+                all.game.push_back(block.game[i]);
+                all.round.push_back(block.round[i]);
+                all.player.push_back(block.player[i]);
+                all.ship.push_back(block.ship[i]);
+                all.square.push_back(block.square[i]);
+                all.result.push_back(block.result[i]);
+                all.range.push_back(block.range[i]);
+            }
+        return all;
+    }
+}
+
+
+TEST(ShotExportTest, simulated_games)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    long shots = 0;
+    {
+        ShotExportWriter writer(path, 42);
+        ShotExportBuffer buffer(writer);
+        shots = playGames(buffer, 0, 20);
+        buffer.flush();
+        writer.flush();
+    }
+
+    EXPECT_EQ(ShotExportReader(path).header().seed, 42u);
+    const auto c = readAll(path);
+    ASSERT_EQ((long)c.size(), shots);
+    for (size_t i = 0; i < c.size(); i++)
+    {
+        EXPECT_LT(c.game[i], 20u);
+        EXPECT_GE(c.round[i], 1);
+        EXPECT_LE(c.round[i], 20);
+        EXPECT_LE(c.player[i], 1);
+        EXPECT_GE(c.ship[i], 1);
+        EXPECT_LE(c.ship[i], int(Ship::MAX_LENGTH));
+        EXPECT_LT(c.square[i], int(Bitboard::SQUARES));
+        EXPECT_LE(c.result[i], SR_MISS);
+        if (i > 0 && c.game[i] == c.game[i - 1] && c.player[i] == c.player[i - 1] && c.round[i] == c.round[i - 1])
+        {
+            // the second shot of the turn is fired by the same ship and its range shrinks
+            EXPECT_EQ(c.ship[i], c.ship[i - 1]);
+            EXPECT_LT(c.range[i], c.range[i - 1]);
+        }
+    }
+
+    std::ostringstream csv;
+    ShotExport::writeCsv(path, csv);
+    std::istringstream lines(csv.str());
+    string line;
+    std::getline(lines, line);
+    EXPECT_EQ(line, "game,round,player,ship,square,result,range");
+    long rows = 0;
+    while (std::getline(lines, line))
+        rows++;
+    EXPECT_EQ(rows, shots);
+
+    fs::remove(path);
+}
+
+TEST(ShotExportTest, buffers_of_threads)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    long shots[2] = { 0, 0 };
+    {
+        ShotExportWriter writer(path, 0);
+        vector<std::thread> threads;
+        for (int t = 0; t < 2; t++)
+            threads.emplace_back([&writer, &shots, t]
+            {
+                ShotExportBuffer buffer(writer);
+                shots[t] = playGames(buffer, t * 100, t * 100 + 30);
+            });
+        for (auto& t : threads)
+            t.join();
+    }
+
+    // every block comes from a single buffer
+    ShotExportReader reader(path);
+    ShotColumns block;
+    long rows = 0;
+    while (reader.next(block))
+    {
+        ASSERT_GT(block.size(), 0u);
+        for (size_t i = 0; i < block.size(); i++)
+            EXPECT_EQ(block.game[i] / 100, block.game[0] / 100);
+        rows += block.size();
+    }
+    EXPECT_EQ(rows, shots[0] + shots[1]);
+
+    fs::remove(path);
+}
+
+TEST(ShotExportTest, ship_of_the_shot)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    {
+        ShotExportWriter writer(path, 0);
+        ShotExportBuffer buffer(writer);
+        AIPlayer p(make_unique<RandomStrategy>(Random(1)), Random(0));
+        p.setUpShips();
+        buffer.shot(0, 1, p, 2, { 3, 4 }, SR_MISS);
+        EXPECT_THROW(buffer.shot(0, 1, p, 0, { 3, 4 }, SR_MISS), BattleshipLogicError);
+        EXPECT_THROW(buffer.shot(0, 1, p, Ship::MAX_LENGTH + 1, { 3, 4 }, SR_MISS), BattleshipLogicError);
+    }
+
+    const auto c = readAll(path);
+    ASSERT_EQ(c.size(), 1u);
+    EXPECT_EQ(c.ship[0], 2);
+    EXPECT_EQ(c.square[0], Bitboard::toIndex({ 3, 4 }));
+    fs::remove(path);
+}
+
+TEST(ShotExportTest, broken_file)
+{
+    const string path = (fs::temp_directory_path() / fs::unique_path()).string();
+    {
+        ShotExportWriter writer(path, 0);
+        ShotExportBuffer buffer(writer);
+        playGames(buffer, 0, 2);
+    }
+    fs::resize_file(path, fs::file_size(path) - 1);
+    {
+        ShotExportReader reader(path);
+        ShotColumns block;
+        EXPECT_THROW(reader.next(block), BattleshipRuntimeError);
+    }
+
+    {
+        std::ofstream f(path, std::ios_base::trunc);
+        f << "game,round\n";
+    }
+    EXPECT_THROW(ShotExportReader reader(path), BattleshipRuntimeError);
+
+    fs::remove(path);
+    EXPECT_THROW(ShotExportReader reader(path), BattleshipRuntimeError);
+}
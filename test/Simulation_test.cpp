@@ -0,0 +1,93 @@
+#include "Simulation.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+
+using namespace battleship;
+using std::make_unique;
+
+
+TEST(SimulationTest, dummy)
+{
+    (void)Simulation(20);
+}
+
+TEST(SimulationTest, stats)
+{
+    SimulationStats s;
+    s.add({ GO_WIN, 10 });
+    s.add({ GO_LOSS, 4 });
+    s.add({ GO_DRAW, 20 });
+    s.add({ GO_WIN, 6 });
+
+    EXPECT_EQ(s.wins, 2);
+    EXPECT_EQ(s.draws, 1);
+    EXPECT_EQ(s.losses, 1);
+    EXPECT_EQ(s.games(), 4);
+    EXPECT_DOUBLE_EQ(s.averageRounds(), 10.0);
+
+    SimulationStats t;
+    t.add({ GO_LOSS, 10 });
+    t.merge(s);
+    EXPECT_EQ(t.losses, 2);
+    EXPECT_EQ(t.games(), 5);
+    EXPECT_DOUBLE_EQ(t.averageRounds(), 10.0);
+}
+
+TEST(SimulationTest, play_games)
+{
+    for (int max_rounds : { 1, 5, 20 })
+    {
+        Simulation sim(max_rounds);
+        for (int i = 0; i < 50; i++)
+        {
+            AIPlayer main(make_unique<GreedyStrategy>());
+            AIPlayer opponent(make_unique<RandomStrategy>());
+            main.setUpShips();
+            opponent.setUpShips();
+
+            auto r = sim.playGame(main, opponent);
+            EXPECT_GE(r.rounds, 1);
+            EXPECT_LE(r.rounds, max_rounds) << "game cannot last longer than max rounds";
+
+            // game finished before the round limit only when one side cannot shoot any more
+            if (r.rounds < max_rounds && r.outcome == GO_WIN)
+            {
+                EXPECT_FALSE(opponent.mayShootNextRounds());
+            }
+            if (r.rounds < max_rounds && r.outcome == GO_LOSS)
+            {
+                EXPECT_FALSE(main.mayShootNextRounds());
+            }
+            if (r.outcome == GO_DRAW)
+            {
+                EXPECT_EQ(main.getHits(), opponent.getHits());
+            }
+        }
+    }
+}
+
+TEST(SimulationTest, seeded_games_are_reproducible)
+{
+    Simulation sim(20);
+    for (std::uint64_t seed = 0; seed < 20; seed++)
+    {
+        GameResult r[2];
+        int hits[2];
+        for (int i = 0; i < 2; i++)
+        {
+            AIPlayer main(make_unique<GreedyStrategy>(Random(seed, 1)), Random(seed, 0));
+            AIPlayer opponent(make_unique<RandomStrategy>(Random(seed, 3)), Random(seed, 2));
+            main.setUpShips();
+            opponent.setUpShips();
+            r[i] = sim.playGame(main, opponent);
+            hits[i] = main.getHits() * 10 + opponent.getHits();
+        }
+        EXPECT_EQ(r[0].outcome, r[1].outcome);
+        EXPECT_EQ(r[0].rounds, r[1].rounds);
+        EXPECT_EQ(hits[0], hits[1]);
+    }
+}
@@ -0,0 +1,114 @@
+#include "Sprt.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <cmath>
+
+using namespace battleship;
+
+
+TEST(SprtTest, logic_errors)
+{
+    EXPECT_THROW(Sprt(5, 5, 0.05, 0.05), BattleshipLogicError);
+    EXPECT_THROW(Sprt(5, 0, 0.05, 0.05), BattleshipLogicError);
+    EXPECT_THROW(Sprt(0, 5, 0, 0.05), BattleshipLogicError);
+    EXPECT_THROW(Sprt(0, 5, 0.05, 1), BattleshipLogicError);
+}
+
+TEST(SprtTest, elo_and_score)
+{
+    EXPECT_DOUBLE_EQ(Sprt::eloToScore(0), 0.5);
+    EXPECT_NEAR(Sprt::eloToScore(400), 10.0 / 11, 1e-12);
+    EXPECT_NEAR(Sprt::scoreToElo(Sprt::eloToScore(-123)), -123, 1e-9);
+    EXPECT_GT(Sprt::scoreToElo(1), 0);
+    EXPECT_LT(Sprt::scoreToElo(0), 0);
+}
+
+TEST(SprtTest, pentanomial)
+{
+    Sprt s(0, 5, 0.05, 0.05);
+    EXPECT_EQ(s.pairs(), 0);
+    EXPECT_DOUBLE_EQ(s.score(), 0.5);
+    EXPECT_EQ(s.decision(), SD_CONTINUE);
+
+    s.addPair(GO_WIN, GO_WIN);
+    s.addPair(GO_WIN, GO_LOSS);
+    s.addPair(GO_DRAW, GO_LOSS);
+    s.addPair(GO_DRAW, GO_WIN);
+    const std::array<long, 5> expected = {{ 0, 1, 1, 1, 1 }};
+    EXPECT_EQ(s.getPentanomial(), expected);
+    EXPECT_EQ(s.pairs(), 4);
+    EXPECT_DOUBLE_EQ(s.score(), (1 + 0.5 + 0.25 + 0.75) / 4);
+
+    Sprt other(0, 5, 0.05, 0.05);
+    other.addPair(GO_LOSS, GO_LOSS);
+    s.merge(other);
+    EXPECT_EQ(s.pairs(), 5);
+    EXPECT_EQ(s.getPentanomial()[0], 1);
+}
+
+TEST(SprtTest, interval)
+{
+    Sprt s(0, 5, 0.05, 0.05);
+    for (int i = 0; i < 300; i++)
+        s.addPair(i % 3 == 0 ? GO_WIN : GO_DRAW, i % 5 == 0 ? GO_LOSS : GO_DRAW);
+    const auto interval = s.eloInterval();
+    EXPECT_LT(interval.first, s.elo());
+    EXPECT_GT(interval.second, s.elo());
+
+    // four times more pairs with the same results halve the interval
+    Sprt more = s;
+    for (int i = 0; i < 3; i++)
+        more.merge(s);
+    const auto narrow = more.eloInterval();
+    EXPECT_NEAR(narrow.second - narrow.first, (interval.second - interval.first) / 2, 0.5);
+}
+
+TEST(SprtTest, decisions)
+{
+    // the log-likelihood ratio is zero half way between the hypotheses
+    Sprt bounds(0, 5, 0.05, 0.05);
+    EXPECT_NEAR(bounds.lowerBound(), std::log(0.05 / 0.95), 1e-12);
+    EXPECT_NEAR(bounds.upperBound(), std::log(0.95 / 0.05), 1e-12);
+
+    // clearly stronger strategy
+    Sprt better(0, 5, 0.05, 0.05);
+    long pairs = 0;
+    while (better.decision() == SD_CONTINUE)
+    {
+        better.addPair(pairs % 4 == 0 ? GO_DRAW : GO_WIN, pairs % 3 == 0 ? GO_LOSS : GO_DRAW);
+        pairs++;
+        ASSERT_LT(pairs, 100000);
+    }
+    EXPECT_EQ(better.decision(), SD_ACCEPT_H1);
+    EXPECT_GT(better.llr(), 0);
+
+    // equal strategies
+    Sprt equal(0, 5, 0.05, 0.05);
+    pairs = 0;
+    while (equal.decision() == SD_CONTINUE)
+    {
+        const GameOutcome outcomes[] = { GO_WIN, GO_DRAW, GO_LOSS };
+        equal.addPair(outcomes[pairs % 3], outcomes[(pairs / 3) % 3]);
+        pairs++;
+        ASSERT_LT(pairs, 1000000);
+    }
+    EXPECT_EQ(equal.decision(), SD_ACCEPT_H0);
+    EXPECT_NEAR(equal.elo(), 0, 1);
+}
+
+TEST(SprtTest, equal_pairs)
+{
+    // mirrored games of the same strategy give every pair score 1/2
+    Sprt s(0, 5, 0.05, 0.05);
+    for (int i = 0; i < 1000 && s.decision() == SD_CONTINUE; i++)
+        s.addPair(GO_WIN, GO_LOSS);
+    EXPECT_EQ(s.decision(), SD_ACCEPT_H0);
+    EXPECT_DOUBLE_EQ(s.elo(), 0);
+
+    // the score is half way between symmetric hypotheses
+    Sprt symmetric(-5, 5, 0.05, 0.05);
+    for (int i = 0; i < 100; i++)
+        symmetric.addPair(GO_DRAW, GO_DRAW);
+    EXPECT_EQ(symmetric.decision(), SD_CONTINUE);
+}
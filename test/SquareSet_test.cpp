@@ -0,0 +1,66 @@
+#include "SquareSet.h"
+
+#include "gtest/gtest.h"
+#include <utility>
+#include <vector>
+#include <set>
+
+using namespace battleship;
+using std::pair;
+using std::make_pair;
+using std::vector;
+using std::set;
+
+
+TEST(SquareSetTest, dummy)
+{
+    (void)SquareSet();
+}
+
+TEST(SquareSetTest, insert_and_erase)
+{
+    SquareSet s;
+    EXPECT_TRUE(s.empty());
+
+    s.insert({3,4});
+    s.insert({9,9});
+    s.insert({3,4});
+    EXPECT_EQ(s.size(), 2);
+    EXPECT_TRUE(s.contains({3,4}));
+    EXPECT_TRUE(s.contains({9,9}));
+    EXPECT_FALSE(s.contains({4,3}));
+    EXPECT_FALSE(s.contains({-1,3})) << "squares out of grid are never in the set";
+
+    s.erase({3,4});
+    EXPECT_EQ(s.size(), 1);
+    EXPECT_FALSE(s.contains({3,4}));
+}
+
+TEST(SquareSetTest, iteration_order)
+{
+    vector<pair<int,int>> v({ {0,0}, {0,9}, {4,5}, {6,3}, {6,4}, {9,9} });
+    SquareSet s;
+    for (auto it = v.rbegin(); it != v.rend(); ++it)
+        s.insert(*it);
+
+    vector<pair<int,int>> r(s.begin(), s.end());
+    EXPECT_EQ(r, v) << "squares should be ordered increasingly by first then by second value";
+}
+
+TEST(SquareSetTest, nth)
+{
+    SquareSet s(Bitboard::full());
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(s.nth(i), Bitboard::toSquare(i));
+
+    SquareSet t;
+    t.insert({1,1});
+    t.insert({6,2});
+    t.insert({6,4});
+    t.insert({8,8});
+    vector<pair<int,int>> r;
+    for (int i = 0; i < t.size(); i++)
+        r.push_back(t.nth(i));
+    vector<pair<int,int>> v(t.begin(), t.end());
+    EXPECT_EQ(r, v) << "nth should follow iteration order";
+}
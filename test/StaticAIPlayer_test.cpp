@@ -0,0 +1,69 @@
+#include "StaticAIPlayer.h"
+#include "AIPlayer.h"
+#include "RandomStrategy.h"
+#include "GreedyStrategy.h"
+#include "DensityStrategy.h"
+#include "Simulation.h"
+
+#include "gtest/gtest.h"
+#include <memory>
+
+using namespace battleship;
+using std::make_unique;
+
+namespace
+{
+    void expectSameGrids(const Player& p1, const Player& p2)
+    {
+        for (auto t : { ST_HIT, ST_MISS, ST_SUNK, ST_EMPTY })
+        {
+            EXPECT_EQ(p1.getPrimaryGird().getPlane(t), p2.getPrimaryGird().getPlane(t));
+            EXPECT_EQ(p1.getSecondaryGrid().getPlane(t), p2.getSecondaryGrid().getPlane(t));
+        }
+    }
+
+    // games of static players have to be the same as games of AIPlayers with the same generators
+    template<typename Main, typename Opponent>
+    void expectSameGames(int games)
+    {
+        for (int seed = 0; seed < games; seed++)
+        {
+            StrategyOptions options;
+            StaticAIPlayer<Main> static_main(Random(seed, 1), options, Random(seed, 0));
+            StaticAIPlayer<Opponent> static_opponent(Random(seed, 3), options, Random(seed, 2));
+            AIPlayer main(make_unique<Main>(Random(seed, 1)), Random(seed, 0));
+            AIPlayer opponent(make_unique<Opponent>(Random(seed, 3)), Random(seed, 2));
+            static_main.setUpShips();
+            static_opponent.setUpShips();
+            main.setUpShips();
+            opponent.setUpShips();
+
+            const Simulation simulation(20);
+            const auto s = simulation.playStaticGame(static_main, static_opponent);
+            const auto v = simulation.playGame(main, opponent);
+            EXPECT_EQ(s.outcome, v.outcome);
+            EXPECT_EQ(s.rounds, v.rounds);
+            expectSameGrids(static_main, main);
+            expectSameGrids(static_opponent, opponent);
+        }
+    }
+}
+
+
+TEST(StaticAIPlayerTest, dummy)
+{
+    (void)StaticAIPlayer<RandomStrategy>(Random(1), StrategyOptions(), Random(2));
+}
+
+TEST(StaticAIPlayerTest, logic_errors)
+{
+    StaticAIPlayer<RandomStrategy> p(Random(1), StrategyOptions(), Random(2));
+    EXPECT_THROW(p.shoot(), BattleshipLogicError) << "cannot shoot before setting ships location.";
+}
+
+TEST(StaticAIPlayerTest, same_as_ai_player)
+{
+    expectSameGames<RandomStrategy, RandomStrategy>(50);
+    expectSameGames<GreedyStrategy, RandomStrategy>(50);
+    expectSameGames<DensityStrategy, GreedyStrategy>(3);
+}
@@ -0,0 +1,72 @@
+#include "TranspositionTable.h"
+#include "exceptions.h"
+
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace battleship;
+
+
+TEST(TranspositionTableTest, dummy)
+{
+    (void)TranspositionTable(1);
+}
+
+TEST(TranspositionTableTest, size)
+{
+    EXPECT_EQ(TranspositionTable(1).size(), 1u);
+    EXPECT_EQ(TranspositionTable(1000).size(), 512u);
+    EXPECT_EQ(TranspositionTable(1024).size(), 1024u);
+    EXPECT_THROW(TranspositionTable(0), BattleshipRuntimeError);
+}
+
+TEST(TranspositionTableTest, store_probe)
+{
+    TranspositionTable table(16);
+    double value = 0;
+    EXPECT_FALSE(table.probe(3, value));
+    EXPECT_FALSE(table.probe(0, value));
+
+    table.store(3, 0.75);
+    ASSERT_TRUE(table.probe(3, value));
+    EXPECT_EQ(value, 0.75);
+    // the same slot, different hash
+    EXPECT_FALSE(table.probe(19, value));
+
+    // the new value replaces the old one
+    table.store(19, 0.25);
+    EXPECT_FALSE(table.probe(3, value));
+    ASSERT_TRUE(table.probe(19, value));
+    EXPECT_EQ(value, 0.25);
+
+    table.clear();
+    EXPECT_FALSE(table.probe(19, value));
+}
+
+TEST(TranspositionTableTest, concurrent_access)
+{
+    // values of all hashes are derived from them, so a found value has to be the one of its hash
+    TranspositionTable table(64);
+    const auto valueOf = [](std::uint64_t hash) { return double(hash % 1000) / 1000; };
+
+    std::vector<std::thread> threads;
+    std::vector<long> wrong(4);
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([&, t]()
+        {
+            for (std::uint64_t i = 0; i < 200000; i++)
+            {
+                const std::uint64_t hash = (i * 2654435761u + t) % 4096;
+                double value;
+                if (table.probe(hash, value) && value != valueOf(hash))
+                    wrong[t]++;
+                table.store(hash, valueOf(hash));
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+
+    for (auto w : wrong)
+        EXPECT_EQ(w, 0);
+}
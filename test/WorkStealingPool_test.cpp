@@ -0,0 +1,59 @@
+#include "WorkStealingPool.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+#include <atomic>
+
+using namespace battleship;
+using std::vector;
+
+
+TEST(WorkStealingPoolTest, dummy)
+{
+    (void)WorkStealingPool(2);
+}
+
+TEST(WorkStealingPoolTest, every_element_processed_once)
+{
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    for (long count : { 0L, 1L, 7L, 1000L, 12345L })
+    {
+        vector<std::atomic<int>> visits(count);
+        for (auto& v : visits)
+            v = 0;
+
+        pool.parallelFor(count, 10, [&](int worker, long begin, long end) {
+            EXPECT_GE(worker, 0);
+            EXPECT_LT(worker, 4);
+            EXPECT_LE(end - begin, 10) << "chunk bigger than grain";
+            for (long i = begin; i < end; i++)
+                visits[i]++;
+        });
+
+        for (auto& v : visits)
+            EXPECT_EQ(v, 1);
+    }
+}
+
+TEST(WorkStealingPoolTest, idle_workers_steal)
+{
+    // the worker processing chunk 3 waits until all other chunks are done,
+    // which is possible only if the remaining chunks of its queue are stolen
+    WorkStealingPool pool(2);
+    std::atomic<int> done(0);
+    bool all_others_done = false;
+    pool.parallelFor(8, 1, [&](int, long begin, long) {
+        if (begin == 3)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (done != 7 && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::yield();
+            all_others_done = done == 7;
+        }
+        done++;
+    });
+    EXPECT_EQ(done, 8);
+    EXPECT_TRUE(all_others_done) << "chunks of a busy worker should be stolen";
+}
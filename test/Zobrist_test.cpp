@@ -0,0 +1,81 @@
+#include "Zobrist.h"
+#include "FleetLayouts.h"
+#include "Random.h"
+
+#include "gtest/gtest.h"
+
+using namespace battleship;
+
+
+TEST(ZobristTest, dummy)
+{
+    (void)Zobrist::instance();
+}
+
+TEST(ZobristTest, incremental_hash)
+{
+    // hashes updated after every change have to be the same as hashes of the whole states
+    const auto& zobrist = Zobrist::instance();
+    Random rng(5);
+    for (int game = 0; game < 50; game++)
+    {
+        GameState s {};
+        s.max_rounds = 20;
+        for (int side = 0; side < 2; side++)
+        {
+            const auto layout = FleetLayouts::instance().sample(rng);
+            for (int l = 1; l <= Ship::MAX_LENGTH; l++)
+                s.sides[side].fleet[l - 1] = layout[l - 1];
+        }
+
+        auto hash = zobrist.hash(s);
+        while (s.round < s.max_rounds && !s.isSunk(0, 1) && !s.isSunk(1, 1))
+        {
+            while (s.canShoot(s.turn))
+            {
+                int length;
+                do
+                    length = 1 + rng.below(Ship::MAX_LENGTH);
+                while (!s.canShoot(s.turn, length));
+                const auto u = s.getUntargeted(s.turn, length);
+                const Shot shot { length, u.nth(rng.below(u.count())) };
+                hash = zobrist.afterShot(hash, s, shot);
+                s.apply(shot);
+                ASSERT_EQ(hash, zobrist.hash(s));
+            }
+            if (s.turn == 0)
+            {
+                hash = zobrist.afterEndTurn(hash, s);
+                s.endTurn();
+            }
+            else
+            {
+                hash = zobrist.afterNextRound(hash, s);
+                s.nextRound();
+            }
+            ASSERT_EQ(hash, zobrist.hash(s));
+        }
+    }
+}
+
+TEST(ZobristTest, different_states)
+{
+    const auto& zobrist = Zobrist::instance();
+    GameState s {};
+    s.max_rounds = 20;
+    const auto h = zobrist.hash(s);
+
+    GameState t = s;
+    t.turn = 1;
+    EXPECT_NE(zobrist.hash(t), h);
+    t = s;
+    t.round = 1;
+    EXPECT_NE(zobrist.hash(t), h);
+    t = s;
+    t.sides[1].targeted[0] = 1;
+    EXPECT_NE(zobrist.hash(t), h);
+    t = s;
+    t.sides[0].targeted[0] = 1;
+    EXPECT_NE(zobrist.hash(t), h);
+    EXPECT_NE(zobrist.side(0), zobrist.side(1));
+}